@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <BenchmarkInstance.h>
+
+/**
+ * @addtogroup bin
+ * @{
+ */
+
+/** Console device used for the output benchmark */
+#define BENCH_CONSOLE_PATH "/console/tty0"
+
+/** Number of bytes written to the console per iteration */
+#define BENCH_CONSOLE_SIZE 1024
+
+/** Length of each line written, including the newline */
+#define BENCH_CONSOLE_LINE 64
+
+/**
+ * Measures output throughput of the console, which scrolls on every line.
+ */
+class ConsoleBenchmark : public BenchmarkInstance
+{
+  public:
+
+    /**
+     * Constructor
+     *
+     * @param name Benchmark name
+     */
+    ConsoleBenchmark(const char *name)
+        : BenchmarkInstance(name, BENCH_CONSOLE_SIZE)
+        , m_fd(-1)
+    {
+    }
+
+    /**
+     * Open the console and fill the buffer with lines of text.
+     */
+    virtual bool setup()
+    {
+        if ((m_fd = open(BENCH_CONSOLE_PATH, O_WRONLY)) < 0)
+            return false;
+
+        for (Size i = 0; i < sizeof(m_buffer); i++)
+            m_buffer[i] = (i % BENCH_CONSOLE_LINE) == BENCH_CONSOLE_LINE - 1 ?
+                          '\n' : 'a' + (i % 26);
+
+        return true;
+    }
+
+    /**
+     * Write the lines to the console.
+     */
+    virtual void execute()
+    {
+        write(m_fd, m_buffer, sizeof(m_buffer));
+    }
+
+    /**
+     * Close the console.
+     */
+    virtual void cleanup()
+    {
+        close(m_fd);
+    }
+
+  private:
+
+    /** File descriptor of the console */
+    int m_fd;
+
+    /** Lines of text */
+    char m_buffer[BENCH_CONSOLE_SIZE];
+};
+
+/**
+ * @}
+ */
+
+ConsoleBenchmark consoleWrite("ConsoleWrite");
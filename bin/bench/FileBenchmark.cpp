@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <BenchmarkCase.h>
+#include <BenchmarkInstance.h>
+
+/**
+ * @addtogroup bin
+ * @{
+ */
+
+/** Temporary file used for file I/O benchmarks */
+#define BENCH_FILE_PATH "/tmp/bench.dat"
+
+/** Temporary FIFO used for pipe I/O benchmarks */
+#define BENCH_PIPE_PATH "/tmp/bench.pipe"
+
+/** Number of bytes per file I/O operation */
+#define BENCH_FILE_SIZE 4096
+
+/**
+ * Measures file I/O throughput on a temporary file or pipe.
+ */
+class FileBenchmark : public BenchmarkInstance
+{
+  public:
+
+    /**
+     * Operation to measure.
+     */
+    enum Mode
+    {
+        Read,
+        Write,
+        Stream
+    };
+
+    /**
+     * Constructor
+     *
+     * @param name Benchmark name
+     * @param mode Operation to measure. Stream writes and reads back each block.
+     * @param fifo True to use a pipe instead of a regular file
+     */
+    FileBenchmark(const char *name, Mode mode, bool fifo = false)
+        : BenchmarkInstance(name, BENCH_FILE_SIZE)
+        , m_mode(mode)
+        , m_path(fifo ? BENCH_PIPE_PATH : BENCH_FILE_PATH)
+        , m_fifo(fifo)
+        , m_fd(-1)
+    {
+    }
+
+    /**
+     * Create the temporary file.
+     */
+    virtual bool setup()
+    {
+        if ((m_fifo ? mkfifo(m_path, S_IRUSR | S_IWUSR) : creat(m_path, S_IRUSR | S_IWUSR)) != 0)
+            return false;
+
+        if ((m_fd = open(m_path, O_RDWR)) < 0)
+            return false;
+
+        for (Size i = 0; i < sizeof(m_buffer); i++)
+            m_buffer[i] = i;
+
+        return m_fifo || write(m_fd, m_buffer, sizeof(m_buffer)) == sizeof(m_buffer);
+    }
+
+    /**
+     * Read and/or write a block at the start of the file.
+     */
+    virtual void execute()
+    {
+        if (m_mode != Read)
+        {
+            lseek(m_fd, 0, SEEK_SET);
+            write(m_fd, m_buffer, sizeof(m_buffer));
+        }
+
+        if (m_mode != Write)
+        {
+            lseek(m_fd, 0, SEEK_SET);
+            read(m_fd, m_buffer, sizeof(m_buffer));
+        }
+    }
+
+    /**
+     * Close and remove the temporary file.
+     */
+    virtual void cleanup()
+    {
+        close(m_fd);
+        unlink(m_path);
+    }
+
+  private:
+
+    /** Operation to measure */
+    const Mode m_mode;
+
+    /** Path to the temporary file */
+    const char *m_path;
+
+    /** True if the temporary file is a pipe */
+    const bool m_fifo;
+
+    /** File descriptor of the temporary file */
+    int m_fd;
+
+    /** I/O buffer */
+    u8 m_buffer[BENCH_FILE_SIZE];
+};
+
+/**
+ * @}
+ */
+
+FileBenchmark fileWrite("FileWrite", FileBenchmark::Write);
+FileBenchmark fileRead("FileRead", FileBenchmark::Read);
+FileBenchmark fileStream("FileStream", FileBenchmark::Stream);
+FileBenchmark pipeStream("PipeStream", FileBenchmark::Stream, true);
+
+BenchmarkCase(IPCStat)
+{
+    struct stat st;
+    stat("/etc", &st);
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <unistd.h>
+#include <ChannelClient.h>
+#include <IPCTestMessage.h>
+#include <BenchmarkInstance.h>
+
+/**
+ * @addtogroup bin
+ * @{
+ */
+
+/** Program started as the other end of the IPC benchmarks */
+#define BENCH_PONG_PATH "/bin/bench"
+
+/**
+ * Measures an IPC round trip between two processes.
+ *
+ * Each iteration sends a request over a channel to a child process and
+ * waits for its reply, as clients of a server do. Both switches change the
+ * address space, so this shows the effect of global kernel mappings and
+ * tagged TLB entries. Without handoff both sides only wake the other and
+ * call the scheduler, for comparison with the direct switch of Handoff.
+ */
+class IPCBenchmark : public BenchmarkInstance
+{
+  public:
+
+    /**
+     * Constructor
+     *
+     * @param name Benchmark name
+     * @param handoff True to switch to the other process directly
+     */
+    IPCBenchmark(const char *name, bool handoff)
+        : BenchmarkInstance(name)
+        , m_handoff(handoff)
+        , m_pid(-1)
+    {
+    }
+
+    /**
+     * Start the child process and connect to it.
+     */
+    virtual bool setup()
+    {
+        const char *argv[] = { BENCH_PONG_PATH, "--pong", m_handoff ? "handoff" : "resume", ZERO };
+
+        if ((m_pid = forkexec(BENCH_PONG_PATH, argv)) == (pid_t) -1)
+            return false;
+
+        if (ChannelClient::instance->connect(m_pid, sizeof(IPCTestMessage)) != ChannelClient::Success)
+            return false;
+
+        // First round trip waits until the child serves its channels
+        return roundTrip() == ChannelClient::Success;
+    }
+
+    /**
+     * Send a request to the child and wait for its reply.
+     */
+    virtual void execute()
+    {
+        roundTrip();
+    }
+
+    /**
+     * Stop the child process.
+     */
+    virtual void cleanup()
+    {
+        ProcessCtl(m_pid, KillPID);
+        m_pid = -1;
+    }
+
+  private:
+
+    /**
+     * Send a request to the child and wait for its reply.
+     *
+     * @return Result code
+     */
+    ChannelClient::Result roundTrip()
+    {
+        ChannelClient *client = ChannelClient::instance;
+        IPCTestMessage msg;
+        ChannelClient::Result r;
+
+        msg.type   = ChannelMessage::Request;
+        msg.action = TestActionA;
+
+        if (m_handoff)
+            return client->syncSendReceive(&msg, m_pid);
+
+        if ((r = client->syncSendTo(&msg, m_pid)) != ChannelClient::Success)
+            return r;
+
+        return client->syncReceiveFrom(&msg, m_pid);
+    }
+
+  private:
+
+    /** Switch to the other process directly */
+    const bool m_handoff;
+
+    /** Process ID of the child */
+    pid_t m_pid;
+};
+
+/**
+ * @}
+ */
+
+IPCBenchmark ipcRoundTrip("IPCRoundTrip", true);
+IPCBenchmark ipcRoundTripSchedule("IPCRoundTripSchedule", false);
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __BIN_BENCH_IPCBENCHMARK_H
+#define __BIN_BENCH_IPCBENCHMARK_H
+
+#include <ChannelServer.h>
+#include <IPCTestMessage.h>
+
+/**
+ * @addtogroup bin
+ * @{
+ */
+
+/**
+ * Other end of the IPC benchmarks: replies to each message.
+ *
+ * Runs as a child process of the benchmark, started with --pong.
+ */
+class IPCPongServer : public ChannelServer<IPCPongServer, IPCTestMessage>
+{
+  public:
+
+    /**
+     * Constructor
+     *
+     * @param handoff True to switch to the client directly when replying,
+     *                false to only wake it and leave the switch to the scheduler.
+     */
+    IPCPongServer(bool handoff)
+        : ChannelServer<IPCPongServer, IPCTestMessage>(this)
+        , m_handoff(handoff)
+    {
+        addIPCHandler(TestActionA, &IPCPongServer::pingHandler, handoff);
+    }
+
+  private:
+
+    /**
+     * Reply to a message.
+     *
+     * @param msg Message received
+     */
+    void pingHandler(IPCTestMessage *msg)
+    {
+        msg->type = ChannelMessage::Response;
+
+        // Without handoff the reply is sent here, which only resumes the client
+        if (!m_handoff)
+            ChannelClient::instance->syncSendTo(msg, msg->from);
+    }
+
+  private:
+
+    /** Reply with a direct switch to the client */
+    const bool m_handoff;
+};
+
+/**
+ * @}
+ */
+
+#endif /* __BIN_BENCH_IPCBENCHMARK_H */
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Types.h>
+#include <MemoryBlock.h>
+#include <BenchmarkCase.h>
+#include <BenchmarkInstance.h>
+
+/**
+ * @addtogroup bin
+ * @{
+ */
+
+/** Size of the memory copy benchmark buffers */
+#define BENCH_COPY_SIZE 4096
+
+/**
+ * Measures copying a block of memory.
+ */
+class MemoryCopyBenchmark : public BenchmarkInstance
+{
+  public:
+
+    /**
+     * Constructor
+     *
+     * @param name Benchmark name
+     */
+    MemoryCopyBenchmark(const char *name)
+        : BenchmarkInstance(name, BENCH_COPY_SIZE)
+    {
+    }
+
+    /**
+     * Copy the source buffer to the destination buffer.
+     */
+    virtual void execute()
+    {
+        MemoryBlock::copy(m_dest, m_source, sizeof(m_dest));
+    }
+
+  private:
+
+    /** Source buffer */
+    u8 m_source[BENCH_COPY_SIZE];
+
+    /** Destination buffer */
+    u8 m_dest[BENCH_COPY_SIZE];
+};
+
+/**
+ * @}
+ */
+
+MemoryCopyBenchmark memoryCopy("MemoryCopy");
+
+BenchmarkCase(HeapAllocate16)
+{
+    delete[] new char[16];
+}
+
+BenchmarkCase(HeapAllocate4K)
+{
+    delete[] new char[4096];
+}
+
+BenchmarkCase(HeapAllocateBurst)
+{
+    char *ptr[32];
+
+    for (Size i = 0; i < 32; i++)
+        ptr[i] = new char[16];
+
+    for (Size i = 0; i < 32; i++)
+        delete[] ptr[i];
+}
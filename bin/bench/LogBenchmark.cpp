@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Types.h>
+#include <Log.h>
+#include <BenchmarkInstance.h>
+
+/**
+ * @addtogroup bin
+ * @{
+ */
+
+/**
+ * Log which discards all output.
+ */
+class NullLog : public Log
+{
+  protected:
+
+    /**
+     * Discard output.
+     */
+    virtual void write(const char *str)
+    {
+    }
+};
+
+/**
+ * Measures the cost of a typical server log statement.
+ */
+class LogBenchmark : public BenchmarkInstance
+{
+  public:
+
+    /**
+     * Constructor
+     *
+     * @param name Benchmark name
+     * @param level Minimum log level to use
+     * @param deferred Use deferred output
+     */
+    LogBenchmark(const char *name, Log::Level level, bool deferred)
+        : BenchmarkInstance(name)
+        , m_level(level)
+        , m_deferred(deferred)
+        , m_previous(ZERO)
+        , m_log(ZERO)
+        , m_count(0)
+    {
+    }
+
+    /**
+     * Install a NullLog as the log instance.
+     *
+     * @return Always true
+     */
+    virtual bool setup()
+    {
+        m_previous = Log::instance;
+        m_log = new NullLog();
+        m_log->setMinimumLogLevel(m_level);
+        m_log->setDeferred(m_deferred);
+        return true;
+    }
+
+    /**
+     * Log a debug line, as done when serving a request.
+     */
+    virtual void execute()
+    {
+        DEBUG("request " << m_count++ << " served for pid " << 12);
+    }
+
+    /**
+     * Restore the previous log instance.
+     */
+    virtual void cleanup()
+    {
+        m_log->flush();
+        delete m_log;
+        Log::instance = m_previous;
+    }
+
+  private:
+
+    /** Minimum log level */
+    const Log::Level m_level;
+
+    /** Deferred output */
+    const bool m_deferred;
+
+    /** Log instance before setup() */
+    Log *m_previous;
+
+    /** Log used during the benchmark */
+    Log *m_log;
+
+    /** Request counter */
+    uint m_count;
+};
+
+/**
+ * @}
+ */
+
+LogBenchmark logDebug("LogDebug", Log::Debug, false);
+LogBenchmark logDebugDeferred("LogDebugDeferred", Log::Debug, true);
+LogBenchmark logNotice("LogNotice", Log::Notice, false);
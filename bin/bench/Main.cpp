@@ -15,12 +15,33 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
+#include <stdlib.h>
+#include <BenchmarkRunner.h>
+
+#ifndef __HOST__
 #include <StdioLog.h>
-#include "BenchMark.h"
+#include "IPCBenchmark.h"
+#endif /* __HOST__ */
 
 int main(int argc, char **argv)
 {
+    // Used by the spawn benchmark: exit immediately
+    if (argc > 1 && strcmp(argv[1], "--exit") == 0)
+        return EXIT_SUCCESS;
+
+#ifndef __HOST__
+    // Used by the IPC benchmarks: reply to each message of the parent
+    if (argc > 1 && strcmp(argv[1], "--pong") == 0)
+    {
+        IPCPongServer server(argc < 3 || strcmp(argv[2], "resume") != 0);
+        return server.run();
+    }
+#endif /* __HOST__ */
+
+#ifndef __HOST__
     StdioLog log;
-    BenchMark app(argc, argv);
-    return app.run();
+#endif /* __HOST__ */
+    BenchmarkRunner runner(argc, argv);
+    return runner.run();
 }
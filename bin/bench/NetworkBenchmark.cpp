@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <NetworkClient.h>
+#include <IPV4.h>
+#include <BenchmarkInstance.h>
+
+/**
+ * @addtogroup bin
+ * @{
+ */
+
+/** Network device used for the loopback benchmark */
+#define BENCH_NET_DEVICE "/network/loopback"
+
+/** UDP port used for the loopback benchmark */
+#define BENCH_NET_PORT   8000
+
+/** Size of the UDP payload */
+#define BENCH_NET_SIZE   64
+
+/**
+ * Measures a UDP datagram round trip through the loopback device.
+ */
+class LoopbackBenchmark : public BenchmarkInstance
+{
+  public:
+
+    /**
+     * Constructor
+     *
+     * @param name Benchmark name
+     */
+    LoopbackBenchmark(const char *name)
+        : BenchmarkInstance(name, BENCH_NET_SIZE)
+        , m_client(ZERO)
+        , m_socket(-1)
+        , m_host(0)
+    {
+    }
+
+    /**
+     * Create and bind the UDP socket.
+     */
+    virtual bool setup()
+    {
+        char addr[32];
+        int fd;
+
+        // Retrieve the address of the loopback device
+        if ((fd = open(BENCH_NET_DEVICE "/ipv4/address", O_RDONLY)) < 0)
+            return false;
+
+        int r = read(fd, addr, sizeof(addr) - 1);
+        close(fd);
+
+        if (r <= 0)
+            return false;
+
+        addr[r] = ZERO;
+        m_host = IPV4::toAddress(addr);
+
+        // Create an UDP socket bound to a fixed port
+        m_client = new NetworkClient(BENCH_NET_DEVICE);
+
+        if (m_client->initialize() != NetworkClient::Success ||
+            m_client->createSocket(NetworkClient::UDP, &m_socket) != NetworkClient::Success ||
+            m_client->bindSocket(m_socket, 0, BENCH_NET_PORT) != NetworkClient::Success)
+        {
+            delete m_client;
+            m_client = ZERO;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Send a datagram to ourselves and receive it.
+     */
+    virtual void execute()
+    {
+        struct sockaddr addr;
+
+        addr.addr = m_host;
+        addr.port = BENCH_NET_PORT;
+
+        sendto(m_socket, m_payload, sizeof(m_payload), 0, &addr, sizeof(addr));
+        recvfrom(m_socket, m_payload, sizeof(m_payload), 0, &addr, sizeof(addr));
+    }
+
+    /**
+     * Close the UDP socket.
+     */
+    virtual void cleanup()
+    {
+        m_client->close(m_socket);
+        delete m_client;
+        m_client = ZERO;
+    }
+
+  private:
+
+    /** Network client for the loopback device */
+    NetworkClient *m_client;
+
+    /** UDP socket */
+    int m_socket;
+
+    /** IPV4 address of the loopback device */
+    IPV4::Address m_host;
+
+    /** Datagram payload */
+    u8 m_payload[BENCH_NET_SIZE];
+};
+
+/**
+ * @}
+ */
+
+LoopbackBenchmark loopback("NetworkLoopback");
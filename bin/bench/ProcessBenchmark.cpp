@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <BenchmarkCase.h>
+#include <BenchmarkInstance.h>
+
+/** Program started by the spawn benchmark */
+#define BENCH_SPAWN_PATH "/bin/bench"
+
+BenchmarkCase(ProcessSpawn)
+{
+    const char *argv[] = { BENCH_SPAWN_PATH, "--exit", ZERO };
+    int status;
+    pid_t pid = forkexec(BENCH_SPAWN_PATH, argv);
+
+    if (pid != (pid_t) -1)
+        waitpid(pid, &status, 0);
+}
+
+/**
+ * @addtogroup bin
+ * @{
+ */
+
+/**
+ * Measures spawn-to-exit latency from an in-memory program image.
+ *
+ * Compared to ProcessSpawn, this leaves out reading the program from the filesystem.
+ */
+class SpawnBenchmark : public BenchmarkInstance
+{
+  public:
+
+    /**
+     * Constructor
+     */
+    SpawnBenchmark()
+        : BenchmarkInstance("ProcessSpawnImage")
+        , m_image(ZERO)
+        , m_size(0)
+    {
+    }
+
+    /**
+     * Read the program image.
+     */
+    virtual bool setup()
+    {
+        struct stat st;
+        int fd;
+
+        if (stat(BENCH_SPAWN_PATH, &st) != 0 || (fd = open(BENCH_SPAWN_PATH, O_RDONLY)) < 0)
+            return false;
+
+        m_size  = st.st_size;
+        m_image = new u8[m_size];
+
+        const bool ok = read(fd, m_image, m_size) == (ssize_t) m_size;
+        close(fd);
+        return ok;
+    }
+
+    /**
+     * Spawn the program and wait for it to exit.
+     */
+    virtual void execute()
+    {
+        const char *argv[] = { BENCH_SPAWN_PATH, "--exit", ZERO };
+        int status;
+        pid_t pid = spawnv((Address) m_image, m_size, argv);
+
+        if (pid != (pid_t) -1)
+            waitpid(pid, &status, 0);
+    }
+
+    /**
+     * Release the program image.
+     */
+    virtual void cleanup()
+    {
+        delete[] m_image;
+        m_image = ZERO;
+    }
+
+  private:
+
+    /** Program image */
+    u8 *m_image;
+
+    /** Size of the program image in bytes */
+    Size m_size;
+};
+
+/**
+ * @}
+ */
+
+SpawnBenchmark spawnImage;
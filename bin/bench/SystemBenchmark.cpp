@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <BenchmarkCase.h>
+#include <BenchmarkInstance.h>
+
+/**
+ * @addtogroup bin
+ * @{
+ */
+
+/**
+ * Measures mapping and releasing a single page of private memory.
+ */
+class PageMapBenchmark : public BenchmarkInstance
+{
+  public:
+
+    /**
+     * Constructor
+     *
+     * @param name Benchmark name
+     */
+    PageMapBenchmark(const char *name)
+        : BenchmarkInstance(name, PAGESIZE)
+    {
+    }
+
+    /**
+     * Map a new page and release it again.
+     */
+    virtual void execute()
+    {
+        Memory::Range range;
+
+        range.virt   = ZERO;
+        range.phys   = ZERO;
+        range.size   = PAGESIZE;
+        range.access = Memory::User | Memory::Readable | Memory::Writable;
+
+        VMCtl(SELF, Map, &range);
+        VMCtl(SELF, Release, &range);
+    }
+};
+
+/**
+ * Measures a system call with two arguments.
+ */
+class SystemCallBenchmark : public BenchmarkInstance
+{
+  public:
+
+    /**
+     * Ways to enter the kernel.
+     */
+    enum Entry
+    {
+        /** Same as the API wrappers */
+        Default,
+
+        /** Software interrupt on Intel */
+        Interrupt,
+
+        /** SYSENTER on Intel */
+        Sysenter
+    };
+
+  public:
+
+    /**
+     * Constructor
+     *
+     * @param name Benchmark name
+     * @param entry How to enter the kernel
+     * @param number API number
+     * @param arg1 First argument
+     * @param arg2 Second argument
+     */
+    SystemCallBenchmark(const char *name, Entry entry, ulong number, ulong arg1, ulong arg2)
+        : BenchmarkInstance(name)
+        , m_entry(entry)
+        , m_number(number)
+        , m_arg1(arg1)
+        , m_arg2(arg2)
+    {
+    }
+
+    /**
+     * Skip the SYSENTER variants if the processor cannot use SYSENTER.
+     */
+    virtual bool setup()
+    {
+#ifdef INTEL
+        if (m_entry == Sysenter)
+            return sysenterEnabled();
+#endif /* INTEL */
+        return true;
+    }
+
+    /**
+     * Enter the kernel once.
+     */
+    virtual void execute()
+    {
+#ifdef INTEL
+        ulong ret;
+
+        switch (m_entry)
+        {
+            case Interrupt:
+                asm volatile ("int $0x90" : "=a"(ret) : "a"(m_number), "c"(m_arg1),
+                              "b"(m_arg2) : "memory");
+                return;
+
+            case Sysenter:
+                sysenterKernel4(m_number, m_arg1, m_arg2, 0, 0);
+                return;
+
+            default:
+                break;
+        }
+#endif /* INTEL */
+        trapKernel2(m_number, m_arg1, m_arg2);
+    }
+
+    /**
+     * Consume the wakeups left pending by the Resume benchmarks.
+     */
+    virtual void cleanup()
+    {
+        if (m_number == API::ProcessCtlNumber && m_arg2 == Resume)
+            ProcessCtl(SELF, EnterSleep, 0);
+    }
+
+  private:
+
+    /** How to enter the kernel */
+    const Entry m_entry;
+
+    /** API number */
+    const ulong m_number;
+
+    /** First argument */
+    const ulong m_arg1;
+
+    /** Second argument */
+    const ulong m_arg2;
+};
+
+/**
+ * @}
+ */
+
+PageMapBenchmark pageMap("PageMap");
+
+// Number zero has no handler: measures only the kernel entry round trip
+SystemCallBenchmark systemCallNull("SystemCallNull", SystemCallBenchmark::Default, 0, 0, 0);
+SystemCallBenchmark systemCallGetPID("SystemCallGetPID", SystemCallBenchmark::Default,
+                                     API::ProcessCtlNumber, SELF, GetPID);
+SystemCallBenchmark systemCallResume("SystemCallResume", SystemCallBenchmark::Default,
+                                     API::ProcessCtlNumber, SELF, Resume);
+
+#ifdef INTEL
+
+SystemCallBenchmark interruptNull("InterruptNull", SystemCallBenchmark::Interrupt, 0, 0, 0);
+SystemCallBenchmark interruptGetPID("InterruptGetPID", SystemCallBenchmark::Interrupt,
+                                    API::ProcessCtlNumber, SELF, GetPID);
+SystemCallBenchmark interruptResume("InterruptResume", SystemCallBenchmark::Interrupt,
+                                    API::ProcessCtlNumber, SELF, Resume);
+
+SystemCallBenchmark sysenterNull("SysenterNull", SystemCallBenchmark::Sysenter, 0, 0, 0);
+SystemCallBenchmark sysenterGetPID("SysenterGetPID", SystemCallBenchmark::Sysenter,
+                                   API::ProcessCtlNumber, SELF, GetPID);
+SystemCallBenchmark sysenterResume("SysenterResume", SystemCallBenchmark::Sysenter,
+                                   API::ProcessCtlNumber, SELF, Resume);
+
+#endif /* INTEL */
+
+BenchmarkCase(SystemCallInfoPID)
+{
+    ProcessInfo info;
+    ProcessCtl(SELF, InfoPID, (Address) &info);
+}
+
+BenchmarkCase(SystemCallSchedule)
+{
+    ProcessCtl(SELF, Schedule);
+}
+
+BenchmarkCase(SystemCallVMCtl)
+{
+    Memory::Range range;
+
+    range.virt = 0x80000000;
+    range.size = PAGESIZE;
+    VMCtl(SELF, LookupVirtual, &range);
+}
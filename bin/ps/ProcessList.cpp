@@ -37,41 +37,201 @@ ProcessList::ProcessList(int argc, char **argv)
     : POSIXApplication(argc, argv)
 {
     parser().setDescription("Output system process list");
+    parser().registerFlag('s', "syscalls", "show system calls per kernel API");
+    parser().registerFlag('t', "top", "refresh the list sorted by CPU usage");
+    parser().registerFlag('d', "delay", "seconds between refreshes (--delay=N)");
+    parser().registerFlag('n', "count", "number of refreshes before exit (--count=N)");
 }
 
 ProcessList::Result ProcessList::exec()
+{
+    if (arguments().get("top"))
+        return printTop();
+    else
+        return printList();
+}
+
+void ProcessList::readProcesses(ProcessInfo *info, bool *valid) const
+{
+    for (uint i = 0; i < MAX_PROCS; i++)
+    {
+        valid[i] = ProcessCtl(i, InfoPID, (Address) &info[i]) != API::NotFound;
+    }
+}
+
+void ProcessList::readCommand(ProcessID pid, char *cmd) const
 {
     Arch::MemoryMap map;
     Memory::Range range = map.range(MemoryMap::UserArgs);
-    ProcessInfo info;
+
+    memset(cmd, 0, PATH_MAX);
+    VMCopy(pid, API::Read, (Address) cmd, range.virt, PATH_MAX);
+    cmd[PATH_MAX - 1] = 0;
+}
+
+ProcessList::Result ProcessList::printList()
+{
+    ProcessInfo *info = new ProcessInfo[MAX_PROCS];
+    bool *valid = new bool[MAX_PROCS];
+    const bool syscalls = arguments().get("syscalls") != ZERO;
     String out;
     char line[256], cmd[PATH_MAX];
     pid_t pid = getpid();
 
     // Print header
-    out << "ID  PARENT  USER GROUP STATUS     CMD\r\n";
-    memset(&cmd, 0, sizeof(cmd));
+    if (syscalls)
+        out << "ID  PRIV  PROC  INFO VMCPY  VMCTL VMSHR IOCTL     CMD\r\n";
+    else
+        out << "ID  PARENT  USER GROUP STATUS      TICKS  VCSW  ICSW SYSCALLS     CMD\r\n";
 
     // Loop processes
+    readProcesses(info, valid);
+
     for (uint i = 0; i < MAX_PROCS; i++)
     {
-        // Request kernel's process information
-        if (ProcessCtl(i, InfoPID, (Address) &info) != API::NotFound)
-        {
-            DEBUG("PID " << i << " state = " << info.state);
+        if (!valid[i])
+            continue;
 
-            // Get the command
-            VMCopy(i, API::Read, (Address) cmd, range.virt, PATH_MAX);
+        const Process::Usage & usage = info[i].usage;
+        DEBUG("PID " << i << " state = " << info[i].state);
 
-            // Output a line
+        // Get the command
+        readCommand(i, cmd);
+
+        // Output a line
+        if (syscalls)
+        {
             snprintf(line, sizeof(line),
-                    "%3d %7d %4d %5d %10s %32s\r\n",
-                     i, info.parent, 0, 0, i == pid ? "Running" : ProcessStates[info.state], cmd);
-            out << line;
+                    "%3d %5u %5u %5u %5u %6u %5u %5u %8s\r\n",
+                     i,
+                     usage.systemCallsByNumber[API::PrivExecNumber],
+                     usage.systemCallsByNumber[API::ProcessCtlNumber],
+                     usage.systemCallsByNumber[API::SystemInfoNumber],
+                     usage.systemCallsByNumber[API::VMCopyNumber],
+                     usage.systemCallsByNumber[API::VMCtlNumber],
+                     usage.systemCallsByNumber[API::VMShareNumber],
+                     usage.systemCallsByNumber[API::IOCtlNumber],
+                     cmd);
         }
+        else
+        {
+            snprintf(line, sizeof(line),
+                    "%3d %7d %4d %5d %10s %6u %5u %5u %8u %32s\r\n",
+                     i, info[i].parent, 0, 0,
+                     i == (uint) pid ? "Running" : ProcessStates[info[i].state],
+                     usage.ticks, usage.voluntarySwitches,
+                     usage.involuntarySwitches, usage.systemCalls, cmd);
+        }
+        out << line;
     }
 
     // Output the table
     write(1, *out, out.length());
+    delete[] info;
+    delete[] valid;
+    return Success;
+}
+
+ProcessList::Result ProcessList::printTop()
+{
+    ProcessInfo *previous = new ProcessInfo[MAX_PROCS];
+    ProcessInfo *current = new ProcessInfo[MAX_PROCS];
+    bool *previousValid = new bool[MAX_PROCS];
+    bool *currentValid = new bool[MAX_PROCS];
+    uint *order = new uint[MAX_PROCS];
+    uint *ticks = new uint[MAX_PROCS];
+    uint *calls = new uint[MAX_PROCS];
+    const char *delayArg = arguments().get("delay");
+    const char *countArg = arguments().get("count");
+    int delay = delayArg ? atoi(delayArg) : 0;
+    int count = countArg ? atoi(countArg) : 0;
+    char line[256], cmd[PATH_MAX];
+
+    if (delay <= 0)
+        delay = DefaultDelay;
+
+    readProcesses(previous, previousValid);
+
+    for (int iteration = 0; count <= 0 || iteration < count; iteration++)
+    {
+        String out;
+        Size found = 0;
+        uint totalTicks = 0;
+
+        sleep(delay);
+        readProcesses(current, currentValid);
+
+        // Collect usage since the previous refresh
+        for (uint i = 0; i < MAX_PROCS; i++)
+        {
+            if (!currentValid[i])
+                continue;
+
+            const Process::Usage & now = current[i].usage;
+            ticks[i] = now.ticks;
+            calls[i] = now.systemCalls;
+
+            if (previousValid[i])
+            {
+                ticks[i] -= previous[i].usage.ticks;
+                calls[i] -= previous[i].usage.systemCalls;
+            }
+            totalTicks += ticks[i];
+
+            // Insertion sort on ticks, then system calls
+            Size j = found++;
+            while (j > 0 && (ticks[order[j - 1]] < ticks[i] ||
+                            (ticks[order[j - 1]] == ticks[i] &&
+                             calls[order[j - 1]] < calls[i])))
+            {
+                order[j] = order[j - 1];
+                j--;
+            }
+            order[j] = i;
+        }
+
+        // Clear screen and print header
+        out << "\033[H\033[2J";
+        snprintf(line, sizeof(line), "%u processes, %u ticks in %d second(s)\r\n\r\n",
+                 found, totalTicks, delay);
+        out << line;
+        out << "ID  STATUS     CPU%  TICKS SYSCALLS   VCSW  ICSW     CMD\r\n";
+
+        for (Size i = 0; i < found; i++)
+        {
+            const uint pid = order[i];
+            const Process::Usage & now = current[pid].usage;
+            const Process::Usage & then = previous[pid].usage;
+            const bool existed = previousValid[pid];
+
+            readCommand(pid, cmd);
+            snprintf(line, sizeof(line),
+                    "%3d %10s %3u %6u %8u %6u %5u %8s\r\n",
+                     pid, ProcessStates[current[pid].state],
+                     totalTicks ? (ticks[pid] * 100) / totalTicks : 0,
+                     ticks[pid], calls[pid],
+                     now.voluntarySwitches - (existed ? then.voluntarySwitches : 0),
+                     now.involuntarySwitches - (existed ? then.involuntarySwitches : 0),
+                     cmd);
+            out << line;
+        }
+        write(1, *out, out.length());
+
+        // Current sample becomes the reference for the next refresh
+        ProcessInfo *tmpInfo = previous;
+        bool *tmpValid = previousValid;
+        previous = current;
+        previousValid = currentValid;
+        current = tmpInfo;
+        currentValid = tmpValid;
+    }
+
+    delete[] previous;
+    delete[] current;
+    delete[] previousValid;
+    delete[] currentValid;
+    delete[] order;
+    delete[] ticks;
+    delete[] calls;
     return Success;
 }
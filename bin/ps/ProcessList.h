@@ -18,6 +18,7 @@
 #ifndef __BIN_PS_PROCESSLIST_H
 #define __BIN_PS_PROCESSLIST_H
 
+#include <FreeNOS/System.h>
 #include <POSIXApplication.h>
 
 /**
@@ -27,6 +28,9 @@
 
 /**
  * Output the system process list.
+ *
+ * With --top, the process list is refreshed periodically and sorted
+ * by the CPU ticks each process consumed since the previous refresh.
  */
 class ProcessList : public POSIXApplication
 {
@@ -35,6 +39,9 @@ class ProcessList : public POSIXApplication
     /** Array of process state strings */
     static const char *ProcessStates[];
 
+    /** Default number of seconds between refreshes of the top view */
+    static const uint DefaultDelay = 1;
+
   public:
 
     /**
@@ -51,6 +58,38 @@ class ProcessList : public POSIXApplication
      * @return Result code
      */
     virtual Result exec();
+
+  private:
+
+    /**
+     * Retrieve information of all processes from the kernel.
+     *
+     * @param info Output array of MAX_PROCS entries.
+     * @param valid Output array which indicates existing processes.
+     */
+    void readProcesses(ProcessInfo *info, bool *valid) const;
+
+    /**
+     * Retrieve the command line of a process.
+     *
+     * @param pid Process identifier.
+     * @param cmd Output buffer of PATH_MAX bytes.
+     */
+    void readCommand(ProcessID pid, char *cmd) const;
+
+    /**
+     * Output the process list once.
+     *
+     * @return Result code
+     */
+    Result printList();
+
+    /**
+     * Output a refreshing process list sorted by CPU usage.
+     *
+     * @return Result code
+     */
+    Result printTop();
 };
 
 /**
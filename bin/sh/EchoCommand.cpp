@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include <unistd.h>
+#include "EchoCommand.h"
+
+EchoCommand::EchoCommand()
+    : ShellCommand("echo", 0)
+{
+    m_help = "Print arguments to standard output";
+}
+
+int EchoCommand::execute(Size nparams, char **params)
+{
+    char line[512];
+    Size length = 0;
+    Size first = 0;
+    bool newline = true;
+
+    if (nparams > 0 && strcmp(params[0], "-n") == 0)
+    {
+        newline = false;
+        first++;
+    }
+
+    // Collect all arguments to output them with a single write
+    for (Size i = first; i < nparams; i++)
+    {
+        if (i > first && length < sizeof(line) - 1)
+            line[length++] = ' ';
+
+        length += strlcpy(line + length, params[i], sizeof(line) - length);
+
+        if (length > sizeof(line) - 1)
+            length = sizeof(line) - 1;
+    }
+
+    if (newline && length < sizeof(line))
+        line[length++] = '\n';
+
+    return write(1, line, length) == (ssize_t) length ? 0 : 1;
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <HashIterator.h>
+#include "HashCommand.h"
+#include "Shell.h"
+
+HashCommand::HashCommand(Shell *shell)
+    : ShellCommand("hash", 0)
+{
+    m_shell = shell;
+    m_help  = "Show resolved program paths, or clear them with -r";
+}
+
+int HashCommand::execute(Size nparams, char **params)
+{
+    if (nparams > 0 && strcmp(params[0], "-r") == 0)
+    {
+        m_shell->clearHash();
+        return 0;
+    }
+
+    for (HashIterator<String, String> i(m_shell->getHash()); i.hasCurrent(); i++)
+    {
+        printf("%s\t%s\r\n", *i.key(), *i.current());
+    }
+    return 0;
+}
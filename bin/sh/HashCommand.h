@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SH_HASHCOMMAND
+#define __SH_HASHCOMMAND
+
+#include <Types.h>
+#include "ShellCommand.h"
+
+class Shell;
+
+/**
+ * @addtogroup bin
+ * @{
+ *
+ * @addtogroup sh
+ * @{
+ */
+
+/**
+ * Show or clear the cache of resolved program paths.
+ */
+class HashCommand : public ShellCommand
+{
+  public:
+
+    /**
+     * Constructor.
+     *
+     * @param shell Shell object
+     */
+    HashCommand(Shell *shell);
+
+    /**
+     * Executes the command.
+     *
+     * @param nparams Number of parameters given.
+     * @param params Array of parameters.
+     * @return Error code or zero on success.
+     */
+    virtual int execute(Size nparams, char **params);
+
+  private:
+
+    /** Shell object */
+    Shell *m_shell;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __SH_HASHCOMMAND */
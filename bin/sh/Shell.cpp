@@ -15,6 +15,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <FreeNOS/System.h>
 #include <TerminalCodes.h>
 #include "Shell.h"
 #include "ChangeDirCommand.h"
@@ -23,6 +24,12 @@
 #include "WriteCommand.h"
 #include "HelpCommand.h"
 #include "TimeCommand.h"
+#include "EchoCommand.h"
+#include "SleepCommand.h"
+#include "StatCommand.h"
+#include "HashCommand.h"
+#include "SourceCommand.h"
+#include "ShellScript.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -34,9 +41,10 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <Runtime.h>
+#include <HashIterator.h>
 
-/** Maximum number of supported command arguments. */
-#define MAX_ARGV 16
+/** Colon separated list of directories to search for programs. */
+#define SHELL_PATH "/bin"
 
 Shell::Shell(int argc, char **argv)
     : POSIXApplication(argc, argv)
@@ -49,19 +57,25 @@ Shell::Shell(int argc, char **argv)
     registerCommand(new StdioCommand());
     registerCommand(new WriteCommand());
     registerCommand(new HelpCommand(this));
-    registerCommand(new TimeCommand());
+    registerCommand(new TimeCommand(this));
+    registerCommand(new EchoCommand());
+    registerCommand(new SleepCommand());
+    registerCommand(new StatCommand());
+    registerCommand(new HashCommand(this));
+    registerCommand(new SourceCommand(this));
+
+    MemoryBlock::set(m_mounts, 0, sizeof(m_mounts));
 }
 
 Shell::~Shell()
 {
+    for (HashIterator<String, ShellScript *> i(m_scripts); i.hasCurrent(); i++)
+        delete i.current();
 }
 
 Shell::Result Shell::exec()
 {
     const Vector<Argument *> & positionals = arguments().getPositionals();
-    FILE *fp;
-    struct stat st;
-    char *contents;
 
     // Refresh mount points
     refreshMounts(0);
@@ -72,48 +86,7 @@ Shell::Result Shell::exec()
         // Execute commands in each file
         for (Size i = 0; i < positionals.count(); i++)
         {
-            const char *file = *(positionals[i]->getValue());
-
-            // Query the file size
-            if (stat(file, &st) != 0)
-            {
-                ERROR("failed to stat() `" << file << "': " << strerror(errno));
-                continue;
-            }
-
-            // Open file
-            if ((fp = fopen(file, "r")) == NULL)
-            {
-                ERROR("failed to fopen() `" << file << "': " << strerror(errno));
-                continue;
-            }
-
-            // Allocate buffer storage
-            contents = new char[st.st_size + 1];
-
-            // Read the entire file into memory
-            if (fread(contents, st.st_size, 1, fp) != (size_t) st.st_size)
-            {
-                ERROR("failed to fread() `" << file << "': " << strerror(errno));
-                fclose(fp);
-                continue;
-            }
-            // Null terminate
-            contents[st.st_size] = 0;
-
-            // Parse it into lines
-            String contentString(contents);
-            List<String> lines = contentString.split('\n');
-    
-            // Execute each command
-            for (ListIterator<String> i(lines); i.hasCurrent(); i++)
-            {
-                executeInput((char *) *i.current());
-            }
-
-            // Cleanup
-            delete contents;
-            fclose(fp);
+            executeScript(*(positionals[i]->getValue()));
         }
     }
     // Run an interactive Shell
@@ -160,70 +133,387 @@ Shell::Result Shell::runInteractive()
 
 int Shell::executeInput(char *command)
 {
-    char *argv[MAX_ARGV];
-    char tmp[128];
-    ShellCommand *cmd;
-    Size argc;
-    int pid, status;
-    bool background;
+    ShellPipeline pipeline;
+
+    DEBUG("command = '" << command << "'");
 
-    // Valid argument?
-    if (!strlen(command))
+    switch (pipeline.parse(command))
     {
-        return EXIT_SUCCESS;
+        case ShellPipeline::Success:
+            return executePipeline(pipeline);
+
+        case ShellPipeline::Empty:
+            return EXIT_SUCCESS;
+
+        default:
+            ERROR("syntax error");
+            return EXIT_FAILURE;
     }
+}
 
-    DEBUG("command = '" << command << "'");
+int Shell::executeScript(const char *path)
+{
+    ShellScript *script = ZERO;
+    char fullpath[PATH_MAX];
+    struct stat st;
+    char *contents;
+    int fd, status = EXIT_SUCCESS;
+    Size total = 0;
+    ssize_t bytes;
+
+    // Use the full path as key for the script cache
+    if (path[0] != '/')
+    {
+        char cwd[PATH_MAX];
+
+        getcwd(cwd, sizeof(cwd));
+        snprintf(fullpath, sizeof(fullpath), "%s/%s", cwd, path);
+    }
+    else
+        strlcpy(fullpath, path, sizeof(fullpath));
 
-    // Attempt to extract arguments
-    argc = parse(command, argv, MAX_ARGV, &background);
+    // Query the file size
+    if (stat(fullpath, &st) != 0)
+    {
+        ERROR("failed to stat() `" << path << "': " << strerror(errno));
+        return EXIT_FAILURE;
+    }
 
-    // Ignore comments
-    if (argv[0][0] == '#')
-        return EXIT_SUCCESS;
+    // Open file
+    if ((fd = open(fullpath, O_RDONLY)) < 0)
+    {
+        ERROR("failed to open() `" << path << "': " << strerror(errno));
+        return EXIT_FAILURE;
+    }
 
-    // Do we have a matching ShellCommand?
-    if (!(cmd = getCommand(argv[0])))
+    // Read the entire file into memory
+    contents = new char[st.st_size + 1];
+
+    while (total < (Size) st.st_size && (bytes = read(fd, contents + total, st.st_size - total)) > 0)
+        total += bytes;
+
+    close(fd);
+
+    if (total != (Size) st.st_size)
     {
-        // If not, try to execute it as a file directly
-        if ((pid = forkexec(argv[0], (const char **) argv)) != -1)
+        ERROR("failed to read() `" << path << "': " << strerror(errno));
+        delete[] contents;
+        return EXIT_FAILURE;
+    }
+
+    // Only parse again if the script changed
+    if (m_scripts.contains(fullpath) && m_scripts[fullpath]->equals(contents, total))
+    {
+        script = m_scripts[fullpath];
+        delete[] contents;
+    }
+    else
+    {
+        if (m_scripts.contains(fullpath))
+            delete m_scripts[fullpath];
+
+        script = new ShellScript(contents, total);
+        m_scripts.insert(fullpath, script);
+    }
+
+    // Execute each command
+    for (ListIterator<ShellPipeline *> i(script->getCommands()); i.hasCurrent(); i++)
+    {
+        status = executePipeline(*i.current());
+    }
+    return status;
+}
+
+int Shell::executePipeline(const ShellPipeline & pipeline)
+{
+    const Size count = pipeline.count();
+    char pipes[MAX_PIPELINE][32];
+    int readFds[MAX_PIPELINE], writeFds[MAX_PIPELINE];
+    int pids[MAX_PIPELINE];
+    int status = EXIT_SUCCESS, lastStatus = EXIT_FAILURE;
+    bool background = pipeline.isBackground();
+    Size created = 0;
+
+    if (background && count > 1)
+    {
+        ERROR("pipelines cannot run in the background");
+        background = false;
+    }
+
+    for (Size i = 0; i < count; i++)
+    {
+        pids[i] = -1;
+        readFds[i] = writeFds[i] = -1;
+    }
+
+    // Create a pipe between each pair of commands
+    for (created = 0; created < count - 1; created++)
+    {
+        snprintf(pipes[created], sizeof(pipes[created]),
+                 "/tmp/.pipe.%d.%d", getpid(), (int) created);
+
+        if (mkfifo(pipes[created], S_IRUSR | S_IWUSR) != 0 ||
+           (readFds[created] = open(pipes[created], O_RDONLY)) < 0 ||
+           (writeFds[created] = open(pipes[created], O_WRONLY)) < 0)
         {
-            if (!background)
-            {
-                waitpid(pid, &status, 0);
-                return status;
-            } else
-                return EXIT_SUCCESS;
+            ERROR("failed to create pipe `" << pipes[created] << "': " << strerror(errno));
+            created++;
+            status = EXIT_FAILURE;
+            break;
+        }
+    }
+
+    // Start all commands, consumers first. Builtin commands run inside the
+    // shell, so the command reading their output must already be running.
+    if (status == EXIT_SUCCESS)
+    {
+        for (Size i = count; i > 0; i--)
+        {
+            status = executeStage(pipeline.getStage(i - 1),
+                                  i > 1 ? readFds[i - 2] : -1,
+                                  i < count ? writeFds[i - 1] : -1,
+                                  &pids[i - 1]);
+            if (i == count)
+                lastStatus = status;
         }
+        status = lastStatus;
+    }
+
+    // Wait for the commands, in the order in which they finish
+    if (!background)
+        status = waitPipeline(pids, readFds, writeFds, count, status);
+
+    // Cleanup pipes
+    for (Size i = 0; i < created; i++)
+    {
+        if (readFds[i] >= 0)
+            close(readFds[i]);
+
+        if (writeFds[i] >= 0)
+            close(writeFds[i]);
 
-        // Try to find it on the filesystem. (temporary hardcoded PATH)
-        else if (snprintf(tmp, sizeof(tmp), "/bin/%s", argv[0]) &&
-                (pid = forkexec(tmp, (const char **) argv)) != -1)
+        unlink(pipes[i]);
+    }
+    return status;
+}
+
+int Shell::waitPipeline(const int *pids, int *readFds, int *writeFds, Size count, int status)
+{
+    bool done[MAX_PIPELINE];
+    Size running = count;
+    ProcessInfo info;
+
+    for (Size i = 0; i < count; i++)
+        done[i] = false;
+
+    while (running > 0)
+    {
+        const Size before = running;
+
+        for (Size i = 0; i < count; i++)
         {
-            if (!background)
+            if (done[i])
+                continue;
+
+            // The last command is waited for once the others are done, to get its exit status
+            if (pids[i] != -1)
+            {
+                if (i == count - 1 && running == 1)
+                    waitpid(pids[i], &status, 0);
+                else if (ProcessCtl(pids[i], InfoPID, (Address) &info) == API::Success)
+                    continue;
+            }
+            done[i] = true;
+            running--;
+
+            // Signal end-of-file to the next command
+            if (i < count - 1 && writeFds[i] >= 0)
+            {
+                close(writeFds[i]);
+                writeFds[i] = -1;
+            }
+
+            // Let writes of the previous command fail with EPIPE
+            if (i > 0 && readFds[i - 1] >= 0)
             {
-                waitpid(pid, &status, 0);
-                return status;
-            } else
-                return EXIT_SUCCESS;
+                close(readFds[i - 1]);
+                readFds[i - 1] = -1;
+            }
         }
-        else
+
+        // Sleep until the kernel wakes us up for a terminated child
+        if (running > 0 && running == before)
+            ProcessCtl(SELF, EnterSleep, 0);
+    }
+    return status;
+}
+
+int Shell::executeStage(ShellPipeline::Stage *stage, int input, int output, int *pid)
+{
+    FileDescriptor *files = getFiles();
+    const FileDescriptor savedInput = files[0], savedOutput = files[1];
+    char **argv = stage->argv;
+    const char *path;
+    ShellCommand *cmd;
+    int redirect[2] = { -1, -1 };
+    int status = EXIT_FAILURE;
+
+    *pid = -1;
+
+    // Redirections override the pipeline
+    if (stage->input && (redirect[0] = open(stage->input, O_RDONLY)) < 0)
+    {
+        ERROR("failed to open `" << stage->input << "': " << strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    if (stage->output && (redirect[1] = openOutput(stage->output, stage->append)) < 0)
+    {
+        ERROR("failed to open `" << stage->output << "': " << strerror(errno));
+
+        if (redirect[0] != -1)
+            close(redirect[0]);
+
+        return EXIT_FAILURE;
+    }
+
+    // Point standard input and output to the files or pipes
+    if (redirect[0] != -1)
+        input = redirect[0];
+
+    if (redirect[1] != -1)
+        output = redirect[1];
+
+    if (input != -1)
+        files[0] = files[input];
+
+    if (output != -1)
+        files[1] = files[output];
+
+    // Do we have a matching ShellCommand?
+    if ((cmd = getCommand(argv[0])))
+    {
+        // Enough arguments given?
+        if (stage->argc - 1 < cmd->getMinimumParams())
         {
-            ERROR("forkexec `" << argv[0] << "' failed: " << strerror(errno));
+            ERROR(cmd->getName() << ": not enough arguments (" << cmd->getMinimumParams() << " required)");
         }
+        else
+            status = cmd->execute(stage->argc - 1, argv + 1);
+    }
+    // If not, find the program and start it
+    else if (!(path = resolve(argv[0])))
+    {
+        ERROR(argv[0] << ": command not found");
     }
-    // Enough arguments given?
-    else if (argc - 1 < cmd->getMinimumParams())
+    else if ((*pid = forkexec(path, (const char **) argv)) != -1)
     {
-        ERROR(cmd->getName() << ": not enough arguments (" << cmd->getMinimumParams() << " required)");
+        status = EXIT_SUCCESS;
     }
-    // Execute it
     else
     {
-        return cmd->execute(argc - 1, argv + 1);
+        ERROR("forkexec `" << path << "' failed: " << strerror(errno));
+
+        // The program may have moved
+        m_hash.remove(argv[0]);
+    }
+
+    // Restore standard input and output
+    files[0] = savedInput;
+    files[1] = savedOutput;
+
+    // The child has its own copy of the file descriptors
+    for (Size i = 0; i < 2; i++)
+    {
+        if (redirect[i] != -1)
+            close(redirect[i]);
     }
-    // Not successful
-    return EXIT_FAILURE;
+    return status;
+}
+
+const char * Shell::resolve(const char *name)
+{
+    FileSystemMount *mounts = getMounts();
+    char path[PATH_MAX];
+    struct stat st;
+
+    // Paths are used as-is
+    if (strchr(name, '/'))
+        return name;
+
+    // Forget all paths when the mounted filesystems changed
+    for (Size i = 0; i < FILESYSTEM_MAXMOUNTS; i++)
+    {
+        if (mounts[i].procID != m_mounts[i].procID ||
+            strcmp(mounts[i].path, m_mounts[i].path) != 0)
+        {
+            clearHash();
+            MemoryBlock::copy(m_mounts, mounts, sizeof(m_mounts));
+            break;
+        }
+    }
+
+    // Lookup the cache
+    if (m_hash.contains(name))
+        return *m_hash[name];
+
+    // Search each directory in the PATH
+    for (const char *dir = SHELL_PATH; *dir; )
+    {
+        const char *end = strchr(dir, ':');
+        const Size len = end ? (Size) (end - dir) : strlen(dir);
+
+        strlcpy(path, dir, len + 1 < sizeof(path) ? len + 1 : sizeof(path));
+        snprintf(path + strlen(path), sizeof(path) - strlen(path), "/%s", name);
+
+        if (stat(path, &st) == 0 && S_ISREG(st.st_mode))
+        {
+            m_hash.insert(name, path);
+            return *m_hash[name];
+        }
+        dir += end ? len + 1 : len;
+    }
+
+    // Fall back to the current directory
+    return stat(name, &st) == 0 && S_ISREG(st.st_mode) ? name : ZERO;
+}
+
+HashTable<String, String> & Shell::getHash()
+{
+    return m_hash;
+}
+
+void Shell::clearHash()
+{
+    List<String> names = m_hash.keys();
+
+    for (ListIterator<String> i(names); i.hasCurrent(); i++)
+        m_hash.remove(i.current());
+}
+
+int Shell::openOutput(const char *path, bool append)
+{
+    struct stat st;
+    const bool exists = stat(path, &st) == 0;
+    int fd;
+
+    // Replace existing regular files, unless appending
+    if (!exists || (!append && S_ISREG(st.st_mode)))
+    {
+        if (exists)
+            unlink(path);
+
+        if (creat(path, S_IRUSR | S_IWUSR) != 0)
+            return -1;
+
+        st.st_size = 0;
+    }
+
+    // Continue at the end of the file
+    if ((fd = open(path, O_WRONLY)) >= 0 && append)
+        lseek(fd, st.st_size, SEEK_SET);
+
+    return fd;
 }
 
 char * Shell::getInput()
@@ -296,31 +586,3 @@ void Shell::registerCommand(ShellCommand *command)
 {
     m_commands.insert(command->getName(), command);
 }
-
-Size Shell::parse(char *cmdline, char **argv, Size maxArgv, bool *background)
-{
-    Size argc;
-
-    *background = false;
-    
-    for (argc = 0; argc < maxArgv && *cmdline; argc++)
-    {
-        while (*cmdline && *cmdline == ' ')
-            cmdline++;
-
-        if (*cmdline == '&')
-        {
-            *background = true;
-            break;
-        }
-
-        argv[argc] = cmdline;
-
-        while (*cmdline && *cmdline != ' ')
-            cmdline++;
-
-        if (*cmdline) *cmdline++ = ZERO;
-    }
-    argv[argc] = ZERO;
-    return argc;
-}
@@ -20,7 +20,11 @@
 
 #include <Types.h>
 #include <POSIXApplication.h>
+#include <FileSystemMount.h>
 #include "ShellCommand.h"
+#include "ShellPipeline.h"
+
+class ShellScript;
 
 /**
  * @addtogroup bin
@@ -76,6 +80,40 @@ class Shell : public POSIXApplication
      */
     void registerCommand(ShellCommand *command);
 
+    /**
+     * Executes the given input.
+     *
+     * The input may be a pipeline of commands separated by '|'.
+     * Each pair of commands is connected with a FIFO in /tmp.
+     *
+     * @param cmdline Input to execute.
+     * @return Exit status of the (last) command.
+     */
+    int executeInput(char *cmdline);
+
+    /**
+     * Executes all commands in a script file.
+     *
+     * Parsed scripts are cached by their full path, and are only
+     * parsed again when their contents change.
+     *
+     * @param path Path to the script file.
+     * @return Exit status of the last command.
+     */
+    int executeScript(const char *path);
+
+    /**
+     * Get the cache of resolved program paths.
+     *
+     * @return HashTable with program names and their full path
+     */
+    HashTable<String, String> & getHash();
+
+    /**
+     * Forget all resolved program paths.
+     */
+    void clearHash();
+
   private:
 
     /**
@@ -86,12 +124,63 @@ class Shell : public POSIXApplication
     Result runInteractive();
 
     /**
-     * Executes the given input.
+     * Executes a parsed command line.
      *
-     * @param cmdline Input to execute.
-     * @return Exit status of the command.
+     * @param pipeline Parsed command line.
+     * @return Exit status of the last command.
      */
-    int executeInput(char *cmdline);
+    int executePipeline(const ShellPipeline & pipeline);
+
+    /**
+     * Wait for all commands of a pipeline to finish.
+     *
+     * Commands may finish in any order. The shell sleeps until the kernel
+     * wakes it up for a terminated child. When a command finishes, its
+     * ends of the pipes are closed: the next command receives end-of-file
+     * and writes of the previous command fail with EPIPE. A consumer
+     * which exits early thus never leaves its producer blocked on a full pipe.
+     *
+     * @param pids PIDs of the started programs, or -1 for finished commands.
+     * @param readFds Reading ends of the pipes between the commands.
+     * @param writeFds Writing ends of the pipes between the commands.
+     *                 Both are closed and set to -1 as the commands finish.
+     * @param count Number of commands.
+     * @param status Exit status if the last command is not a program,
+     *               or exits before the others.
+     * @return Exit status of the last command.
+     */
+    int waitPipeline(const int *pids, int *readFds, int *writeFds, Size count, int status);
+
+    /**
+     * Executes a single command of a pipeline.
+     *
+     * @param stage Parsed command.
+     * @param input File descriptor for standard input or -1 to inherit.
+     * @param output File descriptor for standard output or -1 to inherit.
+     * @param pid Receives the PID of the started program, or -1 if done.
+     * @return Exit status of builtin commands, or EXIT_SUCCESS if started.
+     */
+    int executeStage(ShellPipeline::Stage *stage, int input, int output, int *pid);
+
+    /**
+     * Open a file for output redirection.
+     *
+     * @param path Path to the file. Created if it does not exist.
+     * @param append True to write at the end, false to truncate.
+     * @return File descriptor on success or -1 on failure.
+     */
+    int openOutput(const char *path, bool append);
+
+    /**
+     * Find the program for a command name.
+     *
+     * Names without a slash are searched in the PATH and cached until
+     * the mounted filesystems change.
+     *
+     * @param name Command name.
+     * @return Path to the program or ZERO if not found.
+     */
+    const char * resolve(const char *name);
 
     /**
      * Fetch a command text from standard input.
@@ -104,20 +193,19 @@ class Shell : public POSIXApplication
      */
     void prompt();
 
-    /**
-     * Parses an input string into separate pieces.
-     * @param cmdline Command input string.
-     * @param argv Argument list buffer.
-     * @param maxArgv Maximum number of entries in argv.
-     * @param background True if process must run in the background.
-     * @return Number of parsed arguments.
-     */
-    Size parse(char *cmdline, char **argv, Size maxArgv, bool *background);
-
   private:
 
     /** All known ShellCommands. */
     HashTable<String, ShellCommand *> m_commands;
+
+    /** Resolved program paths by command name. */
+    HashTable<String, String> m_hash;
+
+    /** Parsed scripts by full path. */
+    HashTable<String, ShellScript *> m_scripts;
+
+    /** Mounted filesystems when m_hash was last validated. */
+    FileSystemMount m_mounts[FILESYSTEM_MAXMOUNTS];
 };
 
 /**
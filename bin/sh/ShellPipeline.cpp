@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Macros.h>
+#include <MemoryBlock.h>
+#include <string.h>
+#include "ShellPipeline.h"
+
+/** Characters which separate arguments without surrounding whitespace. */
+#define SPECIAL_CHARS "|<>&"
+
+ShellPipeline::ShellPipeline()
+    : m_count(0)
+    , m_background(false)
+{
+}
+
+ShellPipeline::~ShellPipeline()
+{
+    clear();
+}
+
+ShellPipeline::Result ShellPipeline::parse(char *cmdline)
+{
+    Stage *stage = ZERO;
+    char **redirect = ZERO;
+    char special = ZERO;
+
+    clear();
+
+    while (true)
+    {
+        // Skip whitespace
+        if (!special)
+        {
+            while (*cmdline == ' ' || *cmdline == '\t' || *cmdline == '\r')
+                cmdline++;
+
+            // Ignore comments
+            if (*cmdline == '#' && !m_count)
+                return Empty;
+
+            if (*cmdline && strchr(SPECIAL_CHARS, *cmdline))
+                special = *cmdline++;
+        }
+
+        switch (special)
+        {
+            // Start the next command
+            case '|':
+                if (!stage || !stage->argc || redirect)
+                    return SyntaxError;
+                stage = ZERO;
+                special = ZERO;
+                continue;
+
+            // Run in the background. Ignores anything after it.
+            case '&':
+                m_background = true;
+                break;
+
+            // Redirect input or output to the next argument
+            case '<':
+            case '>':
+                if (redirect || (!stage && !(stage = addStage())))
+                    return SyntaxError;
+
+                if (special == '<')
+                    redirect = &stage->input;
+                else
+                {
+                    redirect = &stage->output;
+                    stage->append = *cmdline == '>';
+                    cmdline += stage->append;
+                }
+                special = ZERO;
+                continue;
+
+            default:
+                break;
+        }
+
+        if (special || !*cmdline)
+            break;
+
+        // Extract one argument
+        char *word = cmdline;
+
+        while (*cmdline && *cmdline != ' ' && *cmdline != '\t' &&
+               *cmdline != '\r' && !strchr(SPECIAL_CHARS, *cmdline))
+            cmdline++;
+
+        if (*cmdline)
+        {
+            if (strchr(SPECIAL_CHARS, *cmdline))
+                special = *cmdline;
+
+            *cmdline++ = ZERO;
+        }
+
+        if (!stage && !(stage = addStage()))
+            return SyntaxError;
+
+        if (redirect)
+        {
+            *redirect = word;
+            redirect = ZERO;
+        }
+        else if (stage->argc < MAX_ARGV)
+            stage->argv[stage->argc++] = word;
+        else
+            return SyntaxError;
+    }
+
+    // Every command needs a program and every redirection a path
+    if (redirect || (m_count && (!stage || !stage->argc)))
+        return SyntaxError;
+
+    return m_count ? Success : Empty;
+}
+
+Size ShellPipeline::count() const
+{
+    return m_count;
+}
+
+ShellPipeline::Stage * ShellPipeline::getStage(Size index) const
+{
+    return index < m_count ? m_stages[index] : ZERO;
+}
+
+bool ShellPipeline::isBackground() const
+{
+    return m_background;
+}
+
+void ShellPipeline::clear()
+{
+    for (Size i = 0; i < m_count; i++)
+        delete m_stages[i];
+
+    m_count = 0;
+    m_background = false;
+}
+
+ShellPipeline::Stage * ShellPipeline::addStage()
+{
+    if (m_count == MAX_PIPELINE)
+        return ZERO;
+
+    Stage *stage = new Stage;
+    MemoryBlock::set(stage, 0, sizeof(*stage));
+    m_stages[m_count++] = stage;
+    return stage;
+}
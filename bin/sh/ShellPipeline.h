@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SH_SHELLPIPELINE
+#define __SH_SHELLPIPELINE
+
+#include <Types.h>
+
+/**
+ * @addtogroup bin
+ * @{
+ *
+ * @addtogroup sh
+ * @{
+ */
+
+/** Maximum number of supported command arguments. */
+#define MAX_ARGV 16
+
+/** Maximum number of commands in a pipeline. */
+#define MAX_PIPELINE 8
+
+/**
+ * Parsed form of a single shell input line.
+ *
+ * A pipeline consists of one or more commands separated by '|'. Each
+ * command may redirect its standard input with '<' and its standard output
+ * with '>' or '>>'. A trailing '&' runs the pipeline in the background.
+ * The input line is tokenized in place and must outlive the pipeline.
+ */
+class ShellPipeline
+{
+  public:
+
+    /**
+     * Result codes
+     */
+    enum Result
+    {
+        Success,
+        Empty,
+        SyntaxError
+    };
+
+    /**
+     * One command of the pipeline.
+     */
+    struct Stage
+    {
+        /** Argument values, terminated by ZERO. */
+        char *argv[MAX_ARGV + 1];
+
+        /** Number of arguments. */
+        Size argc;
+
+        /** Path for standard input redirection or ZERO. */
+        char *input;
+
+        /** Path for standard output redirection or ZERO. */
+        char *output;
+
+        /** True to append to the output file instead of replacing it. */
+        bool append;
+    };
+
+  public:
+
+    /**
+     * Constructor
+     */
+    ShellPipeline();
+
+    /**
+     * Destructor
+     */
+    ~ShellPipeline();
+
+    /**
+     * Parse a command line.
+     *
+     * @param cmdline Command input string, which is modified in place.
+     *
+     * @return Success, Empty for blank lines and comments or SyntaxError.
+     */
+    Result parse(char *cmdline);
+
+    /**
+     * Get number of commands in the pipeline.
+     *
+     * @return Number of commands
+     */
+    Size count() const;
+
+    /**
+     * Get a command of the pipeline.
+     *
+     * @param index Position of the command in the pipeline.
+     *
+     * @return Stage pointer
+     */
+    Stage * getStage(Size index) const;
+
+    /**
+     * Check if the pipeline must run in the background.
+     *
+     * @return True if the line ended with '&'
+     */
+    bool isBackground() const;
+
+  private:
+
+    /**
+     * Remove all commands.
+     */
+    void clear();
+
+    /**
+     * Append a new empty command.
+     *
+     * @return Stage pointer or ZERO if the pipeline is full
+     */
+    Stage * addStage();
+
+  private:
+
+    /** Commands of the pipeline. */
+    Stage *m_stages[MAX_PIPELINE];
+
+    /** Number of commands. */
+    Size m_count;
+
+    /** True if the pipeline must run in the background. */
+    bool m_background;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __SH_SHELLPIPELINE */
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <MemoryBlock.h>
+#include <ListIterator.h>
+#include <Log.h>
+#include "ShellScript.h"
+
+ShellScript::ShellScript(char *text, Size size)
+    : m_text(text)
+    , m_size(size)
+{
+    char *line;
+    Size lineNumber = 1;
+
+    m_tokens = new char[size + 1];
+    MemoryBlock::copy(m_tokens, m_text, size);
+    m_tokens[size] = ZERO;
+
+    // Parse each line
+    line = m_tokens;
+
+    for (Size i = 0; i <= size; i++)
+    {
+        if (m_tokens[i] != '\n' && i != size)
+            continue;
+
+        m_tokens[i] = ZERO;
+
+        ShellPipeline *pipeline = new ShellPipeline;
+
+        switch (pipeline->parse(line))
+        {
+            case ShellPipeline::Success:
+                m_commands.append(pipeline);
+                break;
+
+            case ShellPipeline::SyntaxError:
+                ERROR("syntax error on line " << lineNumber);
+                delete pipeline;
+                break;
+
+            case ShellPipeline::Empty:
+                delete pipeline;
+                break;
+        }
+        line = m_tokens + i + 1;
+        lineNumber++;
+    }
+}
+
+ShellScript::~ShellScript()
+{
+    for (ListIterator<ShellPipeline *> i(m_commands); i.hasCurrent(); i++)
+        delete i.current();
+
+    delete[] m_tokens;
+    delete[] m_text;
+}
+
+bool ShellScript::equals(const char *text, Size size) const
+{
+    if (size != m_size)
+        return false;
+
+    for (Size i = 0; i < size; i++)
+        if (text[i] != m_text[i])
+            return false;
+
+    return true;
+}
+
+const List<ShellPipeline *> & ShellScript::getCommands() const
+{
+    return m_commands;
+}
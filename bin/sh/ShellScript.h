@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SH_SHELLSCRIPT
+#define __SH_SHELLSCRIPT
+
+#include <Types.h>
+#include <List.h>
+#include "ShellPipeline.h"
+
+/**
+ * @addtogroup bin
+ * @{
+ *
+ * @addtogroup sh
+ * @{
+ */
+
+/**
+ * Parsed shell script.
+ *
+ * The Shell keeps parsed scripts in a cache, such that running the same
+ * script again only needs to read and compare its contents.
+ */
+class ShellScript
+{
+  public:
+
+    /**
+     * Constructor
+     *
+     * @param text Script contents. Ownership moves to the ShellScript.
+     * @param size Number of bytes in text.
+     */
+    ShellScript(char *text, Size size);
+
+    /**
+     * Destructor
+     */
+    ~ShellScript();
+
+    /**
+     * Check if the script was parsed from the given contents.
+     *
+     * @param text Script contents.
+     * @param size Number of bytes in text.
+     *
+     * @return True if the contents are unchanged
+     */
+    bool equals(const char *text, Size size) const;
+
+    /**
+     * Get all commands of the script.
+     *
+     * @return List of parsed command lines
+     */
+    const List<ShellPipeline *> & getCommands() const;
+
+  private:
+
+    /** Original script contents. */
+    char *m_text;
+
+    /** Copy of the contents, tokenized by the parser. */
+    char *m_tokens;
+
+    /** Number of bytes in the script. */
+    const Size m_size;
+
+    /** Parsed command lines. */
+    List<ShellPipeline *> m_commands;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __SH_SHELLSCRIPT */
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <Log.h>
+#include "SleepCommand.h"
+
+SleepCommand::SleepCommand()
+    : ShellCommand("sleep", 1)
+{
+    m_help = "Stop executing for some time";
+}
+
+int SleepCommand::execute(Size nparams, char **params)
+{
+    int sec = 0;
+
+    if ((sec = atoi(params[0])) <= 0)
+    {
+        ERROR("invalid sleep time `" << params[0] << "'");
+        return EXIT_FAILURE;
+    }
+
+    if (sleep(sec) != 0)
+    {
+        ERROR("failed to sleep: " << strerror(errno));
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
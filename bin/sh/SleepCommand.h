@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2009 Niek Linnenbank
+ * Copyright (C) 2020 Niek Linnenbank
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -15,46 +15,45 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#ifndef __BIN_BENCH_BENCHMARK_H
-#define __BIN_BENCH_BENCHMARK_H
+#ifndef __SH_SLEEPCOMMAND
+#define __SH_SLEEPCOMMAND
 
-#include <POSIXApplication.h>
+#include <Types.h>
+#include "ShellCommand.h"
 
 /**
  * @addtogroup bin
  * @{
+ *
+ * @addtogroup sh
+ * @{
  */
 
 /**
- * Perform system benchmarking tests.
+ * Stop executing for a number of seconds.
  */
-class BenchMark : public POSIXApplication
+class SleepCommand : public ShellCommand
 {
   public:
 
     /**
-     * Constructor
-     *
-     * @param argc Argument count
-     * @param argv Argument values
+     * Constructor.
      */
-    BenchMark(int argc, char **argv);
+    SleepCommand();
 
     /**
-     * Destructor
-     */
-    virtual ~BenchMark();
-
-    /**
-     * Execute the application.
+     * Executes the command.
      *
-     * @return Result code
+     * @param nparams Number of parameters given.
+     * @param params Array of parameters.
+     * @return Error code or zero on success.
      */
-    virtual Result exec();
+    virtual int execute(Size nparams, char **params);
 };
 
 /**
+ * @}
  * @}
  */
 
-#endif /* __BIN_BENCH_BENCHMARK_H */
+#endif /* __SH_SLEEPCOMMAND */
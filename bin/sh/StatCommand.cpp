@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <Log.h>
+#include "StatCommand.h"
+
+StatCommand::StatCommand()
+    : ShellCommand("stat", 1)
+{
+    m_help = "Retrieve file status from the filesystem";
+}
+
+int StatCommand::execute(Size nparams, char **params)
+{
+    int result = EXIT_SUCCESS;
+    struct stat st;
+
+    for (Size i = 0; i < nparams; i++)
+    {
+        if (stat(params[i], &st) < 0)
+        {
+            ERROR("failed to stat `" << params[i] << "': " << strerror(errno));
+            result = EXIT_FAILURE;
+            continue;
+        }
+
+        printf("File: %s\r\n", params[i]);
+        printf("Type: ");
+
+        if (S_ISREG(st.st_mode))
+            printf("Regular File\r\n");
+
+        else if (S_ISDIR(st.st_mode))
+            printf("Directory\r\n");
+
+        else if (S_ISFIFO(st.st_mode))
+            printf("FIFO\r\n");
+
+        else if (S_ISCHR(st.st_mode) || S_ISBLK(st.st_mode))
+        {
+            printf("%s Device\r\n", S_ISCHR(st.st_mode) ? "Character" : "Block");
+            printf("Major ID: %u\r\n", st.st_dev.major);
+            printf("Minor ID: %u\r\n", st.st_dev.minor);
+        }
+        else
+            printf("Unknown\r\n");
+
+        printf("Mode: %u\r\n", st.st_mode);
+        printf("Size: %u\r\n", st.st_size);
+        printf("Uid:  %u\r\n", st.st_uid);
+        printf("Gid:  %u\r\n", st.st_gid);
+    }
+    return result;
+}
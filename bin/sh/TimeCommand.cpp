@@ -24,39 +24,36 @@
 #include <sys/wait.h>
 #include <Log.h>
 #include "TimeCommand.h"
+#include "Shell.h"
 
-TimeCommand::TimeCommand() : ShellCommand("time", 1)
+TimeCommand::TimeCommand(Shell *shell) : ShellCommand("time", 1)
 {
-    m_help = "Measure the execution time of a program";
+    m_shell = shell;
+    m_help = "Measure the execution time of a command";
 }
 
 int TimeCommand::execute(Size nparams, char **params)
 {
     struct timeval t1, t2;
     struct timezone zone;
-    int pid;
+    char cmdline[256];
+    Size length = 0;
     int status;
-    char tmp[128];
+
+    // Rebuild the command line, such that builtins, pipelines
+    // and scripts can be timed as well
+    for (Size i = 0; i < nparams && length < sizeof(cmdline); i++)
+    {
+        length += snprintf(cmdline + length, sizeof(cmdline) - length,
+                           i ? " %s" : "%s", params[i]);
+    }
 
     // Get timestamp before
     gettimeofday(&t1, &zone);
 
-    // If not, try to execute it as a file directly. */
-    if ((pid = forkexec(params[0], (const char **) params)) != -1)
-    {
-        waitpid(pid, &status, 0);
-    }
-    // Try to find it on the livecd filesystem. (temporary hardcoded PATH)
-    else if (snprintf(tmp, sizeof(tmp), "/bin/%s", params[0]) &&
-            (pid = forkexec(tmp, (const char **) params)) != -1)
-    {
-        waitpid(pid, &status, 0);
-    }
-    else
-    {
-        ERROR("forkexec `" << params[0] << "' failed: " << strerror(errno));
-        return EXIT_FAILURE;
-    }
+    // Execute the command
+    status = m_shell->executeInput(cmdline);
+
     // Get timestamp after
     gettimeofday(&t2, &zone);
 
@@ -64,5 +61,5 @@ int TimeCommand::execute(Size nparams, char **params)
     printf("\r\nTime: ");
     printtimediff(&t1, &t2);
     printf("\r\n");
-    return 0;
+    return status;
 }
@@ -21,6 +21,8 @@
 #include <Types.h>
 #include "ShellCommand.h"
 
+class Shell;
+
 /**
  * @addtogroup bin
  * @{
@@ -38,8 +40,10 @@ class TimeCommand : public ShellCommand
 
     /**
      * Constructor function.
+     *
+     * @param shell Shell object
      */
-    TimeCommand();
+    TimeCommand(Shell *shell);
 
     /**
      * Executes the command.
@@ -49,6 +53,11 @@ class TimeCommand : public ShellCommand
      * @return Error code or zero on success.
      */
     virtual int execute(Size nparams, char **params);
+
+  private:
+
+    /** Shell object */
+    Shell *m_shell;
 };
 
 /**
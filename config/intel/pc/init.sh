@@ -1,4 +1,10 @@
 
+#
+# PCI devices, needed by the video server.
+#
+/server/pci/server &
+write /sys/mountwait /dev/pci
+
 #
 # VGA/keyboard console
 #
@@ -15,6 +21,14 @@ stdio /console/tty0 /console/tty0
 /server/filesystem/tmp/server /tmp &
 /server/network/loopback/server &
 
+#
+# Disk and network drivers. Each exits
+# when its device is not present.
+#
+/server/virtio/block/server &
+/server/ahci/server &
+/server/network/virtio/server &
+
 #
 # Serial console
 #
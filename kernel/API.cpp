@@ -16,6 +16,8 @@
  */
 
 #include <FreeNOS/System.h>
+#include <FreeNOS/Kernel.h>
+#include <FreeNOS/ProcessManager.h>
 #include <Log.h>
 
 API::API()
@@ -31,6 +33,7 @@ API::API()
     m_apis.insert(VMCtlNumber,      (Handler *) VMCtlHandler);
     m_apis.insert(VMShareNumber,    (Handler *) VMShareHandler);
     m_apis.insert(IOCtlNumber,      (Handler *) IOCtlHandler);
+    m_apis.insert(TraceCtlNumber,   (Handler *) TraceCtlHandler);
 }
 
 API::Result API::invoke(Number number,
@@ -40,12 +43,47 @@ API::Result API::invoke(Number number,
                         ulong arg4,
                         ulong arg5)
 {
-    Handler **handler = (Handler **) m_apis.get(number);
+    Handler *handler = getHandler(number);
 
-    if (handler && *handler)
-        return (*handler)(arg1, arg2, arg3, arg4, arg5);
-    else
+    if (!handler)
         return InvalidArgument;
+
+    return execute(number, handler, arg1, arg2, arg3, arg4, arg5);
+}
+
+API::Handler * API::getHandler(Number number) const
+{
+    Handler * const *handler = m_apis.get(number);
+
+    return handler ? *handler : ZERO;
+}
+
+API::Result API::execute(Number number,
+                         Handler *handler,
+                         ulong arg1,
+                         ulong arg2,
+                         ulong arg3,
+                         ulong arg4,
+                         ulong arg5)
+{
+    ProcessManager *procs = Kernel::instance->getProcessManager();
+    Process *proc = procs->current();
+    Size switches = procs->getSwitches();
+    u64 start = timestamp();
+    Result result;
+
+    if (proc)
+        proc->chargeSystemCall(number);
+
+    TRACE(TraceSystemCallEnter, proc ? proc->getID() : 0, number);
+    result = (*handler)(arg1, arg2, arg3, arg4, arg5);
+    TRACE(TraceSystemCallExit, procs->current() ? procs->current()->getID() : 0, result);
+
+    // Only charge the handler time if no other process ran meanwhile
+    if (proc && procs->getSwitches() == switches)
+        proc->chargeKernelCycles(timestamp() - start);
+
+    return result;
 }
 
 Log & operator << (Log &log, API::Operation op)
@@ -52,7 +52,8 @@ class API
         VMCopyNumber,
         VMCtlNumber,
         VMShareNumber,
-        IOCtlNumber
+        IOCtlNumber,
+        TraceCtlNumber
     }
     Number;
 
@@ -68,7 +69,8 @@ class API
         InvalidArgument = -4,
         OutOfMemory     = -5,
         IOError         = -6,
-        AlreadyExists   = -7
+        AlreadyExists   = -7,
+        RetryAgain      = -8
     }
     Error;
 
@@ -114,6 +116,35 @@ class API
                   ulong arg4,
                   ulong arg5);
 
+    /**
+     * Get the handler of an API function.
+     *
+     * @param number API function number
+     *
+     * @return Handler or ZERO if the number is not valid.
+     */
+    Handler * getHandler(Number number) const;
+
+    /**
+     * Execute an API handler on behalf of the current process.
+     *
+     * Charges the system call to the current process and records trace events.
+     * Used directly by architecture entry paths which decode the handler
+     * and arguments from registers.
+     *
+     * @param number API function number
+     * @param handler Handler of the API function
+     *
+     * @return Result of the handler
+     */
+    Result execute(Number number,
+                   Handler *handler,
+                   ulong arg1,
+                   ulong arg2,
+                   ulong arg3,
+                   ulong arg4,
+                   ulong arg5);
+
   private:
 
     /** API handlers */
@@ -138,6 +169,7 @@ Log & operator << (Log &log, API::Operation op);
 #include "API/VMCtl.h"
 #include "API/VMShare.h"
 #include "API/IOCtl.h"
+#include "API/TraceCtl.h"
 #include "API/ProcessID.h"
 
 #endif /* __KERNEL_API_H */
@@ -17,6 +17,7 @@
 
 #include <FreeNOS/System.h>
 #include <FreeNOS/Kernel.h>
+#include <FreeNOS/PageCache.h>
 #include <FreeNOS/Config.h>
 #include <FreeNOS/Process.h>
 #include <FreeNOS/ProcessEvent.h>
@@ -49,6 +50,24 @@ API::Result ProcessCtlHandler(ProcessID procID,
     {
     case Spawn:
         proc = procs->create(addr, map);
+
+        // Retry once the page broker granted more memory
+        if (!proc)
+        {
+            switch (Kernel::instance->getPageCache()->refill(PageCache::ChunkSize))
+            {
+                case PageCache::Success:
+                    proc = procs->create(addr, map);
+                    break;
+
+                case PageCache::RetryAgain:
+                    return API::RetryAgain;
+
+                default:
+                    break;
+            }
+        }
+
         if (!proc)
         {
             ERROR("failed to create process");
@@ -72,6 +91,8 @@ API::Result ProcessCtlHandler(ProcessID procID,
         break;
 
     case Resume:
+        TRACE(TraceResume, procs->current()->getID(), proc->getID());
+
         // increment wakeup counter and set process ready
         if (procs->wakeup(proc) != ProcessManager::Success)
         {
@@ -80,6 +101,22 @@ API::Result ProcessCtlHandler(ProcessID procID,
         }
         break;
 
+    case Handoff:
+        TRACE(TraceResume, procs->current()->getID(), proc->getID());
+
+        // wakeup the process and let it run on the remainder of our timeslice
+        if (procs->wakeup(proc) != ProcessManager::Success)
+        {
+            ERROR("failed to wakeup process ID " << proc->getID());
+            return API::IOError;
+        }
+        if (procs->handoff(proc) != ProcessManager::Success)
+        {
+            ERROR("failed to handoff to process ID " << proc->getID());
+            return API::IOError;
+        }
+        break;
+
     case WatchIRQ:
         if (procs->registerInterruptNotify(proc, addr) != ProcessManager::Success)
         {
@@ -97,13 +134,15 @@ API::Result ProcessCtlHandler(ProcessID procID,
         break;
 
     case SendIRQ:
-        Kernel::instance->sendIRQ(addr >> 16, addr & 0xffff);
+        if (Kernel::instance->sendIRQ(addr >> 16, addr & 0xffff) != Kernel::Success)
+            return API::IOError;
         break;
 
     case InfoPID:
         info->id    = proc->getID();
         info->state = proc->getState();
         info->parent = proc->getParent();
+        MemoryBlock::copy(&info->usage, &proc->getUsage(), sizeof(info->usage));
         break;
 
     case WaitPID:
@@ -164,6 +203,7 @@ Log & operator << (Log &log, ProcessOperation op)
         case EnterSleep: log.append("EnterSleep"); break;
         case Schedule:  log.append("Schedule"); break;
         case Resume:    log.append("Resume"); break;
+        case Handoff:   log.append("Handoff"); break;
         default:        log.append("???"); break;
     }
     return log;
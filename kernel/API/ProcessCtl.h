@@ -52,6 +52,7 @@ typedef enum ProcessOperation
     EnterSleep,
     Schedule,
     Resume,
+    Handoff
 }
 ProcessOperation;
 
@@ -68,6 +69,9 @@ typedef struct ProcessInfo
 
     /** Defines the current state of the Process. */
     Process::State state;
+
+    /** Resource usage counters of the Process. */
+    Process::Usage usage;
 }
 ProcessInfo;
 
@@ -87,7 +91,14 @@ Log & operator << (Log &log, ProcessOperation op);
  */
 inline API::Result ProcessCtl(ProcessID proc, ProcessOperation op, Address addr = 0, Address output = 0)
 {
-    return trapKernel4(API::ProcessCtlNumber, proc, op, addr, output);
+    API::Result r;
+
+    // Retry while the kernel waits for memory from the page broker
+    while ((r = trapKernel4(API::ProcessCtlNumber, proc, op, addr, output)) == API::RetryAgain &&
+           op == Spawn)
+        ;
+
+    return r;
 }
 
 /**
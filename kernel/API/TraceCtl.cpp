@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include "TraceCtl.h"
+
+API::Result TraceCtlHandler(TraceOperation op, Address addr, Size count)
+{
+    Trace *trace = Kernel::instance->getTrace();
+
+    DEBUG("op = " << op << " addr = " << (void *) addr << " count = " << count);
+
+    switch (op)
+    {
+        case TraceGetMask:
+            return trace->getMask();
+
+        case TraceSetMask:
+            trace->setMask(addr);
+            break;
+
+        case TraceRead:
+            if (!addr)
+                return API::InvalidArgument;
+
+            return trace->drain((TraceEvent *) addr, count);
+    }
+    return API::Success;
+}
+
+Log & operator << (Log &log, TraceOperation op)
+{
+    switch (op)
+    {
+        case TraceGetMask: log.append("TraceGetMask"); break;
+        case TraceSetMask: log.append("TraceSetMask"); break;
+        case TraceRead:    log.append("TraceRead");    break;
+    }
+    return log;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __API_TRACECTL_H
+#define __API_TRACECTL_H
+
+#ifndef __SYSTEM
+#error Do not include this file directly, use FreeNOS/System.h instead
+#endif
+
+#include <FreeNOS/TraceEvent.h>
+#include <Log.h>
+#include <Types.h>
+
+/**
+ * @addtogroup kernel
+ * @{
+ *
+ * @addtogroup kernelapi
+ * @{
+ */
+
+/**
+ * Available operations to perform using TraceCtl.
+ *
+ * @see TraceCtl
+ */
+typedef enum TraceOperation
+{
+    TraceGetMask = 0,
+    TraceSetMask,
+    TraceRead
+}
+TraceOperation;
+
+/** Operator to print a TraceOperation to a Log */
+Log & operator << (Log &log, TraceOperation op);
+
+/**
+ * Control the kernel event trace of the current core.
+ *
+ * @param op The operation to perform.
+ * @param addr New mask for TraceSetMask, TraceEvent array for TraceRead.
+ * @param count Maximum number of events for TraceRead.
+ *
+ * @return Mask for TraceGetMask, number of events for TraceRead
+ *         or API::ErrorCode on failure.
+ */
+inline API::Result TraceCtl(TraceOperation op, Address addr = 0, Size count = 0)
+{
+    return trapKernel3(API::TraceCtlNumber, op, addr, count);
+}
+
+/**
+ * @}
+ */
+
+#ifdef __KERNEL__
+
+/**
+ * @addtogroup kernelapi_handler
+ * @{
+ */
+
+/**
+ * Kernel handler prototype.
+ *
+ * @param op The operation to perform.
+ * @param addr Input/Output address
+ * @param count Maximum number of events
+ *
+ * @return API::Success or number of events on success, API::ErrorCode on failure
+ */
+extern API::Result TraceCtlHandler(TraceOperation op, Address addr, Size count);
+
+/**
+ * @}
+ */
+
+#endif /* __KERNEL__ */
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __API_TRACECTL_H */
@@ -16,6 +16,7 @@
  */
 
 #include <FreeNOS/System.h>
+#include <FreeNOS/PageCache.h>
 #include <SplitAllocator.h>
 #include "VMCtl.h"
 #include "ProcessID.h"
@@ -47,14 +48,45 @@ API::Result VMCtlHandler(ProcessID procID, MemoryOperation op, Memory::Range *ra
                 return API::AccessViolation;
             break;
 
-        case Map:
+        case Map: {
+            const Memory::Range request = *range;
+
             if (!range->virt)
             {
                 mem->findFree(range->size, MemoryMap::UserPrivate, &range->virt);
                 range->virt += range->phys & ~PAGEMASK;
             }
-            mem->mapRange(range);
+            // Grants from the broker may not have arrived yet
+            while (mem->mapRange(range) == MemoryContext::OutOfMemory)
+            {
+                mem->unmapRange(range);
+
+                // Release pages which mapRange() allocated for a partial mapping
+                if (!request.phys && range->phys)
+                {
+                    for (Size i = 0; i < range->size; i += PAGESIZE)
+                        Kernel::instance->getAllocator()->release(range->phys + i);
+                }
+                range->phys = request.phys;
+
+                switch (Kernel::instance->getPageCache()->refill(range->size))
+                {
+                    case PageCache::Success:
+                        continue;
+
+                    case PageCache::RetryAgain:
+                        *range = request;
+                        return API::RetryAgain;
+
+                    default:
+                        *range = request;
+                        return API::OutOfMemory;
+                }
+            }
+            TRACE(TracePageMap, procs->current()->getID(), range->virt);
+            Kernel::instance->getPageCache()->balance();
             break;
+        }
 
         case UnMap:
             mem->unmapRange(range);
@@ -62,6 +94,7 @@ API::Result VMCtlHandler(ProcessID procID, MemoryOperation op, Memory::Range *ra
 
         case Release:
             mem->releaseRange(range);
+            Kernel::instance->getPageCache()->balance();
             break;
 
         case CacheClean: {
@@ -79,16 +112,36 @@ API::Result VMCtlHandler(ProcessID procID, MemoryOperation op, Memory::Range *ra
             break;
         }
 
-        case ReserveMem: {
-            Allocator::Range alloc_args;
-            alloc_args.address = range->phys;
-            alloc_args.size    = range->size;
-            alloc_args.alignment = PAGESIZE;
+        case ReserveMem:
+        case AddMem: {
+            SplitAllocator *alloc = Kernel::instance->getAllocator();
 
-            if (Kernel::instance->getAllocator()->allocate(alloc_args) != Allocator::Success)
+            if (range->phys < alloc->base() || range->phys > alloc->base() + alloc->size() ||
+                range->size > alloc->base() + alloc->size() - range->phys)
             {
-                ERROR("address " << (void *) (range->phys) << " already allocated");
-                return API::OutOfMemory;
+                return API::InvalidArgument;
+            }
+
+            // Give pages back to the allocator
+            if (op == AddMem)
+            {
+                for (Size i = 0; i < range->size; i += PAGESIZE)
+                    alloc->release(range->phys + i);
+                break;
+            }
+
+            // Claim exactly the given pages, or none of them
+            for (Size i = 0; i < range->size; i += PAGESIZE)
+            {
+                if (alloc->allocate(range->phys + i) != Allocator::Success)
+                {
+                    DEBUG("address " << (void *) (range->phys + i) << " already allocated");
+
+                    for (Size j = 0; j < i; j += PAGESIZE)
+                        alloc->release(range->phys + j);
+
+                    return API::OutOfMemory;
+                }
             }
             break;
         }
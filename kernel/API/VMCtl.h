@@ -56,7 +56,13 @@ MemoryOperation;
 inline API::Result VMCtl(ProcessID procID, MemoryOperation op,
                          Memory::Range *range = ZERO)
 {
-    return trapKernel3(API::VMCtlNumber, procID, op, (Address) range);
+    API::Result r;
+
+    // Retry while the kernel waits for memory from the page broker
+    while ((r = trapKernel3(API::VMCtlNumber, procID, op, (Address) range)) == API::RetryAgain)
+        ;
+
+    return r;
 }
 
 /**
@@ -17,7 +17,6 @@
 
 #include <FreeNOS/System.h>
 #include <Log.h>
-#include <ListIterator.h>
 #include <SplitAllocator.h>
 #include <BubbleAllocator.h>
 #include <PoolAllocator.h>
@@ -28,9 +27,10 @@
 #include "Memory.h"
 #include "Process.h"
 #include "ProcessManager.h"
+#include "PageCache.h"
 
 Kernel::Kernel(CoreInfo *info)
-    : Singleton<Kernel>(this), m_interrupts(256)
+    : Singleton<Kernel>(this)
 {
     // Output log banners
     if (Log::instance)
@@ -48,6 +48,7 @@ Kernel::Kernel(CoreInfo *info)
     m_alloc  = new SplitAllocator(physRange, virtRange, PAGESIZE);
     m_procs  = new ProcessManager();
     m_api    = new API();
+    m_trace  = new Trace();
     m_coreInfo   = info;
     m_intControl = ZERO;
     m_timer      = ZERO;
@@ -72,8 +73,11 @@ Kernel::Kernel(CoreInfo *info)
     for (Size i = 0; i < m_coreInfo->coreChannelSize; i += PAGESIZE)
         m_alloc->allocate(m_coreInfo->coreChannelAddress + i);
 
+    // Remaining memory not owned by this core belongs to the page broker
+    m_pageCache = new PageCache(m_coreInfo, m_alloc);
+
     // Clear interrupts table
-    m_interrupts.fill(ZERO);
+    MemoryBlock::set(m_interrupts, 0, sizeof(m_interrupts));
 }
 
 Error Kernel::heap(Address base, Size size)
@@ -126,6 +130,16 @@ Timer * Kernel::getTimer()
     return m_timer;
 }
 
+Trace * Kernel::getTrace()
+{
+    return m_trace;
+}
+
+PageCache * Kernel::getPageCache()
+{
+    return m_pageCache;
+}
+
 void Kernel::enableIRQ(u32 irq, bool enabled)
 {
     if (m_intControl)
@@ -152,20 +166,30 @@ Kernel::Result Kernel::sendIRQ(const uint coreId, const uint irq)
     return Success;
 }
 
-void Kernel::hookIntVector(u32 vec, InterruptHandler h, ulong p)
+Kernel::Result Kernel::hookIntVector(u32 vec, InterruptHandler h, ulong p)
 {
-    InterruptHook hook(h, p);
+    if (vec >= INTERRUPT_VECTORS)
+        return InvalidArgument;
 
-    // Insert into interrupts; create List if neccesary
-    if (!m_interrupts[vec])
+    InterruptEntry *entry = &m_interrupts[vec];
+
+    // Skip if already installed
+    for (Size i = 0; i < entry->count; i++)
     {
-        m_interrupts.insert(vec, new List<InterruptHook *>());
+        if (entry->hooks[i].handler == h && entry->hooks[i].param == p)
+            return Success;
     }
-    // Just append it. */
-    if (!m_interrupts[vec]->contains(&hook))
+
+    if (entry->count >= INTERRUPT_HOOKS_MAX)
     {
-        m_interrupts[vec]->append(new InterruptHook(h, p));
+        ERROR("no free hook for interrupt vector " << vec);
+        return IOError;
     }
+
+    entry->hooks[entry->count].handler = h;
+    entry->hooks[entry->count].param   = p;
+    entry->count++;
+    return Success;
 }
 
 void Kernel::executeIntVector(u32 vec, CPUState *state)
@@ -174,16 +198,15 @@ void Kernel::executeIntVector(u32 vec, CPUState *state)
     // needs to re-enable the IRQ to receive it again. This prevents
     // interrupt loops in case the kernel cannot clear the IRQ immediately.
     enableIRQ(vec, false);
+    TRACE(TraceInterrupt, m_procs->current() ? m_procs->current()->getID() : 0, vec);
 
-    // Fetch the list of interrupt hooks (for this vector)
-    List<InterruptHook *> *lst = m_interrupts[vec];
-    if (lst)
+    // Execute the interrupt hooks for this vector
+    if (vec < INTERRUPT_VECTORS)
     {
-        // Execute them all
-        for (ListIterator<InterruptHook *> i(lst); i.hasCurrent(); i++)
-        {
-            i.current()->handler(state, i.current()->param, vec);
-        }
+        const InterruptEntry *entry = &m_interrupts[vec];
+
+        for (Size i = 0; i < entry->count; i++)
+            entry->hooks[i].handler(state, entry->hooks[i].param, vec);
     }
 
     // Raise any interrupt notifications for processes. Note that the IRQ
@@ -26,10 +26,12 @@
 #include <CoreInfo.h>
 #include "Process.h"
 #include "ProcessManager.h"
+#include "Trace.h"
 
 /** Forward declarations. */
 class API;
 class SplitAllocator;
+class PageCache;
 class IntController;
 class Timer;
 struct CPUState;
@@ -48,32 +50,17 @@ struct CPUState;
  */
 typedef void InterruptHandler(struct CPUState *state, ulong param, ulong vector);
 
+/** Number of entries in the interrupt table. */
+#define INTERRUPT_VECTORS   256
+
+/** Maximum number of handlers sharing a single interrupt vector. */
+#define INTERRUPT_HOOKS_MAX 3
+
 /**
  * Interrupt hook class.
  */
 typedef struct InterruptHook
 {
-    /**
-     * Constructor function.
-     *
-     * @param h Handler function for the hook.
-     * @param p Parameter to pass.
-     */
-    InterruptHook(InterruptHandler *h, ulong p) : handler(h), param(p)
-    {
-    }
-
-    /**
-     * Comparision operator.
-     *
-     * @param i InterruptHook pointer.
-     * @return True if equal, false otherwise.
-     */
-    bool operator == (InterruptHook *i)
-    {
-        return handler == i->handler && param == i->param;
-    }
-
     /** Executed at time of interrupt. */
     InterruptHandler *handler;
 
@@ -82,6 +69,22 @@ typedef struct InterruptHook
 }
 InterruptHook;
 
+/**
+ * Interrupt table entry.
+ *
+ * Hooks are stored inline instead of in a heap allocated List, so that
+ * dispatching an interrupt does not follow list nodes.
+ */
+typedef struct InterruptEntry
+{
+    /** Hooks in the order they were installed. */
+    InterruptHook hooks[INTERRUPT_HOOKS_MAX];
+
+    /** Number of installed hooks. */
+    Size count;
+}
+InterruptEntry;
+
 /**
  * FreeNOS kernel implementation.
  */
@@ -97,7 +100,8 @@ class Kernel : public Singleton<Kernel>
         Success,
         InvalidBootImage,
         ProcessError,
-        IOError
+        IOError,
+        InvalidArgument
     };
 
     /**
@@ -161,6 +165,20 @@ class Kernel : public Singleton<Kernel>
      */
     Timer * getTimer();
 
+    /**
+     * Get Trace.
+     *
+     * @return Kernel event Trace object pointer
+     */
+    Trace * getTrace();
+
+    /**
+     * Get PageCache.
+     *
+     * @return Kernel PageCache object pointer
+     */
+    PageCache * getPageCache();
+
     /**
      * Execute the kernel.
      */
@@ -190,8 +208,10 @@ class Kernel : public Singleton<Kernel>
      * @param vec Interrupt vector to hook on.
      * @param h Handler function.
      * @param p Parameter to pass to the handler function.
+     *
+     * @return Result code
      */
-    virtual void hookIntVector(u32 vec, InterruptHandler h, ulong p);
+    virtual Result hookIntVector(u32 vec, InterruptHandler h, ulong p);
 
     /**
      * Execute an interrupt handler.
@@ -231,14 +251,20 @@ class Kernel : public Singleton<Kernel>
     /** CoreInfo object for this core. */
     CoreInfo *m_coreInfo;
 
-    /** Interrupt handlers. */
-    Vector<List<InterruptHook *> *> m_interrupts;
+    /** Interrupt handlers table. */
+    InterruptEntry m_interrupts[INTERRUPT_VECTORS];
 
     /** Interrupt Controller. */
     IntController *m_intControl;
 
     /** Timer device. */
     Timer *m_timer;
+
+    /** Kernel event trace */
+    Trace *m_trace;
+
+    /** Cache of free pages, refilled by the page broker */
+    PageCache *m_pageCache;
 };
 
 /**
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <SplitAllocator.h>
+#include <CoreInfo.h>
+#include <Log.h>
+#include "PageCache.h"
+
+PageCache::PageCache(CoreInfo *info, SplitAllocator *alloc)
+    : m_info(info)
+    , m_alloc(alloc)
+    , m_enabled(info->coreId != 0 && info->memoryOwned != 0)
+    , m_outstanding(0)
+    , m_waits(0)
+    , m_granted(0)
+    , m_exhausted(false)
+{
+    if (!m_enabled)
+        return;
+
+    // Pages outside the owned part are granted later by the broker
+    for (Size i = info->memoryOwned; i < info->memory.size; i += PAGESIZE)
+        m_alloc->allocate(info->memory.phys + i);
+
+    // The broker channels follow the CoreServer channels
+    const Address base = info->coreChannelAddress + (PAGESIZE * 4);
+
+    m_toBroker.setMode(Channel::Producer);
+    m_toBroker.setMessageSize(sizeof(CoreMemoryMessage));
+    m_toBroker.setVirtual(m_alloc->toVirtual(base),
+                          m_alloc->toVirtual(base + PAGESIZE));
+
+    m_fromBroker.setMode(Channel::Consumer);
+    m_fromBroker.setMessageSize(sizeof(CoreMemoryMessage));
+    m_fromBroker.setVirtual(m_alloc->toVirtual(base + (PAGESIZE * 2)),
+                            m_alloc->toVirtual(base + (PAGESIZE * 3)));
+}
+
+void PageCache::balance()
+{
+    if (!m_enabled)
+        return;
+
+    collect();
+
+    const Size avail = m_alloc->available();
+
+    if (avail < LowWatermark)
+    {
+        if (!m_outstanding && !m_exhausted && send(ZERO, ChunkSize))
+            m_outstanding++;
+    }
+    else
+    {
+        m_exhausted = false;
+
+        // Return a free chunk to the broker
+        if (avail > HighWatermark)
+        {
+            Allocator::Range range;
+            range.address   = 0;
+            range.size      = ChunkSize;
+            range.alignment = ChunkSize;
+
+            if (m_alloc->allocate(range) == Allocator::Success && !send(range.address, ChunkSize))
+            {
+                for (Size i = 0; i < ChunkSize; i += PAGESIZE)
+                    m_alloc->release(range.address + i);
+            }
+        }
+    }
+}
+
+PageCache::Result PageCache::refill(Size size)
+{
+    if (!m_enabled)
+        return OutOfMemory;
+
+    // A single grant must hold the whole allocation
+    const Size chunk = CEIL(size, ChunkSize) * ChunkSize;
+
+    collect();
+
+    if (m_granted >= chunk)
+    {
+        m_granted = 0;
+        return Success;
+    }
+
+    // Wait for the answer to a request which is already sent
+    if (m_outstanding)
+        return RetryAgain;
+
+    if (m_exhausted || !send(ZERO, chunk))
+        return OutOfMemory;
+
+    m_outstanding++;
+    m_granted = 0;
+    return RetryAgain;
+}
+
+void PageCache::collect()
+{
+    CoreMemoryMessage msg;
+
+    while (m_fromBroker.read(&msg) == Channel::Success)
+        receive(&msg);
+
+    // Do not wait forever for an answer which got lost
+    if (m_outstanding && ++m_waits > PendingLimit)
+    {
+        ERROR("no answer from page broker, dropping " << m_outstanding << " requests");
+        m_outstanding = 0;
+        m_waits = 0;
+    }
+}
+
+void PageCache::receive(const CoreMemoryMessage *msg)
+{
+    if (m_outstanding)
+        m_outstanding--;
+
+    m_waits = 0;
+
+    if (!msg->phys)
+    {
+        m_exhausted = true;
+        return;
+    }
+
+    if (msg->phys < m_info->memory.phys ||
+        msg->phys + msg->size > m_info->memory.phys + m_info->memory.size)
+    {
+        ERROR("broker granted invalid range at " << (void *) msg->phys);
+        return;
+    }
+
+    for (Size i = 0; i < msg->size; i += PAGESIZE)
+        m_alloc->release(msg->phys + i);
+
+    if (msg->size > m_granted)
+        m_granted = msg->size;
+}
+
+bool PageCache::send(Address phys, Size size)
+{
+    CoreMemoryMessage msg;
+    msg.phys = phys;
+    msg.size = size;
+
+    if (m_toBroker.write(&msg) != Channel::Success)
+        return false;
+
+    m_toBroker.flush();
+    Kernel::instance->sendIRQ(0, m_info->brokerInterrupt);
+    return true;
+}
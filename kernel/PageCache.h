@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __KERNEL_PAGECACHE_H
+#define __KERNEL_PAGECACHE_H
+
+#include <Types.h>
+#include <Macros.h>
+#include <MemoryChannel.h>
+
+/** Forward declarations. */
+class SplitAllocator;
+struct CoreInfo;
+struct CoreMemoryMessage;
+
+/**
+ * @addtogroup kernel
+ * @{
+ */
+
+/**
+ * Per-core cache of free physical memory pages.
+ *
+ * The kernel of a secondary core only owns a small part of its memory
+ * range at boot. The remaining pages belong to the page broker in the
+ * CoreServer on core0. When the number of free pages drops below the low
+ * watermark the cache requests a chunk from the broker, and when it rises
+ * above the high watermark a chunk is returned. Requests and grants are
+ * asynchronous: grants are collected on the next call to balance().
+ * When an allocation fails before a grant arrived, refill() requests
+ * memory and the system call returns RetryAgain until the grant arrives.
+ * The kernel never waits for the broker itself.
+ */
+class PageCache
+{
+  public:
+
+    /**
+     * Result codes
+     */
+    enum Result
+    {
+        Success,
+        RetryAgain,
+        OutOfMemory
+    };
+
+    /** Number of bytes requested from or returned to the broker at once */
+    static const Size ChunkSize = MegaByte(4);
+
+    /** Request a chunk when less memory than this is available */
+    static const Size LowWatermark = MegaByte(8);
+
+    /** Return a chunk when more memory than this is available */
+    static const Size HighWatermark = MegaByte(32);
+
+    /** Number of balance() and refill() calls after which an unanswered request is dropped */
+    static const Size PendingLimit = 1024;
+
+  public:
+
+    /**
+     * Constructor.
+     *
+     * Marks all pages not owned by the core at boot as allocated.
+     *
+     * @param info CoreInfo of this core
+     * @param alloc Physical memory allocator of this core
+     */
+    PageCache(CoreInfo *info, SplitAllocator *alloc);
+
+    /**
+     * Exchange chunks with the broker, if needed.
+     *
+     * Cheap when the amount of free memory is between the watermarks.
+     */
+    void balance();
+
+    /**
+     * Request memory from the broker, without waiting for the answer.
+     *
+     * Called again by the retried allocation, until the answer arrives.
+     *
+     * @param size Number of physically contiguous bytes needed
+     *
+     * @return Success if a large enough chunk was granted, RetryAgain
+     *         while the request is pending and OutOfMemory otherwise.
+     */
+    Result refill(Size size);
+
+  private:
+
+    /**
+     * Collect answers from the broker.
+     */
+    void collect();
+
+    /**
+     * Process a message from the broker.
+     *
+     * @param msg Grant, or a zero address if the broker has no memory left
+     */
+    void receive(const CoreMemoryMessage *msg);
+
+    /**
+     * Send a message to the broker.
+     *
+     * @param phys Physical address of returned pages or zero to request pages
+     * @param size Number of bytes
+     *
+     * @return True if sent, false if the channel is full
+     */
+    bool send(Address phys, Size size);
+
+  private:
+
+    /** CoreInfo of this core */
+    CoreInfo *m_info;
+
+    /** Physical memory allocator */
+    SplitAllocator *m_alloc;
+
+    /** Channel to the broker */
+    MemoryChannel m_toBroker;
+
+    /** Channel from the broker */
+    MemoryChannel m_fromBroker;
+
+    /** True if the broker is used by this core */
+    bool m_enabled;
+
+    /** Number of requests sent and not yet answered */
+    Size m_outstanding;
+
+    /** Number of balance() and refill() calls since the last answer of the broker */
+    Size m_waits;
+
+    /** Largest chunk granted since the last request of refill() */
+    Size m_granted;
+
+    /** True if the broker had no memory left for the last request */
+    bool m_exhausted;
+};
+
+/**
+ * @}
+ */
+
+#endif /* __KERNEL_PAGECACHE_H */
@@ -25,7 +25,7 @@
 #include "ProcessEvent.h"
 
 Process::Process(ProcessID id, Address entry, bool privileged, const MemoryMap &map)
-    : m_id(id), m_map(map), m_shares(id)
+    : m_id(id), m_map(map), m_shares(id), m_interruptEvents(InterruptEventTableSize)
 {
     m_state         = Sleeping;
     m_parent        = 0;
@@ -36,7 +36,9 @@ Process::Process(ProcessID id, Address entry, bool privileged, const MemoryMap &
     m_privileged    = privileged;
     m_memoryContext = ZERO;
     m_kernelChannel = new MemoryChannel;
+    m_eventCount    = 0;
     MemoryBlock::set(&m_sleepTimer, 0, sizeof(m_sleepTimer));
+    MemoryBlock::set(&m_usage, 0, sizeof(m_usage));
 }
 
 Process::~Process()
@@ -95,6 +97,24 @@ const Timer::Info & Process::getSleepTimer() const
     return m_sleepTimer;
 }
 
+const Process::Usage & Process::getUsage() const
+{
+    return m_usage;
+}
+
+void Process::chargeSystemCall(ulong number)
+{
+    m_usage.systemCalls++;
+
+    if (number < MaxSystemCalls)
+        m_usage.systemCallsByNumber[number]++;
+}
+
+void Process::chargeKernelCycles(u64 cycles)
+{
+    m_usage.kernelCycles += cycles;
+}
+
 MemoryContext * Process::getMemoryContext()
 {
     return m_memoryContext;
@@ -126,9 +146,24 @@ Process::Result Process::wait(ProcessID id)
 
 Process::Result Process::raiseEvent(ProcessEvent *event)
 {
+    // Coalesce with an unread event for the same interrupt vector
+    if (event->type == InterruptEvent)
+    {
+        const Size *sequence = m_interruptEvents.get(event->number);
+
+        if (sequence && *sequence >= m_eventCount - m_kernelChannel->pending())
+            return m_state == Ready ? Success : wakeup();
+    }
+
     // Write the message. Be sure to flush the caches because
     // the kernel has mapped the channel pages separately in low memory.
-    m_kernelChannel->write(event);
+    if (m_kernelChannel->write(event) == Channel::Success)
+    {
+        if (event->type == InterruptEvent)
+            m_interruptEvents.insert(event->number, m_eventCount);
+
+        m_eventCount++;
+    }
     m_kernelChannel->flush();
 
     // Wakeup the Process, if needed
@@ -24,6 +24,7 @@
 #include <MemoryMap.h>
 #include <Timer.h>
 #include <Index.h>
+#include <HashTable.h>
 #include "ProcessShares.h"
 
 /** @see IPCMessage.h. */
@@ -71,6 +72,34 @@ class Process
         Waiting
     };
 
+    /** Number of system call API numbers for which usage is counted */
+    static const Size MaxSystemCalls = 16;
+
+    /**
+     * Resource usage counters of the Process
+     */
+    typedef struct Usage
+    {
+        /** Timer ticks in which this Process was running */
+        Size ticks;
+
+        /** Number of times the Process gave up the CPU by blocking */
+        Size voluntarySwitches;
+
+        /** Number of times the Process was preempted while still Ready */
+        Size involuntarySwitches;
+
+        /** Total number of system calls */
+        Size systemCalls;
+
+        /** Number of system calls per API number */
+        Size systemCallsByNumber[MaxSystemCalls];
+
+        /** Timestamp cycles spent inside system call handlers */
+        u64 kernelCycles;
+    }
+    Usage;
+
   public:
 
     /**
@@ -125,6 +154,27 @@ class Process
      */
     State getState() const;
 
+    /**
+     * Get resource usage counters.
+     *
+     * @return Usage counters reference.
+     */
+    const Usage & getUsage() const;
+
+    /**
+     * Account a system call.
+     *
+     * @param number API number of the system call.
+     */
+    void chargeSystemCall(ulong number);
+
+    /**
+     * Account time spent inside the kernel.
+     *
+     * @param cycles Timestamp cycles spent inside a system call handler.
+     */
+    void chargeKernelCycles(u64 cycles);
+
     /**
      * Get MMU memory context.
      *
@@ -199,6 +249,9 @@ class Process
     /**
      * Raise kernel event
      *
+     * An InterruptEvent is dropped if an event for the same
+     * vector is still unread in the kernel event channel.
+     *
      * @return Result code
      */
     Result raiseEvent(struct ProcessEvent *event);
@@ -222,6 +275,11 @@ class Process
      */
     virtual void setWaitResult(uint result);
 
+  protected:
+
+    /** Number of buckets in the interrupt event table */
+    static const Size InterruptEventTableSize = 8;
+
   protected:
 
     /** Process Identifier */
@@ -266,6 +324,15 @@ class Process
 
     /** Channel for sending kernel events to the Process */
     MemoryChannel *m_kernelChannel;
+
+    /** Number of events written to the kernel event channel */
+    Size m_eventCount;
+
+    /** Maps interrupt vectors to the sequence number of their last event */
+    HashTable<Size, Size> m_interruptEvents;
+
+    /** Resource usage counters */
+    Usage m_usage;
 };
 
 /**
@@ -29,6 +29,10 @@ ProcessManager::ProcessManager()
 
     m_current   = ZERO;
     m_idle      = ZERO;
+    m_switches  = 0;
+    m_tickless  = false;
+    m_tickDeadline = 0;
+    m_lastTick  = 0;
     m_interruptNotifyList.fill(ZERO);
     MemoryBlock::set(&m_nextSleepTimer, 0, sizeof(m_nextSleepTimer));
 }
@@ -92,6 +96,17 @@ void ProcessManager::remove(Process *proc, uint exitStatus)
         }
     }
 
+    // Wakeup the parent, which may sleep until any of its children terminates.
+    // Timed sleeps and waits for other processes are left untouched.
+    Process *parent = get(proc->getParent());
+
+    if (parent && parent != proc &&
+       (parent->getState() == Process::Ready ||
+       (parent->getState() == Process::Sleeping && !parent->getSleepTimer().frequency)))
+    {
+        wakeup(parent);
+    }
+
     // Unregister any interrupt events for this process
     unregisterInterruptNotify(proc);
 
@@ -144,15 +159,113 @@ ProcessManager::Result ProcessManager::schedule()
         }
     }
 
+    programTimer(proc);
+    switchTo(proc);
+    return Success;
+}
+
+ProcessManager::Result ProcessManager::handoff(Process *proc)
+{
+    if (proc->getState() != Process::Ready)
+    {
+        ERROR("process ID " << proc->getID() << " not in Ready state");
+        return InvalidArgument;
+    }
+
+    programTimer(proc);
+    switchTo(proc);
+    return Success;
+}
+
+void ProcessManager::switchTo(Process *proc)
+{
     // Only execute if its a different process
     if (proc != m_current)
     {
         Process *previous = m_current;
+
+        // Preempted processes are still Ready, others gave up the CPU
+        if (previous)
+        {
+            if (previous->getState() == Process::Ready)
+                previous->m_usage.involuntarySwitches++;
+            else
+                previous->m_usage.voluntarySwitches++;
+        }
+        m_switches++;
+        account();
+        TRACE(TraceSwitch, previous ? previous->getID() : 0, proc->getID());
         m_current = proc;
         proc->execute(previous);
     }
+}
 
-    return Success;
+void ProcessManager::programTimer(const Process *next)
+{
+    Timer *timer = Kernel::instance->getTimer();
+    const Size ready = m_scheduler.count();
+    Timer::Info now;
+
+    if (!timer)
+        return;
+
+    // Keep the periodic tick while processes compete for the core
+    if (ready > 1 || (ready == 1 && (!next || next == m_idle || next->getState() != Process::Ready)))
+    {
+        if (m_tickless)
+        {
+            timer->setPeriodic();
+            m_tickless = false;
+        }
+        return;
+    }
+
+    // Interrupt at the next sleep timer, or as late as possible
+    u32 deadline = 0, ticks = 0;
+    if (m_nextSleepTimer.frequency)
+    {
+        timer->getCurrent(&now);
+        deadline = m_nextSleepTimer.ticks + 1;
+        ticks = deadline > now.ticks ? deadline - now.ticks : 1;
+    }
+
+    if (m_tickless && m_tickDeadline == deadline)
+        return;
+
+    if (timer->setOneShot(ticks) == Timer::Success)
+    {
+        m_tickless = true;
+        m_tickDeadline = deadline;
+    }
+}
+
+void ProcessManager::tick()
+{
+    account();
+
+    // The one-shot timer expired and must be programmed again
+    m_tickDeadline = ~0U;
+}
+
+void ProcessManager::account()
+{
+    Timer *timer = Kernel::instance->getTimer();
+    Timer::Info now;
+
+    if (!timer)
+        return;
+
+    timer->getCurrent(&now);
+
+    if (m_current)
+        m_current->m_usage.ticks += now.ticks - m_lastTick;
+
+    m_lastTick = now.ticks;
+}
+
+Size ProcessManager::getSwitches() const
+{
+    return m_switches;
 }
 
 Process * ProcessManager::current()
@@ -231,6 +344,8 @@ ProcessManager::Result ProcessManager::wakeup(Process *proc)
     Process::Result result;
     Process::State state = proc->getState();
 
+    TRACE(TraceWakeup, m_current ? m_current->getID() : 0, proc->getID());
+
     if ((result = proc->wakeup()) != Process::Success)
     {
         ERROR("failed to wakeup process ID " << proc->getID() <<
@@ -245,6 +360,7 @@ ProcessManager::Result ProcessManager::wakeup(Process *proc)
             ERROR("process ID " << proc->getID() << " not added to Scheduler");
             return IOError;
         }
+        programTimer(m_current);
     }
 
     return Success;
@@ -269,6 +385,7 @@ ProcessManager::Result ProcessManager::raiseEvent(Process *proc, struct ProcessE
             ERROR("process ID " << proc->getID() << " not added to Scheduler");
             return IOError;
         }
+        programTimer(m_current);
     }
 
     return Success;
@@ -324,6 +441,10 @@ ProcessManager::Result ProcessManager::interruptNotify(u32 vector)
                 return IOError;
             }
         }
+
+        // Leave the idle process right away, instead of halting until the next tick
+        if (m_idle && m_current == m_idle && m_scheduler.count() > 0)
+            schedule();
     }
 
     return Success;
@@ -96,6 +96,14 @@ class ProcessManager
 
     /**
      * Remove a Process.
+     *
+     * Processes waiting for it are woken up with the exit status.
+     * Its parent is woken up as well, unless the parent sleeps on a timer
+     * or waits for another process, so a parent can sleep until any of
+     * its children terminates.
+     *
+     * @param proc Process to remove
+     * @param exitStatus Exit status of the process
      */
     void remove(Process *proc, uint exitStatus = 0);
 
@@ -106,6 +114,33 @@ class ProcessManager
      */
     Result schedule();
 
+    /**
+     * Switch directly to the given Process.
+     *
+     * The current Process donates the remainder of its timeslice
+     * to the given Process, without consulting the Scheduler. Used to
+     * pass control between client and server on synchronous IPC.
+     *
+     * @param proc Process pointer. Must be in the Ready state.
+     *
+     * @return Result code
+     */
+    Result handoff(Process *proc);
+
+    /**
+     * Called on every timer interrupt.
+     *
+     * Accounts the ticks of the current slice to the current Process.
+     */
+    void tick();
+
+    /**
+     * Get the number of context switches since boot.
+     *
+     * @return Number of context switches.
+     */
+    Size getSwitches() const;
+
     /**
      * Let current Process wait for another Process to terminate.
      *
@@ -166,6 +201,8 @@ class ProcessManager
     /**
      * Raise interrupt notifications for a interrupt vector
      *
+     * Switches away from the idle process if a notified process became ready.
+     *
      * @param vector Interrupt vector
      *
      * @return Result code
@@ -191,6 +228,31 @@ class ProcessManager
      */
     Vector<Process *> * getProcessTable();
 
+  private:
+
+    /**
+     * Perform a context switch to the given Process.
+     *
+     * @param proc Process pointer
+     */
+    void switchTo(Process *proc);
+
+    /**
+     * Account the timer ticks since the last switch or tick to the current Process.
+     */
+    void account();
+
+    /**
+     * Program the Timer for the next Process to run.
+     *
+     * The periodic tick is only needed when multiple processes compete
+     * for the core. Otherwise the timer is programmed once for the next
+     * sleep timer to expire, or stopped as long as the timer allows.
+     *
+     * @param next Process which runs next
+     */
+    void programTimer(const Process *next);
+
   private:
 
     /** All known Processes. */
@@ -208,6 +270,18 @@ class ProcessManager
     /** Next timer */
     Timer::Info m_nextSleepTimer;
 
+    /** True if the timer is programmed as one-shot */
+    bool m_tickless;
+
+    /** Timer tick at which the one-shot timer expires */
+    u32 m_tickDeadline;
+
+    /** Timer tick value at the previous switch or tick */
+    u32 m_lastTick;
+
+    /** Number of context switches done */
+    Size m_switches;
+
     /** Interrupt notification list */
     Vector<List<Process *> *> m_interruptNotifyList;
 };
@@ -23,6 +23,8 @@
 #include "ProcessEvent.h"
 
 ProcessShares::ProcessShares(ProcessID pid)
+    : m_shares(ShareTableSize)
+    , m_peers(PeerTableSize)
 {
     m_pid    = pid;
     m_memory = ZERO;
@@ -32,25 +34,15 @@ ProcessShares::ProcessShares(ProcessID pid)
 ProcessShares::~ProcessShares()
 {
     ProcessManager *procs = Kernel::instance->getProcessManager();
-    List<ProcessID> pids;
+    const List<ProcessID> pids = m_peers.keys();
+    const List<MemoryShare *> shares = m_shares.values();
 
     // Cleanup members
     delete m_kernelChannel;
 
-    // Make a list of unique process IDs which
-    // have a share with this Process
-    Size size = m_shares.size();
-    for (Size i = 0; i < size; i++)
-    {
-        MemoryShare *sh = (MemoryShare *) m_shares.get(i);
-        if (sh)
-        {
-            if (!pids.contains(sh->pid))
-                pids.append(sh->pid);
-
-            releaseShare(sh, i);
-        }
-    }
+    // Release all shares
+    for (ListIterator<MemoryShare *> i(shares); i.hasCurrent(); i++)
+        releaseShare(i.current());
 
     // Raise process terminated events
     for (ListIterator<ProcessID> i(pids); i.hasCurrent(); i++)
@@ -90,10 +82,19 @@ ProcessShares::Result ProcessShares::createShare(ProcessID pid,
                                                  Size size)
 {
     MemoryShare *share = ZERO;
+    ShareKey key;
 
     if (size == 0 || size % PAGESIZE)
         return InvalidArgument;
 
+    // Check if the share already exists
+    key.pid    = pid;
+    key.coreId = coreId;
+    key.tagId  = tagId;
+
+    if (m_shares.get(key))
+        return AlreadyExists;
+
     // Allocate MemoryShare objects
     share  = new MemoryShare;
     if (!share)
@@ -111,8 +112,8 @@ ProcessShares::Result ProcessShares::createShare(ProcessID pid,
     m_memory->lookup(share->range.virt, &share->range.phys);
     m_memory->access(share->range.virt, &share->range.access);
 
-    // insert into shares list
-    m_shares.insert(*share);
+    // insert into shares table
+    insertShare(share);
     return Success;
 }
 
@@ -202,9 +203,9 @@ ProcessShares::Result ProcessShares::createShare(ProcessShares & instance,
         delete remoteShare;
         return OutOfMemory;
     }
-    // insert into shares list
-    m_shares.insert(*localShare);
-    instance.m_shares.insert(*remoteShare);
+    // insert into shares tables
+    insertShare(localShare);
+    instance.insertShare(remoteShare);
 
     // raise event on the remote process
     ProcessManager *procs = Kernel::instance->getProcessManager();
@@ -222,24 +223,30 @@ ProcessShares::Result ProcessShares::createShare(ProcessShares & instance,
 
 ProcessShares::Result ProcessShares::removeShares(ProcessID pid)
 {
-    Size size = m_shares.size();
-    MemoryShare *s = 0;
+    const List<MemoryShare *> shares = m_peers.values(pid);
 
-    for (Size i = 0; i < size; i++)
-    {
-        if ((s = (MemoryShare *) m_shares.get(i)) != ZERO)
-        {
-            if (s->pid != pid)
-                continue;
+    for (ListIterator<MemoryShare *> i(shares); i.hasCurrent(); i++)
+        releaseShare(i.current());
 
-            releaseShare(s, i);
-        }
-    }
     return Success;
 }
 
-ProcessShares::Result ProcessShares::releaseShare(MemoryShare *s, Size idx)
+void ProcessShares::insertShare(MemoryShare *share)
 {
+    ShareKey key;
+
+    key.pid    = share->pid;
+    key.coreId = share->coreId;
+    key.tagId  = share->tagId;
+
+    m_shares.insert(key, share);
+    m_peers.append(share->pid, share);
+}
+
+ProcessShares::Result ProcessShares::releaseShare(MemoryShare *s)
+{
+    ShareKey key;
+
     // Only release physical memory if both processes have detached.
     // Note that in case all memory shares for a certain ProcessID have
     // been detached but not yet released, and due to a very unlikely race
@@ -253,17 +260,13 @@ ProcessShares::Result ProcessShares::releaseShare(MemoryShare *s, Size idx)
         if (proc)
         {
             ProcessShares & shares = proc->getShares();
-            Size size = shares.m_shares.size();
+            const List<MemoryShare *> peer = shares.m_peers.values(m_pid);
 
             // Mark all process shares detached in the other process
-            for (Size i = 0; i < size; i++)
+            for (ListIterator<MemoryShare *> i(peer); i.hasCurrent(); i++)
             {
-                MemoryShare *otherShare = (MemoryShare *) shares.m_shares.get(i);
-                if (otherShare && otherShare->pid == m_pid
-                               && otherShare->coreId == s->coreId)
-                {
-                    otherShare->attached = false;
-                }
+                if (i.current()->coreId == s->coreId)
+                    i.current()->attached = false;
             }
         }
     }
@@ -271,37 +274,33 @@ ProcessShares::Result ProcessShares::releaseShare(MemoryShare *s, Size idx)
     {
         // Only release physical memory pages if the other
         // process already detached earlier
-        Allocator *alloc = Kernel::instance->getAllocator();
-
-        for (Size i = 0; i < s->range.size; i += PAGESIZE)
-            alloc->release(s->range.phys + i);
+        Kernel::instance->getAllocator()->release(s->range.phys, s->range.size);
     }
     // Unmap the share
     m_memory->unmapRange(&s->range);
 
     // Remove share from our administration
-    m_shares.remove(idx);
+    key.pid    = s->pid;
+    key.coreId = s->coreId;
+    key.tagId  = s->tagId;
+    m_shares.remove(key);
+    m_peers.remove(s->pid, s);
     delete s;
     return Success;
 }
 
 ProcessShares::Result ProcessShares::readShare(MemoryShare *share)
 {
-    Size size = m_shares.size();
-    const MemoryShare *s = 0;
+    MemoryShare * const *s;
+    ShareKey key;
 
-    for (Size i = 0; i < size; i++)
-    {
-        if ((s = m_shares.get(i)) != ZERO)
-        {
-            if (s->pid == share->pid &&
-                s->coreId == share->coreId &&
-                s->tagId == share->tagId)
-            {
-                MemoryBlock::copy(share, s, sizeof(MemoryShare));
-                return Success;
-            }
-        }
-    }
-    return NotFound;
+    key.pid    = share->pid;
+    key.coreId = share->coreId;
+    key.tagId  = share->tagId;
+
+    if ((s = m_shares.get(key)) == ZERO)
+        return NotFound;
+
+    MemoryBlock::copy(share, *s, sizeof(MemoryShare));
+    return Success;
 }
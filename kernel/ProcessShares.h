@@ -22,7 +22,7 @@
 #include <Macros.h>
 #include <List.h>
 #include <MemoryMap.h>
-#include <Index.h>
+#include <HashTable.h>
 #include <MemoryContext.h>
 
 class MemoryChannel;
@@ -68,6 +68,37 @@ class ProcessShares
     }
     MemoryShare;
 
+    /**
+     * Lookup key of a MemoryShare.
+     */
+    typedef struct ShareKey
+    {
+        /** Remote process id */
+        ProcessID pid;
+
+        /** CoreId for the other process */
+        Size coreId;
+
+        /** Share tag id */
+        Size tagId;
+
+        bool operator == (const struct ShareKey & key) const
+        {
+            return pid == key.pid && coreId == key.coreId && tagId == key.tagId;
+        }
+        bool operator != (const struct ShareKey & key) const
+        {
+            return !(*this == key);
+        }
+    }
+    ShareKey;
+
+    /** Initial number of buckets in the share lookup table. It grows with the shares. */
+    static const Size ShareTableSize = 4;
+
+    /** Initial number of buckets in the per-peer table. It grows with the shares. */
+    static const Size PeerTableSize = 4;
+
     enum Result
     {
         Success,
@@ -152,15 +183,21 @@ class ProcessShares
 
   private:
 
+    /**
+     * Add a memory share to the lookup tables
+     *
+     * @param share MemoryShare object pointer
+     */
+    void insertShare(MemoryShare *share);
+
     /**
      * Release one memory share
      *
      * @param share MemoryShare object pointer
-     * @param idx Index position of the object
      *
      * @return Result code
      */
-    Result releaseShare(MemoryShare *share, Size idx);
+    Result releaseShare(MemoryShare *share);
 
   private:
 
@@ -173,10 +210,26 @@ class ProcessShares
     /** Memory channel for sending kernel events to the associated Process */
     MemoryChannel *m_kernelChannel;
 
-    /** Contains all memory shares */
-    Index<MemoryShare> m_shares;
+    /** Contains all memory shares, indexed by (pid, coreId, tagId) */
+    HashTable<ShareKey, MemoryShare *> m_shares;
+
+    /** Contains all memory shares, grouped by remote ProcessID */
+    HashTable<ProcessID, MemoryShare *> m_peers;
 };
 
+/**
+ * Compute a hash for a ProcessShares::ShareKey.
+ *
+ * @param key Share key to hash.
+ * @param mod Modulo value to apply.
+ *
+ * @return Computed hash.
+ */
+inline Size hash(const ProcessShares::ShareKey & key, Size mod)
+{
+    return ((((Size) key.pid * 31) + key.coreId) * 31 + key.tagId) % mod;
+}
+
 /**
  * @}
  */
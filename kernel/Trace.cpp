@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <MemoryBlock.h>
+#include "Trace.h"
+
+Trace::Trace()
+{
+    m_mask    = 0;
+    m_head    = 0;
+    m_count   = 0;
+    m_dropped = 0;
+    m_events  = new TraceEvent[MaxEvents];
+}
+
+Trace::~Trace()
+{
+    delete[] m_events;
+}
+
+void Trace::setMask(u32 mask)
+{
+    m_mask = mask & TRACE_MASK;
+}
+
+Size Trace::getDropped() const
+{
+    return m_dropped;
+}
+
+void Trace::record(uint type, ProcessID pid, u32 arg)
+{
+    TraceEvent *ev;
+
+    // Overwrite the oldest event if the ring is full
+    if (m_count == MaxEvents)
+    {
+        ev = &m_events[m_head];
+        m_head = (m_head + 1) % MaxEvents;
+        m_dropped++;
+    }
+    else
+        ev = &m_events[(m_head + m_count++) % MaxEvents];
+
+    ev->timestamp = timestamp();
+    ev->type      = type;
+    ev->pid       = pid;
+    ev->arg       = arg;
+}
+
+Size Trace::drain(TraceEvent *events, Size count)
+{
+    Size num = 0;
+
+    while (num < count && m_count > 0)
+    {
+        MemoryBlock::copy(&events[num++], &m_events[m_head], sizeof(TraceEvent));
+        m_head = (m_head + 1) % MaxEvents;
+        m_count--;
+    }
+    return num;
+}
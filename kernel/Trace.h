@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __KERNEL_TRACE_H
+#define __KERNEL_TRACE_H
+
+#include <FreeNOS/Config.h>
+#include <Types.h>
+#include <Macros.h>
+#include "TraceEvent.h"
+
+/**
+ * @addtogroup kernel
+ * @{
+ */
+
+/**
+ * Compile-time trace mask. Event types not in this mask
+ * are removed from the kernel entirely by the compiler.
+ */
+#ifndef TRACE_MASK
+#define TRACE_MASK TRACE_ALL
+#endif
+
+/**
+ * Record a kernel trace event.
+ *
+ * Costs a single branch when the event type is disabled at run-time.
+ *
+ * @param type TraceEventType to record
+ * @param pid Process ID which is current
+ * @param arg Event specific argument
+ */
+#define TRACE(type, pid, arg) \
+    do { \
+        if ((TRACE_MASK & TRACE_BIT(type)) && \
+            (Kernel::instance->getTrace()->getMask() & TRACE_BIT(type))) \
+            Kernel::instance->getTrace()->record(type, pid, arg); \
+    } while (0)
+
+/**
+ * Binary ring buffer of kernel trace events.
+ *
+ * Each core runs its own kernel and thus records its own trace.
+ * When the ring is full the oldest events are overwritten.
+ */
+class Trace
+{
+  public:
+
+    /** Number of events in the ring */
+    static const Size MaxEvents = 1024;
+
+  public:
+
+    /**
+     * Constructor.
+     */
+    Trace();
+
+    /**
+     * Destructor.
+     */
+    ~Trace();
+
+    /**
+     * Get the run-time trace mask.
+     *
+     * @return Bitmask of enabled TraceEventTypes.
+     */
+    inline u32 getMask() const
+    {
+        return m_mask;
+    }
+
+    /**
+     * Set the run-time trace mask.
+     *
+     * @param mask Bitmask of enabled TraceEventTypes.
+     */
+    void setMask(u32 mask);
+
+    /**
+     * Get the number of events lost because the ring was full.
+     *
+     * @return Number of overwritten events.
+     */
+    Size getDropped() const;
+
+    /**
+     * Record an event.
+     *
+     * @param type TraceEventType of the event
+     * @param pid Current process ID
+     * @param arg Event specific argument
+     */
+    void record(uint type, ProcessID pid, u32 arg);
+
+    /**
+     * Remove events from the ring.
+     *
+     * @param events Output array of events
+     * @param count Maximum number of events to output
+     *
+     * @return Number of events removed
+     */
+    Size drain(TraceEvent *events, Size count);
+
+  private:
+
+    /** Run-time mask of enabled event types */
+    u32 m_mask;
+
+    /** Ring of events */
+    TraceEvent *m_events;
+
+    /** Index of the oldest event */
+    Size m_head;
+
+    /** Number of events in the ring */
+    Size m_count;
+
+    /** Number of overwritten events */
+    Size m_dropped;
+};
+
+/**
+ * @}
+ */
+
+#endif /* __KERNEL_TRACE_H */
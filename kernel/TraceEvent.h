@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __KERNEL_TRACEEVENT_H
+#define __KERNEL_TRACEEVENT_H
+
+#include <Types.h>
+
+/**
+ * @addtogroup kernel
+ * @{
+ */
+
+/**
+ * Types of events recorded in the kernel trace.
+ */
+enum TraceEventType
+{
+    TraceSwitch = 0,
+    TraceSystemCallEnter,
+    TraceSystemCallExit,
+    TraceInterrupt,
+    TraceResume,
+    TraceWakeup,
+    TracePageMap,
+    TraceEventTypes
+};
+
+/** Convert a TraceEventType to its bit in a trace mask */
+#define TRACE_BIT(type) (1 << (type))
+
+/** Trace mask which enables all event types */
+#define TRACE_ALL ((1 << TraceEventTypes) - 1)
+
+/**
+ * Binary kernel trace event.
+ *
+ * The layout is fixed so that a drained trace can be decoded on the host.
+ */
+typedef struct TraceEvent
+{
+    /** Timestamp counter value when the event was recorded */
+    u64 timestamp;
+
+    /** Event type, see TraceEventType */
+    u16 type;
+
+    /** Process ID which was current when the event was recorded */
+    u16 pid;
+
+    /**
+     * Event specific argument.
+     *
+     * Next process ID for TraceSwitch, API number for TraceSystemCallEnter,
+     * result for TraceSystemCallExit, vector for TraceInterrupt,
+     * target process ID for TraceResume and TraceWakeup and
+     * virtual address for TracePageMap.
+     */
+    u32 arg;
+}
+TraceEvent;
+
+/**
+ * @}
+ */
+
+#endif /* __KERNEL_TRACEEVENT_H */
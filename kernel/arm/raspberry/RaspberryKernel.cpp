@@ -89,6 +89,7 @@ void RaspberryKernel::interrupt(volatile CPUState state)
     if (tick)
     {
         kernel->m_timer->tick();
+        kernel->getProcessManager()->tick();
         kernel->getProcessManager()->schedule();
     }
 
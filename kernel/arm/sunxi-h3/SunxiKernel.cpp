@@ -72,6 +72,7 @@ void SunxiKernel::interrupt(volatile CPUState state)
     if (tick)
     {
         kernel->m_timer->tick();
+        kernel->getProcessManager()->tick();
         kernel->getProcessManager()->schedule();
     }
 
@@ -31,7 +31,37 @@
 
 extern C void executeInterrupt(CPUState state)
 {
-    Kernel::instance->executeIntVector(state.vector, &state);
+    switch (state.vector)
+    {
+        // System calls bypass the generic interrupt dispatch
+        case IntelKernel::SyscallVector:
+            IntelKernel::trap(&state, 0, state.vector);
+            break;
+
+        // First FPU instruction after a context switch
+        case INTEL_DEVERR:
+            IntelKernel::fpuTrap(&state, 0, state.vector);
+            break;
+
+        default:
+            Kernel::instance->executeIntVector(state.vector, &state);
+            break;
+    }
+}
+
+extern C ulong executeSystemCall(SystemCallState *state)
+{
+    API *api = Kernel::instance->getAPI();
+    const API::Number number = (API::Number) state->number;
+    API::Handler *handler = api->getHandler(number);
+
+    state->privileged = Kernel::instance->getProcessManager()->current()->isPrivileged();
+
+    // Only register arguments: no CPUState is saved or decoded
+    if (!handler)
+        return API::InvalidArgument;
+
+    return api->execute(number, handler, state->arg1, state->arg2, state->arg3, state->arg4, 0);
 }
 
 IntelKernel::IntelKernel(CoreInfo *info)
@@ -54,14 +84,10 @@ IntelKernel::IntelKernel(CoreInfo *info)
         hookIntVector(i, exception, 0);
     }
     // Setup IRQ handlers
-    for (int i = 17; i < 256; i++)
+    for (int i = 17; i < INTERRUPT_VECTORS; i++)
     {
-        // Trap gate
-        if (i == 0x90)
-            hookIntVector(0x90, trap, 0);
-
-        // Hardware Interrupt
-        else
+        // Trap gate is dispatched directly by executeInterrupt()
+        if (i != SyscallVector)
             hookIntVector(i, interrupt, 0);
     }
 
@@ -128,6 +154,33 @@ IntelKernel::IntelKernel(CoreInfo *info)
     kernelTss.esp0   = 0;
     kernelTss.bitmap = sizeof(TSS);
     ltr(KERNEL_TSS_SEL);
+
+    // Enable the SYSENTER system call entry, if supported
+    u32 eax, ebx, ecx, edx;
+    core.cpuid(1, &eax, &ebx, &ecx, &edx);
+
+    if (edx & IntelCore::FeatureSEP)
+    {
+        systemCallRun = ::executeSystemCall;
+        core.writeMSR(IntelCore::SysenterCS,  KERNEL_CS_SEL);
+        core.writeMSR(IntelCore::SysenterESP, (Address) &kernelTss.esp0);
+        core.writeMSR(IntelCore::SysenterEIP, (Address) sysenterHandler);
+    }
+
+    // Keep global kernel mappings in the TLB when switching page directories
+    if (edx & IntelCore::FeaturePGE)
+        core.writeCR4(core.readCR4() | CR4_PGE);
+
+    // Enable the FPU and SSE registers. They are saved lazily: CR0.TS
+    // makes the first FPU instruction after a context switch trap.
+    m_fpuOwner = ZERO;
+    m_fpuTrap  = true;
+    m_fpuSSE   = (edx & IntelCore::FeatureFXSR) != 0;
+
+    if (m_fpuSSE)
+        core.writeCR4(core.readCR4() | CR4_OSFXSR | CR4_OSXMMEXCPT);
+
+    core.writeCR0((core.readCR0() & ~CR0_EM) | CR0_MP | CR0_NE | CR0_TS);
 }
 
 void IntelKernel::enableIRQ(u32 irq, bool enabled)
@@ -145,6 +198,18 @@ void IntelKernel::enableIRQ(u32 irq, bool enabled)
     Kernel::enableIRQ(irq, enabled);
 }
 
+IntelKernel::Result IntelKernel::sendIRQ(const uint coreId, const uint irq)
+{
+    IntController::Result r = m_apic.send(coreId, irq);
+    if (r != IntController::Success)
+    {
+        ERROR("failed to send IPI to core" << coreId << ": " << (uint) r);
+        return IOError;
+    }
+
+    return Success;
+}
+
 void IntelKernel::exception(CPUState *state, ulong param, ulong vector)
 {
     IntelCore core;
@@ -164,9 +229,14 @@ void IntelKernel::interrupt(CPUState *state, ulong param, ulong vector)
 
     if (kern->m_intControl)
     {
-        kern->m_intControl->clear(
-            state->vector - kern->m_intControl->getBase()
-        );
+        // Interrupts outside the range of the PIC, such as IPIs,
+        // are delivered by the local APIC and need its end-of-interrupt
+        if (kern->m_intControl->clear(
+                state->vector - kern->m_intControl->getBase()
+            ) != IntController::Success)
+        {
+            kern->m_apic.clear(state->vector);
+        }
     }
 }
 
@@ -182,6 +252,63 @@ void IntelKernel::trap(CPUState *state, ulong param, ulong vector)
     );
 }
 
+void IntelKernel::fpuTrap(CPUState *state, ulong param, ulong vector)
+{
+    IntelKernel *kern = (IntelKernel *) Kernel::instance;
+    ProcessManager *procs = kern->getProcessManager();
+    IntelProcess *proc = (IntelProcess *) procs->current();
+    IntelCore core;
+
+    core.clearTaskSwitched();
+    kern->m_fpuTrap = false;
+
+    if (kern->m_fpuOwner == proc)
+        return;
+
+    // Save registers of the previous owner
+    if (kern->m_fpuOwner)
+        core.saveFPU(kern->m_fpuOwner->getFPUState(), kern->m_fpuSSE);
+
+    // Load registers of the current process
+    if (proc->getFPUState())
+        core.restoreFPU(proc->getFPUState(), kern->m_fpuSSE);
+    else if (proc->allocateFPUState() == Process::Success)
+        core.initFPU(kern->m_fpuSSE);
+    else
+    {
+        ERROR("no FPU state for Process: " << proc->getID());
+        kern->m_fpuOwner = ZERO;
+        procs->remove(proc);
+        procs->schedule();
+        return;
+    }
+
+    kern->m_fpuOwner = proc;
+}
+
+void IntelKernel::switchFPU(IntelProcess *proc)
+{
+    const bool trap = proc != m_fpuOwner;
+
+    if (trap != m_fpuTrap)
+    {
+        IntelCore core;
+
+        if (trap)
+            core.writeCR0(core.readCR0() | CR0_TS);
+        else
+            core.clearTaskSwitched();
+
+        m_fpuTrap = trap;
+    }
+}
+
+void IntelKernel::releaseFPU(IntelProcess *proc)
+{
+    if (m_fpuOwner == proc)
+        m_fpuOwner = ZERO;
+}
+
 void IntelKernel::clocktick(CPUState *state, ulong param, ulong vector)
 {
     IntelKernel *kern = (IntelKernel *) Kernel::instance;
@@ -194,5 +321,6 @@ void IntelKernel::clocktick(CPUState *state, ulong param, ulong vector)
         kern->m_apic.clear(irq);
 
     kern->m_timer->tick();
+    kern->getProcessManager()->tick();
     kern->getProcessManager()->schedule();
 }
@@ -35,10 +35,70 @@
  * Intel specific software interrupts.
  * These functions are called by the user program to
  * invoke the kernel APIs, also known as system calls.
+ * Calls with up to four arguments use SYSENTER when available.
  *
  * @{
  */
 
+/**
+ * Perform a kernel trap with 4 arguments using SYSENTER.
+ *
+ * Faster than the software interrupt, but only passes register arguments.
+ * Only use it when sysenterEnabled() returns true.
+ *
+ * @param num Unique number of the handler to execute.
+ * @param arg1 First argument becomes EBX.
+ * @param arg2 Second argument becomes ESI.
+ * @param arg3 Third argument becomes EDI.
+ * @param arg4 Fourth argument becomes EBP.
+ *
+ * @return An integer.
+ */
+inline ulong sysenterKernel4(ulong num, ulong arg1, ulong arg2, ulong arg3,
+                             ulong arg4)
+{
+    ulong ret, sp;
+    asm volatile ("push %%ebp\n"
+                  "mov %%ecx, %%ebp\n"
+                  "mov %%esp, %%ecx\n"
+                  "movl $1f, %%edx\n"
+                  "sysenter\n"
+                  "1: pop %%ebp\n"
+                  : "=a"(ret), "=c"(sp) : "a"(num), "b"(arg1), "S"(arg2),
+                    "D"(arg3), "1"(arg4) : "edx", "cc", "memory");
+    return ret;
+}
+
+/**
+ * Check if system calls may enter the kernel with SYSENTER.
+ *
+ * Requires SEP support as reported by CPUID. The first Pentium Pro
+ * models report SEP without supporting it. SYSEXIT always returns
+ * to ring 3, so privileged programs keep using the software interrupt.
+ * The result is computed on the first call only.
+ *
+ * @return True if SYSENTER may be used.
+ */
+inline bool sysenterEnabled()
+{
+    static int enabled = -1;
+
+    if (enabled == -1)
+    {
+        ulong eax, ebx, ecx, edx, cs;
+        asm volatile ("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(1), "c"(0));
+        asm volatile ("mov %%cs, %0" : "=r"(cs));
+
+        const ulong family   = (eax >> 8) & 0xf;
+        const ulong model    = (eax >> 4) & 0xf;
+        const ulong stepping = eax & 0xf;
+
+        enabled = (edx & (1 << 11)) && (cs & 3) == 3 &&
+                  !(family == 6 && model < 3 && stepping < 3);
+    }
+    return enabled;
+}
+
 /**
  * Perform a kernel trap with 1 argument.
  *
@@ -50,6 +110,10 @@
 inline ulong trapKernel1(ulong num, ulong arg1)
 {
     ulong ret;
+
+    if (sysenterEnabled())
+        return sysenterKernel4(num, arg1, 0, 0, 0);
+
     asm volatile ("int $0x90" : "=a"(ret) : "a"(num), "c"(arg1) : "memory");
     return ret;
 }
@@ -66,6 +130,10 @@ inline ulong trapKernel1(ulong num, ulong arg1)
 inline ulong trapKernel2(ulong num, ulong arg1, ulong arg2)
 {
     ulong ret;
+
+    if (sysenterEnabled())
+        return sysenterKernel4(num, arg1, arg2, 0, 0);
+
     asm volatile ("int $0x90" : "=a"(ret) : "a"(num), "c"(arg1), "b"(arg2) : "memory");
     return ret;
 }
@@ -83,6 +151,10 @@ inline ulong trapKernel2(ulong num, ulong arg1, ulong arg2)
 inline ulong trapKernel3(ulong num, ulong arg1, ulong arg2, ulong arg3)
 {
     ulong ret;
+
+    if (sysenterEnabled())
+        return sysenterKernel4(num, arg1, arg2, arg3, 0);
+
     asm volatile ("int $0x90" : "=a"(ret) : "a"(num), "c"(arg1), "b"(arg2),
                         "d"(arg3) : "memory");
     return ret;
@@ -103,6 +175,10 @@ inline ulong trapKernel4(ulong num, ulong arg1, ulong arg2, ulong arg3,
              ulong arg4)
 {
     ulong ret;
+
+    if (sysenterEnabled())
+        return sysenterKernel4(num, arg1, arg2, arg3, arg4);
+
     asm volatile ("int $0x90" : "=a"(ret) : "a"(num), "c"(arg1), "b"(arg2),
                         "d"(arg3), "S"(arg4) : "memory");
     return ret;
@@ -141,6 +217,8 @@ inline ulong trapKernel5(ulong num, ulong arg1, ulong arg2, ulong arg3,
 #include <intel/IntelAPIC.h>
 #include <Timer.h>
 
+class IntelProcess;
+
 /**
  * @addtogroup kernel
  * @{
@@ -156,6 +234,9 @@ class IntelKernel : public Kernel
 {
   public:
 
+    /** Interrupt vector used for system calls */
+    static const u32 SyscallVector = 0x90;
+
     /**
      * Constructor function.
      */
@@ -169,34 +250,76 @@ class IntelKernel : public Kernel
      */
     virtual void enableIRQ(u32 irq, bool enabled);
 
-  private:
+    /**
+     * Send a inter-processor-interrupt (IPI) to another core.
+     *
+     * The PIC on core0 cannot send IPIs, therefore this
+     * function always uses the local APIC.
+     *
+     * @param coreId Target core to send the IRQ to
+     * @param irq Interrupt number to send
+     *
+     * @return Result code
+     */
+    virtual Result sendIRQ(const uint coreId, const uint irq);
 
     /**
-     * Called when the CPU detects a fault.
+     * Kernel trap handler (system calls).
+     *
+     * @param state Contains the arguments for the APIHandler, in CPU registers.
+     * @param param Not used.
+     * @param vector Not used.
+     */
+    static void trap(CPUState *state, ulong param, ulong vector);
+
+    /**
+     * Device Not Available handler (lazy FPU switching).
+     *
+     * Saves the FPU registers of the previous owner and loads
+     * the FPU registers of the current Process.
      *
      * @param state Contains CPU registers, interrupt vector and error code.
      * @param param Not used.
      * @param vector Not used.
      */
-    static void exception(CPUState *state, ulong param, ulong vector);
+    static void fpuTrap(CPUState *state, ulong param, ulong vector);
 
     /**
-     * Default interrupt handler.
+     * Prepare the FPU for executing the given Process.
+     *
+     * Sets CR0.TS if another Process owns the FPU registers,
+     * such that the first FPU instruction raises fpuTrap().
+     *
+     * @param proc Process which is about to execute.
+     */
+    void switchFPU(IntelProcess *proc);
+
+    /**
+     * Release FPU ownership of a Process.
+     *
+     * @param proc Process which is about to be destroyed.
+     */
+    void releaseFPU(IntelProcess *proc);
+
+  private:
+
+    /**
+     * Called when the CPU detects a fault.
      *
      * @param state Contains CPU registers, interrupt vector and error code.
      * @param param Not used.
      * @param vector Not used.
      */
-    static void interrupt(CPUState *state, ulong param, ulong vector);
+    static void exception(CPUState *state, ulong param, ulong vector);
 
     /**
-     * Kernel trap handler (system calls).
+     * Default interrupt handler.
      *
-     * @param state Contains the arguments for the APIHandler, in CPU registers.
+     * @param state Contains CPU registers, interrupt vector and error code.
      * @param param Not used.
      * @param vector Not used.
      */
-    static void trap(CPUState *state, ulong param, ulong vector);
+    static void interrupt(CPUState *state, ulong param, ulong vector);
 
     /**
      * i8253 system clock interrupt handler.
@@ -217,6 +340,15 @@ class IntelKernel : public Kernel
 
     /** PIC instance */
     IntelPIC m_pic;
+
+    /** Process which has its registers loaded in the FPU, or ZERO */
+    IntelProcess *m_fpuOwner;
+
+    /** True if CR0.TS is set */
+    bool m_fpuTrap;
+
+    /** True if SSE registers are saved with FXSAVE */
+    bool m_fpuSSE;
 };
 
 /**
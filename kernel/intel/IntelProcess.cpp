@@ -25,6 +25,8 @@
 IntelProcess::IntelProcess(ProcessID id, Address entry, bool privileged, const MemoryMap &map)
     : Process(id, entry, privileged, map)
 {
+    m_fpuMemory = ZERO;
+    m_fpuState  = ZERO;
 }
 
 Process::Result IntelProcess::initialize()
@@ -118,6 +120,10 @@ Process::Result IntelProcess::initialize()
 
 IntelProcess::~IntelProcess()
 {
+    // Drop FPU ownership before the state is released
+    ((IntelKernel *) Kernel::instance)->releaseFPU(this);
+    delete[] m_fpuMemory;
+
     // Release the kernel stack memory page
     SplitAllocator *alloc = Kernel::instance->getAllocator();
     alloc->release((Address)alloc->toPhysical(m_kernelStackBase) - KernelStackSize);
@@ -130,6 +136,9 @@ void IntelProcess::execute(Process *previous)
     // Reload Task State Register (with kernel stack for interrupts)
     kernelTss.esp0 = m_kernelStackBase;
 
+    // Trap on FPU usage if another process owns the FPU registers
+    ((IntelKernel *) Kernel::instance)->switchFPU(this);
+
     // Activate the memory context of this process
     m_memoryContext->activate();
 
@@ -137,3 +146,28 @@ void IntelProcess::execute(Process *previous)
     switchCoreState( p ? &p->m_kernelStack : ZERO,
                      m_kernelStack );
 }
+
+u8 * IntelProcess::getFPUState()
+{
+    return m_fpuState;
+}
+
+Process::Result IntelProcess::allocateFPUState()
+{
+    if (m_fpuState)
+        return Success;
+
+    m_fpuMemory = new u8[IntelCore::FPUStateSize + IntelCore::FPUStateAlign];
+    if (!m_fpuMemory)
+    {
+        ERROR("failed to allocate FPU state");
+        return OutOfMemory;
+    }
+
+    Address addr = (Address) m_fpuMemory;
+    addr += IntelCore::FPUStateAlign - (addr % IntelCore::FPUStateAlign);
+    m_fpuState = (u8 *) addr;
+    MemoryBlock::set(m_fpuState, 0, IntelCore::FPUStateSize);
+    return Success;
+}
+
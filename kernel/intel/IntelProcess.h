@@ -73,6 +73,22 @@ class IntelProcess : public Process
      */
     virtual void execute(Process *previous);
 
+    /**
+     * Get the saved FPU and SSE registers.
+     *
+     * @return Aligned FXSAVE area or ZERO if the Process never used the FPU.
+     */
+    u8 * getFPUState();
+
+    /**
+     * Allocate the area for saving FPU and SSE registers.
+     *
+     * Only called when the Process uses the FPU for the first time.
+     *
+     * @return Result code
+     */
+    Result allocateFPUState();
+
   private:
 
     /** Current kernel stack address (changes during execution). */
@@ -81,6 +97,12 @@ class IntelProcess : public Process
     /** Base kernel stack (fixed) */
     Address m_kernelStackBase;
 
+    /** Allocated memory for the FPU state, or ZERO if not used */
+    u8 *m_fpuMemory;
+
+    /** Aligned FXSAVE area inside m_fpuMemory */
+    u8 *m_fpuState;
+
 };
 
 namespace Arch
@@ -90,3 +90,15 @@ Allocator::Result BitAllocator::release(const Address addr)
     m_array.unset((addr - base()) / m_chunkSize);
     return Success;
 }
+
+Allocator::Result BitAllocator::release(const Address addr, const Size size)
+{
+    if (addr < base() || size == 0)
+        return InvalidAddress;
+
+    const Size first = (addr - base()) / m_chunkSize;
+    const Size last  = (addr - base() + size - 1) / m_chunkSize;
+
+    m_array.unsetRange(first, last);
+    return Success;
+}
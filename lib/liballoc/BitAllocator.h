@@ -111,6 +111,16 @@ class BitAllocator : public Allocator
      */
     virtual Result release(const Address chunk);
 
+    /**
+     * Release a range of memory chunks.
+     *
+     * @param addr First memory chunk to release.
+     * @param size Number of bytes to release.
+     *
+     * @return Result value.
+     */
+    Result release(const Address addr, const Size size);
+
   private:
 
     /** Marks which chunks are (un)used. */
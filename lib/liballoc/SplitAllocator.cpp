@@ -62,6 +62,11 @@ Allocator::Result SplitAllocator::release(const Address addr)
     return m_alloc.release(addr);
 }
 
+Allocator::Result SplitAllocator::release(const Address addr, const Size size)
+{
+    return m_alloc.release(addr, size);
+}
+
 Address SplitAllocator::toVirtual(const Address phys) const
 {
     const Size mappingDiff = base() - m_virtRange.address;
@@ -98,6 +98,16 @@ class SplitAllocator : public Allocator
      */
     virtual Result release(const Address addr);
 
+    /**
+     * Release a range of memory pages.
+     *
+     * @param addr Physical memory address of the first page to release.
+     * @param size Number of bytes to release.
+     *
+     * @return Result value.
+     */
+    Result release(const Address addr, const Size size);
+
     /**
      * Convert Address to virtual pointer.
      *
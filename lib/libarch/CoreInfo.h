@@ -29,7 +29,7 @@
 #define KERNEL_PATHLEN 64
 
 /** Needed by IntelBoot16.S. Depends on sizeof(Memory::Access) which is an emum */
-#define COREINFO_SIZE  (KERNEL_PATHLEN + (8 * 4) + (4 * 4) + (4 * 4))
+#define COREINFO_SIZE  (KERNEL_PATHLEN + (12 * 4) + (4 * 4) + (4 * 4))
 
 /**
  * @}
@@ -98,6 +98,16 @@ typedef struct CoreInfo
     /** Arch-specific timer counter */
     uint timerCounter;
 
+    /**
+     * Bytes of memory owned by the core at boot, starting at memory.phys.
+     * The rest of the memory range is granted on demand by the page broker
+     * on core0. Zero if the core owns the full memory range.
+     */
+    Size memoryOwned;
+
+    /** Interrupt number which signals the page broker on core0 */
+    uint brokerInterrupt;
+
     bool operator == (const struct CoreInfo & info) const
     {
         return false;
@@ -110,6 +120,23 @@ typedef struct CoreInfo
 }
 CoreInfo;
 
+/**
+ * Message exchanged between the kernel of a core and the page broker.
+ *
+ * A request from the kernel has a zero physical address and the
+ * wanted size. A non-zero address in a message from the kernel returns
+ * those pages to the broker, and from the broker grants them to the kernel.
+ */
+typedef struct CoreMemoryMessage
+{
+    /** Physical address of the pages, or zero */
+    Address phys;
+
+    /** Number of bytes */
+    Size size;
+}
+CoreMemoryMessage;
+
 /**
  * Local CoreInfo instance.
  *
@@ -89,29 +89,31 @@ MemoryContext::Result MemoryContext::release(Address virt)
 
 MemoryContext::Result MemoryContext::findFree(Size size, MemoryMap::Region region, Address *virt) const
 {
-    Memory::Range r = m_map->range(region);
-    Size currentSize = 0;
-    Address addr = r.virt, currentAddr = r.virt, tmp;
+    const Memory::Range r = m_map->range(region);
+    const Address end = r.virt + r.size;
+    Address addr = r.virt, candidate, tmp;
 
-    while (addr < r.virt+r.size && currentSize < size)
+    if (size % PAGESIZE)
+        size += PAGESIZE - (size % PAGESIZE);
+
+    while (addr < end &&
+           m_mapped.findGap(addr, end - addr, size, &candidate) == IntervalSet::Success)
     {
-        if (lookup(addr, &tmp) == InvalidAddress)
-        {
-            currentSize += PAGESIZE;
-        }
-        else
+        Size i = 0;
+
+        // Verify the candidate with the page tables
+        while (i < size && lookup(candidate + i, &tmp) == InvalidAddress)
+            i += PAGESIZE;
+
+        if (i >= size)
         {
-            currentSize = 0; 
-            currentAddr = addr + PAGESIZE;
+            *virt = candidate;
+            return Success;
         }
-        addr += PAGESIZE;
-    }
 
-    if (currentSize >= size)
-    {
-        *virt = currentAddr;
-        return Success;
+        // Continue after the unknown mapped page
+        addr = candidate + i + PAGESIZE;
     }
-    else
-        return OutOfMemory;
+
+    return OutOfMemory;
 }
@@ -21,6 +21,7 @@
 #include <Types.h>
 #include <Macros.h>
 #include <BitOperations.h>
+#include <IntervalSet.h>
 #include "Memory.h"
 #include "MemoryMap.h"
 
@@ -181,6 +182,9 @@ class MemoryContext
      * This function finds a contigeous block of a given size
      * of virtual memory which is unused and then returns
      * the virtual address of the first page in the block.
+     * Candidate blocks are taken from the set of mapped ranges and
+     * then verified, since mappings of shared kernel page tables
+     * may have been added by another MemoryContext.
      *
      * @param region Memory region to search in.
      * @param size Number of bytes requested to be free.
@@ -198,6 +202,9 @@ class MemoryContext
     /** Virtual memory layout */
     MemoryMap *m_map;
 
+    /** Virtual memory ranges mapped in this context */
+    IntervalSet m_mapped;
+
     /** The currently active MemoryContext */
     static MemoryContext *m_current;
 };
@@ -63,6 +63,16 @@ Timer::Result Timer::stop()
     return Success;
 }
 
+Timer::Result Timer::setOneShot(u32 ticks)
+{
+    return NotFound;
+}
+
+Timer::Result Timer::setPeriodic()
+{
+    return Success;
+}
+
 Timer::Result Timer::tick()
 {
     m_info.ticks++;
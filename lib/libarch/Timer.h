@@ -121,6 +121,27 @@ class Timer
      */
     virtual Result stop();
 
+    /**
+     * Interrupt once after a number of ticks.
+     *
+     * This function replaces the periodic tick with a single
+     * interrupt. Ticks which pass in between are accounted by
+     * tick() and getCurrent(), such that the timer keeps counting time.
+     *
+     * @param ticks Number of ticks until the interrupt, or zero
+     *              to interrupt as late as the timer allows.
+     *
+     * @return Result code. NotFound if only periodic ticks are supported.
+     */
+    virtual Result setOneShot(u32 ticks);
+
+    /**
+     * Return to generating an interrupt on each tick.
+     *
+     * @return Result code.
+     */
+    virtual Result setPeriodic();
+
     /**
      * Process timer tick.
      *
@@ -68,7 +68,9 @@ class ARMControl
         InstructionTLBClear,
         DataTLBClear,
         UnifiedTLBClear,
+        UnifiedTLBClearASID,
         UserProcID,
+        ContextID,
         InstructionFaultAddress,
         InstructionFaultStatus,
         DataFaultAddress,
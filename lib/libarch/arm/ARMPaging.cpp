@@ -25,8 +25,23 @@
 #include "ARMPaging.h"
 #include "ARMFirstTable.h"
 
+#ifdef ARMV7
+
+/** Number of ASIDs. ASID zero is reserved for switching tables. */
+#define ASID_COUNT 256
+
+/** Current ASID generation. Zero is never a valid generation. */
+static u32 asidGeneration = 1;
+
+/** Next free ASID in the current generation. */
+static u32 asidNext = 1;
+
+#endif /* ARMV7 */
+
 ARMPaging::ARMPaging(MemoryMap *map, SplitAllocator *alloc)
     : MemoryContext(map, alloc)
+    , m_asid(0)
+    , m_asidGeneration(0)
 {
     Allocator::Range phys, virt;
     phys.address = 0;
@@ -51,6 +66,8 @@ ARMPaging::ARMPaging(MemoryMap *map,
                      Address firstTableAddress,
                      Address kernelBaseAddress)
     : MemoryContext(map, ZERO)
+    , m_asid(0)
+    , m_asidGeneration(0)
 {
     m_firstTable = (ARMFirstTable *) firstTableAddress;
     setupFirstTable(map, firstTableAddress, kernelBaseAddress);
@@ -205,14 +222,28 @@ MemoryContext::Result ARMPaging::activate(bool initializeMMU)
         m_cache.cleanInvalidate(Cache::Unified);
 #endif /* ARMV6 */
 
+#ifdef ARMV7
+        // Use the reserved ASID while switching first page table, such
+        // that no TLB entries of the new table get tagged with the old ASID
+        assignASID();
+        ctrl.write(ARMControl::ContextID, 0);
+        isb();
+#endif /* ARMV7 */
+
         // Switch first page table and re-enable L1 caching
         ctrl.write(ARMControl::TranslationTable0, (((u32) m_firstTableAddr) |
             (1 << 3) | /* outer write-back, write-allocate */
             (1 << 6)   /* inner write-back, write-allocate */
         ));
 
+#ifdef ARMV7
+        // Non-global TLB entries of other contexts stay valid under their own ASID
+        isb();
+        ctrl.write(ARMControl::ContextID, m_asid);
+#else
         // Flush TLB caches
         tlb_flush_all();
+#endif /* ARMV7 */
 
         // Synchronize execution stream
         isb();
@@ -226,10 +257,11 @@ MemoryContext::Result ARMPaging::map(Address virt, Address phys, Memory::Access
 {
     // Modify page tables
     Result r = m_firstTable->map(virt, phys, acc, m_alloc);
+    if (r == Success)
+        m_mapped.insert(virt & PAGEMASK, PAGESIZE);
 
     // Flush the TLB to refresh the mapping
-    if (m_current == this)
-        tlb_invalidate(virt);
+    invalidateTLB(virt);
 
     // Synchronize execution stream.
     isb();
@@ -244,10 +276,11 @@ MemoryContext::Result ARMPaging::unmap(Address virt)
 
     // Modify page tables
     Result r = m_firstTable->unmap(virt, m_alloc);
+    if (r == Success)
+        m_mapped.remove(virt & PAGEMASK, PAGESIZE);
 
     // Flush TLB to refresh the mapping
-    if (m_current == this)
-        tlb_invalidate(virt);
+    invalidateTLB(virt);
 
     // Synchronize execution stream
     isb();
@@ -266,10 +299,64 @@ MemoryContext::Result ARMPaging::access(Address virt, Memory::Access *access) co
 
 MemoryContext::Result ARMPaging::releaseRegion(MemoryMap::Region region, bool tablesOnly)
 {
-    return m_firstTable->releaseRange(m_map->range(region), m_alloc, tablesOnly);
+    Memory::Range range = m_map->range(region);
+
+    m_mapped.remove(range.virt, range.size);
+    const Result r = m_firstTable->releaseRange(range, m_alloc, tablesOnly);
+
+    invalidateTLB();
+    return r;
 }
 
 MemoryContext::Result ARMPaging::releaseRange(Memory::Range *range, bool tablesOnly)
 {
-    return m_firstTable->releaseRange(*range, m_alloc, tablesOnly);
+    m_mapped.remove(range->virt, range->size);
+    const Result r = m_firstTable->releaseRange(*range, m_alloc, tablesOnly);
+
+    invalidateTLB();
+    return r;
+}
+
+void ARMPaging::assignASID()
+{
+#ifdef ARMV7
+    if (m_asidGeneration == asidGeneration)
+        return;
+
+    // Start a new generation if all ASIDs are in use
+    if (asidNext >= ASID_COUNT)
+    {
+        asidGeneration++;
+        asidNext = 1;
+        tlb_flush_all();
+        dsb();
+    }
+    m_asid = asidNext++;
+    m_asidGeneration = asidGeneration;
+#endif /* ARMV7 */
+}
+
+void ARMPaging::invalidateTLB(Address virt)
+{
+#ifdef ARMV7
+    // Entries of inactive contexts remain cached under their ASID
+    if (m_current == this || m_asidGeneration == asidGeneration)
+        tlb_invalidate((virt & PAGEMASK) | m_asid);
+#else
+    if (m_current == this)
+        tlb_invalidate(virt);
+#endif /* ARMV7 */
+}
+
+void ARMPaging::invalidateTLB()
+{
+#ifdef ARMV7
+    if (m_asidGeneration == asidGeneration)
+    {
+        ARMControl ctrl;
+        ctrl.write(ARMControl::UnifiedTLBClearASID, m_asid);
+        dsb();
+        isb();
+    }
+#endif /* ARMV7 */
 }
@@ -155,6 +155,26 @@ class ARMPaging : public MemoryContext
      */
     Result enableMMU();
 
+    /**
+     * Assign an Address Space Identifier (ASID), if needed.
+     *
+     * ASIDs are handed out in generations. When all ASIDs are
+     * used, the TLB is flushed and a new generation starts.
+     */
+    void assignASID();
+
+    /**
+     * Invalidate the TLB entry of a virtual address in this context.
+     *
+     * @param virt Virtual address to invalidate.
+     */
+    void invalidateTLB(Address virt);
+
+    /**
+     * Invalidate all TLB entries of this context.
+     */
+    void invalidateTLB();
+
   private:
 
     /** Pointer to the first level page table. */
@@ -165,6 +185,12 @@ class ARMPaging : public MemoryContext
 
     /** Caching implementation */
     Arch::Cache m_cache;
+
+    /** Address Space Identifier tagging non-global TLB entries */
+    u32 m_asid;
+
+    /** ASID generation in which m_asid was assigned */
+    u32 m_asidGeneration;
 };
 
 namespace Arch
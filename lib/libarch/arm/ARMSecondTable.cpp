@@ -35,6 +35,13 @@
 #define PAGE2_NONE      (0)
 #define PAGE2_PRESENT   (1 << 1)
 
+#ifdef ARMV7
+/** Not global: the TLB entry is tagged with the current ASID. */
+#define PAGE2_NOTGLOBAL (1 << 11)
+#else
+#define PAGE2_NOTGLOBAL (0)
+#endif /* ARMV7 */
+
 /**
  * @group Second Level Memory Types
  *
@@ -111,7 +118,7 @@ MemoryContext::Result ARMSecondTable::map(Address virt,
         return MemoryContext::AlreadyExists;
 
     // Insert mapping
-    m_pages[ TABENTRY(virt) ] = (phys & PAGEMASK) | PAGE2_PRESENT | flags(access);
+    m_pages[ TABENTRY(virt) ] = (phys & PAGEMASK) | PAGE2_PRESENT | PAGE2_NOTGLOBAL | flags(access);
     cache.cleanData(&m_pages[TABENTRY(virt)]);
     return MemoryContext::Success;
 }
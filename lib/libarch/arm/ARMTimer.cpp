@@ -23,8 +23,14 @@
 /** Timer enable. Set to enable timer. */
 #define CNTP_CTL_ENABLE  (1 << 0)
 
+/** Timer interrupt mask. Set to mask the timer interrupt. */
+#define CNTP_CTL_IMASK   (1 << 1)
+
 ARMTimer::ARMTimer()
-    : m_frequency(0)
+    : m_interval(0)
+    , m_oneShot(false)
+    , m_oneShotCount(0)
+    , m_oneShotOffset(0)
 {
     m_int = ARMTIMER_IRQ;
 }
@@ -44,6 +50,11 @@ void ARMTimer::setPL1PhysicalTimerValue(u32 value)
     mcr(p15, 0, 0, c14, c2, value);
 }
 
+s32 ARMTimer::getPL1PhysicalTimerValue(void) const
+{
+    return mrc(p15, 0, 0, c14, c2);
+}
+
 void ARMTimer::setPL1PhysicalTimerControl(u32 value)
 {
     mcr(p15, 0, 1, c14, c2, value);
@@ -52,13 +63,86 @@ void ARMTimer::setPL1PhysicalTimerControl(u32 value)
 ARMTimer::Result ARMTimer::setFrequency(Size hertz)
 {
     m_frequency = hertz;
-    tick();
+    m_interval  = getSystemFrequency() / hertz;
+
+    setPL1PhysicalTimerValue(m_interval);
+    setPL1PhysicalTimerControl(CNTP_CTL_ENABLE);
     return Success;
 }
 
 ARMTimer::Result ARMTimer::tick()
 {
-    setPL1PhysicalTimerValue(getSystemFrequency() / m_frequency);
+    if (m_oneShot)
+    {
+        // The one-shot timer expired: account all passed ticks and
+        // mask the interrupt until the timer is programmed again
+        m_info.ticks += elapsedCount() / m_interval;
+        m_oneShotCount = 0;
+        m_oneShotOffset = 0;
+        setPL1PhysicalTimerControl(CNTP_CTL_ENABLE | CNTP_CTL_IMASK);
+        return Success;
+    }
+
+    Timer::tick();
+    setPL1PhysicalTimerValue(m_interval);
+    setPL1PhysicalTimerControl(CNTP_CTL_ENABLE);
+    return Success;
+}
+
+u32 ARMTimer::elapsedCount() const
+{
+    if (!m_oneShot || !m_oneShotCount)
+        return 0;
+
+    return m_oneShotOffset + (m_oneShotCount - getPL1PhysicalTimerValue());
+}
+
+ARMTimer::Result ARMTimer::setOneShot(u32 ticks)
+{
+    if (!m_interval)
+        return NotFound;
+
+    const u32 maximum = 0x7fffffff / m_interval;
+
+    // Account the whole ticks passed since the previous one-shot
+    const u32 elapsed = elapsedCount();
+    m_info.ticks += elapsed / m_interval;
+
+    if (ticks == 0 || ticks > maximum)
+        ticks = maximum;
+
+    // Keep the part of the current tick which already passed
+    m_oneShotOffset = elapsed % m_interval;
+    m_oneShotCount  = (ticks * m_interval) - m_oneShotOffset;
+    m_oneShot = true;
+
+    setPL1PhysicalTimerValue(m_oneShotCount);
     setPL1PhysicalTimerControl(CNTP_CTL_ENABLE);
     return Success;
 }
+
+ARMTimer::Result ARMTimer::setPeriodic()
+{
+    if (m_oneShot)
+    {
+        m_info.ticks += elapsedCount() / m_interval;
+        m_oneShot = false;
+        m_oneShotCount = 0;
+        m_oneShotOffset = 0;
+
+        setPL1PhysicalTimerValue(m_interval);
+        setPL1PhysicalTimerControl(CNTP_CTL_ENABLE);
+    }
+    return Success;
+}
+
+ARMTimer::Result ARMTimer::getCurrent(Info *info)
+{
+    info->frequency = m_frequency;
+    info->ticks     = m_info.ticks;
+
+    if (m_oneShot)
+        info->ticks += elapsedCount() / m_interval;
+
+    return Success;
+}
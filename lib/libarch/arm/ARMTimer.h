@@ -64,8 +64,42 @@ class ARMTimer : public Timer
      */
     virtual Result tick();
 
+    /**
+     * Interrupt once after a number of ticks.
+     *
+     * @param ticks Number of ticks until the interrupt, or zero for the maximum.
+     *
+     * @return Result code
+     */
+    virtual Result setOneShot(u32 ticks);
+
+    /**
+     * Return to the periodic timer interrupt.
+     *
+     * @return Result code
+     */
+    virtual Result setPeriodic();
+
+    /**
+     * Get current timer info.
+     *
+     * Includes the ticks passed since the one-shot timer was programmed.
+     *
+     * @param info Timer Info object pointer for output.
+     *
+     * @return Result code.
+     */
+    virtual Result getCurrent(Info *info);
+
   private:
 
+    /**
+     * Get the number of counts since the last accounted tick.
+     *
+     * @return Elapsed timer counts in one-shot mode, zero otherwise.
+     */
+    u32 elapsedCount() const;
+
     /**
      * Retrieve system timer frequency
      *
@@ -87,6 +121,13 @@ class ARMTimer : public Timer
      */
     void setPL1PhysicalTimerValue(u32 value);
 
+    /**
+     * Get Physical Timer 1 value
+     *
+     * @return Remaining timer counts, negative if expired
+     */
+    s32 getPL1PhysicalTimerValue(void) const;
+
     /**
      * Set Physical Timer 1 control value
      *
@@ -96,7 +137,17 @@ class ARMTimer : public Timer
 
   private:
 
-    Size m_frequency;
+    /** System counts per tick */
+    u32 m_interval;
+
+    /** True if the timer is in one-shot mode */
+    bool m_oneShot;
+
+    /** Counter value programmed for the one-shot timer, or zero when expired */
+    u32 m_oneShotCount;
+
+    /** Counts which already passed in the current tick when the one-shot was programmed */
+    u32 m_oneShotOffset;
 };
 
 /**
@@ -36,9 +36,13 @@
 IntelAPIC::IntelAPIC()
     : IntController()
 {
+    m_base = InterruptBase;
     m_frequency = 0;
     m_int = TimerVector;
     m_initialCounter = 0;
+    m_oneShot = false;
+    m_oneShotCount = 0;
+    m_oneShotOffset = 0;
     m_io.setBase(IOBase);
 }
 
@@ -116,7 +120,7 @@ Timer::Result IntelAPIC::wait(u32 microseconds) const
     else
     {
         Size usecPerInt = 1000000 / m_frequency;
-        Size usecPerTick = usecPerInt / m_io.read(InitialCount);
+        Size usecPerTick = usecPerInt / m_initialCounter;
         u32 t1 = m_io.read(CurrentCount), t2;
         u32 waited = 0;
 
@@ -159,6 +163,76 @@ Timer::Result IntelAPIC::stop()
     return Timer::Success;
 }
 
+u32 IntelAPIC::elapsedCount() const
+{
+    if (!m_oneShot || !m_oneShotCount)
+        return 0;
+
+    return m_oneShotOffset + (m_oneShotCount - m_io.read(CurrentCount));
+}
+
+Timer::Result IntelAPIC::setOneShot(u32 ticks)
+{
+    if (!m_initialCounter)
+        return Timer::NotFound;
+
+    const u32 maximum = 0xffffffff / m_initialCounter;
+
+    // Account the whole ticks passed since the previous one-shot
+    const u32 elapsed = elapsedCount();
+    m_info.ticks += elapsed / m_initialCounter;
+
+    if (ticks == 0 || ticks > maximum)
+        ticks = maximum;
+
+    // Keep the part of the current tick which already passed
+    m_oneShotOffset = elapsed % m_initialCounter;
+    m_oneShotCount  = (ticks * m_initialCounter) - m_oneShotOffset;
+    m_oneShot = true;
+
+    m_io.write(Timer, TimerVector);
+    m_io.write(InitialCount, m_oneShotCount);
+    return Timer::Success;
+}
+
+Timer::Result IntelAPIC::setPeriodic()
+{
+    if (m_oneShot)
+    {
+        m_info.ticks += elapsedCount() / m_initialCounter;
+        m_oneShot = false;
+        m_oneShotCount = 0;
+        m_oneShotOffset = 0;
+
+        m_io.write(Timer, TimerVector | PeriodicMode);
+        m_io.write(InitialCount, m_initialCounter);
+    }
+    return Timer::Success;
+}
+
+Timer::Result IntelAPIC::getCurrent(Info *info)
+{
+    info->frequency = m_frequency;
+    info->ticks     = m_info.ticks;
+
+    if (m_oneShot)
+        info->ticks += elapsedCount() / m_initialCounter;
+
+    return Timer::Success;
+}
+
+Timer::Result IntelAPIC::tick()
+{
+    if (!m_oneShot)
+        return Timer::tick();
+
+    // The one-shot timer expired: all programmed ticks have passed
+    m_info.ticks += elapsedCount() / m_initialCounter;
+    m_oneShotCount = 0;
+    m_oneShotOffset = 0;
+    return Timer::Success;
+}
+
 Timer::Result IntelAPIC::initialize()
 {
     // Map the registers into the address space
@@ -252,3 +326,8 @@ IntController::Result IntelAPIC::sendIPI(uint cpuId, uint vector)
     // Done
     return IntController::Success;
 }
+
+IntController::Result IntelAPIC::send(const uint targetCoreId, const uint irq)
+{
+    return sendIPI(targetCoreId, irq + m_base);
+}
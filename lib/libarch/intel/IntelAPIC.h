@@ -54,6 +54,15 @@ class IntelAPIC : public IntController, public Timer
     /** APIC timer interrupt vector is fixed at 48 */
     static const uint TimerVector = 48;
 
+    /** Inter-Processor-Interrupt vector used by the CoreServer */
+    static const uint IPIVector = 50;
+
+    /**
+     * Base offset for interrupt vectors, equal to the PIC such
+     * that IRQ numbers are the same on every core.
+     */
+    static const uint InterruptBase = 32;
+
   private:
 
     /**
@@ -181,6 +190,42 @@ class IntelAPIC : public IntController, public Timer
      */
     virtual Timer::Result stop();
 
+    /**
+     * Interrupt once after a number of ticks.
+     *
+     * @param ticks Number of ticks until the interrupt, or zero for the maximum.
+     *
+     * @return Result code
+     */
+    virtual Timer::Result setOneShot(u32 ticks);
+
+    /**
+     * Return to the periodic timer interrupt.
+     *
+     * @return Result code
+     */
+    virtual Timer::Result setPeriodic();
+
+    /**
+     * Get current timer info.
+     *
+     * Includes the ticks passed since the one-shot timer was programmed.
+     *
+     * @param info Timer Info object pointer for output.
+     *
+     * @return Result code.
+     */
+    virtual Timer::Result getCurrent(Info *info);
+
+    /**
+     * Process timer tick.
+     *
+     * Accounts all ticks passed when the one-shot timer expires.
+     *
+     * @return Result code.
+     */
+    virtual Timer::Result tick();
+
     /**
      * Enable hardware interrupt (IRQ).
      *
@@ -228,6 +273,25 @@ class IntelAPIC : public IntController, public Timer
      */
     IntController::Result sendIPI(uint coreId, uint vector);
 
+    /**
+     * Send an inter-processor-interrupt (IPI).
+     *
+     * @param targetCoreId Target processor that will receive the interrupt
+     * @param irq Interrupt number to send, relative to the interrupt base
+     *
+     * @return Result code
+     */
+    virtual IntController::Result send(const uint targetCoreId, const uint irq);
+
+  private:
+
+    /**
+     * Get the number of counts since the last accounted tick.
+     *
+     * @return Elapsed timer counts in one-shot mode, zero otherwise.
+     */
+    u32 elapsedCount() const;
+
   private:
 
     /** I/O object */
@@ -235,6 +299,15 @@ class IntelAPIC : public IntController, public Timer
 
     /** Saved initial counter value for APIC timer */
     uint m_initialCounter;
+
+    /** True if the timer is in one-shot mode */
+    bool m_oneShot;
+
+    /** Counter value programmed for the one-shot timer, or zero when expired */
+    u32 m_oneShotCount;
+
+    /** Counts which already passed in the current tick when the one-shot was programmed */
+    u32 m_oneShotOffset;
 };
 
 /**
@@ -40,6 +40,18 @@
 /** Protected Mode. */
 #define CR0_PE          0x00000001
 
+/** Monitor Coprocessor. */
+#define CR0_MP          (1 << 1)
+
+/** FPU Emulation. */
+#define CR0_EM          (1 << 2)
+
+/** Task Switched: the next FPU instruction raises a Device Not Available fault. */
+#define CR0_TS          (1 << 3)
+
+/** Native FPU error reporting. */
+#define CR0_NE          (1 << 5)
+
 /** Paged Mode. */
 #define CR0_PG          0x80000000
 
@@ -47,6 +59,15 @@
 #define CR4_TSD         0x00000004
 #define CR4_PSE         (1 << 4)
 
+/** Page Global Enable. */
+#define CR4_PGE         (1 << 7)
+
+/** Operating System supports FXSAVE/FXRSTOR. */
+#define CR4_OSFXSR      (1 << 9)
+
+/** Operating System supports unmasked SIMD exceptions. */
+#define CR4_OSXMMEXCPT  (1 << 10)
+
 /** Kernel Code Segment. */
 #define KERNEL_CS       1
 #define KERNEL_CS_SEL   0x8
@@ -160,3 +160,76 @@ void IntelCore::writeCR3(u32 cr3) const
     asm volatile("mov %0, %%eax\n"
                  "mov %%eax, %%cr3" :: "r" (cr3));
 }
+
+volatile u32 IntelCore::readCR0() const
+{
+    volatile u32 cr0;
+    asm volatile("mov %%cr0, %0\n" : "=r" (cr0));
+    return cr0;
+}
+
+void IntelCore::writeCR0(u32 cr0) const
+{
+    asm volatile("mov %0, %%cr0" :: "r" (cr0));
+}
+
+volatile u32 IntelCore::readCR4() const
+{
+    volatile u32 cr4;
+    asm volatile("mov %%cr4, %0\n" : "=r" (cr4));
+    return cr4;
+}
+
+void IntelCore::writeCR4(u32 cr4) const
+{
+    asm volatile("mov %0, %%cr4" :: "r" (cr4));
+}
+
+void IntelCore::clearTaskSwitched() const
+{
+    asm volatile("clts");
+}
+
+void IntelCore::initFPU(bool sse) const
+{
+    const u32 mxcsr = 0x1f80;
+
+    asm volatile("fninit");
+
+    if (sse)
+        asm volatile("ldmxcsr %0" :: "m" (mxcsr));
+}
+
+void IntelCore::saveFPU(u8 *area, bool sse) const
+{
+    if (sse)
+        asm volatile("fxsave (%0)" :: "r" (area) : "memory");
+    else
+        asm volatile("fnsave (%0)" :: "r" (area) : "memory");
+}
+
+void IntelCore::restoreFPU(const u8 *area, bool sse) const
+{
+    if (sse)
+        asm volatile("fxrstor (%0)" :: "r" (area) : "memory");
+    else
+        asm volatile("frstor (%0)" :: "r" (area) : "memory");
+}
+
+void IntelCore::cpuid(u32 leaf, u32 *eax, u32 *ebx, u32 *ecx, u32 *edx) const
+{
+    asm volatile("cpuid" : "=a" (*eax), "=b" (*ebx), "=c" (*ecx), "=d" (*edx)
+                         : "a" (leaf), "c" (0));
+}
+
+u64 IntelCore::readMSR(u32 msr) const
+{
+    u64 value;
+    asm volatile("rdmsr" : "=A" (value) : "c" (msr));
+    return value;
+}
+
+void IntelCore::writeMSR(u32 msr, u64 value) const
+{
+    asm volatile("wrmsr" :: "c" (msr), "A" (value));
+}
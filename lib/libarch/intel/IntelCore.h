@@ -93,7 +93,7 @@ inline u64 timestamp()
     asm volatile("invlpg (%0)" ::"r" (addr) : "memory")
 
 /**
- * Flushes all Translation Lookaside Buffers (TLB).
+ * Flushes all non-global Translation Lookaside Buffers (TLB).
  */
 #define tlb_flush_all() \
     asm volatile("mov %cr3, %eax\n" \
@@ -251,6 +251,28 @@ typedef struct CPUState
 }
 CPUState;
 
+/**
+ * Registers saved by the SYSENTER system call entry.
+ */
+typedef struct SystemCallState
+{
+    /* Set by the kernel if the caller runs privileged. */
+    u32 privileged;
+
+    /* API number (EAX). */
+    u32 number;
+
+    /* Arguments (EBX, ESI, EDI, EBP). */
+    u32 arg1, arg2, arg3, arg4;
+
+    /* Userspace return address (EDX). */
+    u32 eip;
+
+    /* Userspace stack pointer (ECX). */
+    u32 esp;
+}
+SystemCallState;
+
 /**
  * Intel CPU Core.
  */
@@ -258,6 +280,32 @@ class IntelCore : public Core
 {
   public:
 
+    /**
+     * Model Specific Registers (MSR).
+     */
+    enum ModelRegister
+    {
+        SysenterCS  = 0x174,
+        SysenterESP = 0x175,
+        SysenterEIP = 0x176
+    };
+
+    /**
+     * Feature flags reported by CPUID leaf 1 in EDX.
+     */
+    enum Feature
+    {
+        FeatureSEP  = (1 << 11),
+        FeaturePGE  = (1 << 13),
+        FeatureFXSR = (1 << 24)
+    };
+
+    /** Size of the FXSAVE area in bytes */
+    static const Size FPUStateSize = 512;
+
+    /** Alignment of the FXSAVE area in bytes */
+    static const Size FPUStateAlign = 16;
+
     /**
      * Log a CPU exception.
      *
@@ -294,6 +342,82 @@ class IntelCore : public Core
      * Write the CR3 register
      */
     void writeCR3(u32 cr3) const;
+
+    /**
+     * Read the CR0 register.
+     */
+    volatile u32 readCR0() const;
+
+    /**
+     * Write the CR0 register.
+     */
+    void writeCR0(u32 cr0) const;
+
+    /**
+     * Read the CR4 register.
+     */
+    volatile u32 readCR4() const;
+
+    /**
+     * Write the CR4 register.
+     */
+    void writeCR4(u32 cr4) const;
+
+    /**
+     * Clear the Task Switched flag in CR0.
+     */
+    void clearTaskSwitched() const;
+
+    /**
+     * Reset the FPU and SSE registers to their defaults.
+     *
+     * @param sse True if SSE (FXSAVE) is enabled.
+     */
+    void initFPU(bool sse) const;
+
+    /**
+     * Save the FPU and SSE registers.
+     *
+     * @param area FPUStateSize bytes, aligned on FPUStateAlign.
+     * @param sse True to use FXSAVE, false for the legacy FNSAVE.
+     */
+    void saveFPU(u8 *area, bool sse) const;
+
+    /**
+     * Restore the FPU and SSE registers.
+     *
+     * @param area Area previously filled by saveFPU().
+     * @param sse True to use FXRSTOR, false for the legacy FRSTOR.
+     */
+    void restoreFPU(const u8 *area, bool sse) const;
+
+    /**
+     * Execute the CPUID instruction.
+     *
+     * @param leaf Information leaf to query (EAX).
+     * @param eax Output value of EAX.
+     * @param ebx Output value of EBX.
+     * @param ecx Output value of ECX.
+     * @param edx Output value of EDX.
+     */
+    void cpuid(u32 leaf, u32 *eax, u32 *ebx, u32 *ecx, u32 *edx) const;
+
+    /**
+     * Read a Model Specific Register.
+     *
+     * @param msr Register number.
+     *
+     * @return Register value.
+     */
+    u64 readMSR(u32 msr) const;
+
+    /**
+     * Write a Model Specific Register.
+     *
+     * @param msr Register number.
+     * @param value New register value.
+     */
+    void writeMSR(u32 msr, u64 value) const;
 };
 
 #ifdef __KERNEL__
@@ -0,0 +1,302 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <MemoryBlock.h>
+#include "IntelConstant.h"
+#include "IntelPCI.h"
+
+/** Enable bit of the configuration address register */
+#define PCI_CONFIG_ENABLE (1 << 31)
+
+/** Base address of MSI messages targeting a local APIC */
+#define PCI_MSI_ADDRESS   0xfee00000
+
+IntelPCI::IntelPCI()
+{
+}
+
+IntelPCI::~IntelPCI()
+{
+}
+
+void IntelPCI::select(const Function & func, u8 reg) const
+{
+    IntelIO io;
+
+    io.outl(ConfigAddress, PCI_CONFIG_ENABLE | (func.bus << 16) |
+                           (func.slot << 11) | (func.function << 8) | (reg & 0xfc));
+}
+
+u32 IntelPCI::readLong(const Function & func, u8 reg) const
+{
+    IntelIO io;
+
+    select(func, reg);
+    return io.inl(ConfigData);
+}
+
+u16 IntelPCI::readWord(const Function & func, u8 reg) const
+{
+    IntelIO io;
+
+    select(func, reg);
+    return io.inw(ConfigData + (reg & 2));
+}
+
+u8 IntelPCI::readByte(const Function & func, u8 reg) const
+{
+    IntelIO io;
+
+    select(func, reg);
+    return io.inb(ConfigData + (reg & 3));
+}
+
+void IntelPCI::writeLong(const Function & func, u8 reg, u32 value)
+{
+    IntelIO io;
+
+    select(func, reg);
+    io.outl(ConfigData, value);
+}
+
+void IntelPCI::writeWord(const Function & func, u8 reg, u16 value)
+{
+    IntelIO io;
+
+    select(func, reg);
+    io.outw(ConfigData + (reg & 2), value);
+}
+
+IntelPCI::Result IntelPCI::probe(uint bus, uint slot, uint function, Function *func) const
+{
+    MemoryBlock::set(func, 0, sizeof(*func));
+    func->bus      = bus;
+    func->slot     = slot;
+    func->function = function;
+
+    // No device responds if the vendor reads as all ones
+    func->vendorId = readWord(*func, VendorID);
+    if (func->vendorId == 0xffff)
+        return NotFound;
+
+    func->deviceId      = readWord(*func, DeviceID);
+    func->revision      = readByte(*func, Revision);
+    func->progIf        = readByte(*func, ProgIF);
+    func->subClass      = readByte(*func, SubClass);
+    func->classCode     = readByte(*func, ClassCode);
+    func->interruptLine = readByte(*func, InterruptLine);
+    return Success;
+}
+
+bool IntelPCI::isMultiFunction(const Function & func) const
+{
+    return readByte(func, HeaderType) & MultiFunction;
+}
+
+IntelPCI::Result IntelPCI::find(u16 vendorId, u16 deviceId, Function *func, Size index) const
+{
+    for (uint bus = 0; bus < Buses; bus++)
+    {
+        for (uint slot = 0; slot < Slots; slot++)
+        {
+            for (uint function = 0; function < Functions; function++)
+            {
+                if (probe(bus, slot, function, func) != Success)
+                {
+                    if (function == 0)
+                        break;
+                    else
+                        continue;
+                }
+
+                if (func->vendorId == vendorId && func->deviceId == deviceId && index-- == 0)
+                    return Success;
+
+                if (function == 0 && !isMultiFunction(*func))
+                    break;
+            }
+        }
+    }
+    return NotFound;
+}
+
+IntelPCI::Result IntelPCI::findClass(u8 classCode, u8 subClass, u8 progIf, Function *func, Size index) const
+{
+    for (uint bus = 0; bus < Buses; bus++)
+    {
+        for (uint slot = 0; slot < Slots; slot++)
+        {
+            for (uint function = 0; function < Functions; function++)
+            {
+                if (probe(bus, slot, function, func) != Success)
+                {
+                    if (function == 0)
+                        break;
+                    else
+                        continue;
+                }
+
+                if (func->classCode == classCode && func->subClass == subClass &&
+                    func->progIf == progIf && index-- == 0)
+                    return Success;
+
+                if (function == 0 && !isMultiFunction(*func))
+                    break;
+            }
+        }
+    }
+    return NotFound;
+}
+
+IntelPCI::Result IntelPCI::readBAR(const Function & func, Size index, BAR *bar)
+{
+    const u8 reg = BAR0 + (index * 4);
+    u32 original, mask;
+
+    if (index >= BARs || (readByte(func, HeaderType) & HeaderMask) != 0)
+        return InvalidArgument;
+
+    // Disable address decoding while the BAR is probed
+    const u16 command = readWord(func, Command);
+    writeWord(func, Command, command & ~(IOSpace | MemorySpace));
+
+    original = readLong(func, reg);
+    writeLong(func, reg, 0xffffffff);
+    mask = readLong(func, reg);
+    writeLong(func, reg, original);
+
+    writeWord(func, Command, command);
+
+    if (!mask || mask == 0xffffffff)
+        return NotFound;
+
+    bar->io = original & 1;
+
+    if (bar->io)
+    {
+        bar->address = original & ~0x3;
+        bar->size    = (~(mask & ~0x3) & 0xffff) + 1;
+    }
+    else
+    {
+        // Memory above 4GB cannot be mapped
+        if ((original & 0x6) == 0x4 && index + 1 < BARs && readLong(func, reg + 4) != 0)
+            return NotFound;
+
+        bar->address = original & ~0xf;
+        bar->size    = ~(mask & ~0xf) + 1;
+    }
+
+    return bar->size ? Success : NotFound;
+}
+
+void IntelPCI::enable(const Function & func, u16 flags)
+{
+    writeWord(func, Command, readWord(func, Command) | flags);
+}
+
+u8 IntelPCI::findCapability(const Function & func, u8 id, u8 start) const
+{
+    u8 offset;
+
+    if (!(readWord(func, Status) & CapabilityList))
+        return 0;
+
+    // Walk the linked list of capabilities
+    offset = start ? readByte(func, start + 1) : readByte(func, CapabilityPointer);
+
+    for (Size i = 0; offset && i < 48; i++)
+    {
+        offset &= 0xfc;
+
+        if (readByte(func, offset) == id)
+            return offset;
+
+        offset = readByte(func, offset + 1);
+    }
+    return 0;
+}
+
+IntelPCI::Result IntelPCI::enableMSI(const Function & func, uint apicId, uint vector)
+{
+    const u8 cap = findCapability(func, MSICapability);
+
+    if (!cap)
+        return NotFound;
+
+    const u16 control = readWord(func, cap + 2);
+
+    // Message address selects the local APIC, the data selects the vector
+    writeLong(func, cap + 4, PCI_MSI_ADDRESS | ((apicId & 0xff) << 12));
+
+    if (control & MSI64Bit)
+    {
+        writeLong(func, cap + 8, 0);
+        writeWord(func, cap + 12, vector & 0xff);
+    }
+    else
+        writeWord(func, cap + 8, vector & 0xff);
+
+    // Single message only, and no more legacy interrupts
+    writeWord(func, cap + 2, (control & ~(7 << 4)) | MSIEnable);
+    enable(func, InterruptDisable);
+    return Success;
+}
+
+IntelPCI::Result IntelPCI::enableMSIX(const Function & func, uint apicId, uint vector)
+{
+    const u8 cap = findCapability(func, MSIXCapability);
+    IntelIO io;
+    BAR bar;
+
+    if (!cap)
+        return NotFound;
+
+    const u16 control = readWord(func, cap + 2);
+    const u32 table = readLong(func, cap + 4);
+    const Size entries = (control & MSIXTableSize) + 1;
+
+    // The table lives in memory space, at an offset in one of the BARs
+    if (readBAR(func, table & 0x7, &bar) != Success || bar.io)
+        return NotFound;
+
+    const Address base = bar.address + (table & ~0x7);
+    const Size offset = base & ~PAGEMASK;
+
+    if (io.map(base & PAGEMASK, (offset + (entries * 16) + PAGESIZE - 1) & PAGEMASK,
+               Memory::User | Memory::Readable | Memory::Writable | Memory::Device) != IO::Success)
+        return NotFound;
+
+    // Mask the function while the table is updated
+    enable(func, MemorySpace);
+    writeWord(func, cap + 2, control | MSIXEnable | MSIXMaskAll);
+
+    for (Size i = 0; i < entries; i++)
+    {
+        const Address entry = offset + (i * 16);
+
+        io.write(entry + 0,  PCI_MSI_ADDRESS | ((apicId & 0xff) << 12));
+        io.write(entry + 4,  0);
+        io.write(entry + 8,  vector & 0xff);
+        io.write(entry + 12, 0);
+    }
+
+    io.unmap();
+    writeWord(func, cap + 2, (control | MSIXEnable) & ~MSIXMaskAll);
+    enable(func, InterruptDisable);
+    return Success;
+}
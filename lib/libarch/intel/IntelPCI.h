@@ -0,0 +1,374 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBARCH_INTEL_PCI_H
+#define __LIBARCH_INTEL_PCI_H
+
+#include <Types.h>
+#include "IntelIO.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libarch
+ * @{
+ *
+ * @addtogroup libarch_intel
+ * @{
+ */
+
+/**
+ * Intel PCI configuration space access.
+ *
+ * Uses configuration mechanism #1 via the I/O ports 0xcf8 and 0xcfc.
+ * Selecting a register and accessing it are two separate port accesses,
+ * so only a single process may use the ports. This is the PCI server:
+ * drivers use PCIClient, which overrides the register accessors.
+ */
+class IntelPCI
+{
+  public:
+
+    /** Number of buses on a PCI host */
+    static const uint Buses = 256;
+
+    /** Number of devices on a PCI bus */
+    static const uint Slots = 32;
+
+    /** Number of functions of a PCI device */
+    static const uint Functions = 8;
+
+    /** Number of base address registers in a type 0 header */
+    static const uint BARs = 6;
+
+    /**
+     * Result codes
+     */
+    enum Result
+    {
+        Success,
+        NotFound,
+        InvalidArgument
+    };
+
+    /**
+     * Configuration space registers.
+     */
+    enum Registers
+    {
+        VendorID          = 0x00,
+        DeviceID          = 0x02,
+        Command           = 0x04,
+        Status            = 0x06,
+        Revision          = 0x08,
+        ProgIF            = 0x09,
+        SubClass          = 0x0a,
+        ClassCode         = 0x0b,
+        HeaderType        = 0x0e,
+        BAR0              = 0x10,
+        CapabilityPointer = 0x34,
+        InterruptLine     = 0x3c
+    };
+
+    /**
+     * Command register flags.
+     */
+    enum CommandFlags
+    {
+        IOSpace          = (1 << 0),
+        MemorySpace      = (1 << 1),
+        BusMaster        = (1 << 2),
+        InterruptDisable = (1 << 10)
+    };
+
+    /**
+     * Capability identifiers.
+     */
+    enum CapabilityID
+    {
+        MSICapability    = 0x05,
+        VendorCapability = 0x09,
+        MSIXCapability   = 0x11
+    };
+
+    /**
+     * Identifies a single PCI function.
+     */
+    typedef struct Function
+    {
+        u8 bus;
+        u8 slot;
+        u8 function;
+        u8 revision;
+        u16 vendorId;
+        u16 deviceId;
+        u8 classCode;
+        u8 subClass;
+        u8 progIf;
+        u8 interruptLine;
+    }
+    Function;
+
+    /**
+     * Decoded base address register.
+     */
+    typedef struct BAR
+    {
+        /** Physical memory address or I/O port */
+        Address address;
+
+        /** Size in bytes */
+        Size size;
+
+        /** True for I/O space, false for memory space */
+        bool io;
+    }
+    BAR;
+
+  private:
+
+    /**
+     * Hardware registers.
+     */
+    enum Ports
+    {
+        ConfigAddress = 0xcf8,
+        ConfigData    = 0xcfc
+    };
+
+    /**
+     * Type 0 header flags.
+     */
+    enum HeaderFlags
+    {
+        MultiFunction = (1 << 7),
+        HeaderMask    = 0x7f
+    };
+
+    /**
+     * Status register flags.
+     */
+    enum StatusFlags
+    {
+        CapabilityList = (1 << 4)
+    };
+
+    /**
+     * MSI message control flags.
+     */
+    enum MSIControlFlags
+    {
+        MSIEnable = (1 << 0),
+        MSI64Bit  = (1 << 7)
+    };
+
+    /**
+     * MSI-X message control flags.
+     */
+    enum MSIXControlFlags
+    {
+        MSIXTableSize  = 0x7ff,
+        MSIXMaskAll    = (1 << 14),
+        MSIXEnable     = (1 << 15)
+    };
+
+  public:
+
+    /**
+     * Constructor
+     */
+    IntelPCI();
+
+    /**
+     * Destructor
+     */
+    virtual ~IntelPCI();
+
+    /**
+     * Read 32-bit configuration register.
+     *
+     * @param func PCI function
+     * @param reg Register offset, aligned on 4 bytes
+     *
+     * @return Register value
+     */
+    virtual u32 readLong(const Function & func, u8 reg) const;
+
+    /**
+     * Read 16-bit configuration register.
+     *
+     * @param func PCI function
+     * @param reg Register offset, aligned on 2 bytes
+     *
+     * @return Register value
+     */
+    virtual u16 readWord(const Function & func, u8 reg) const;
+
+    /**
+     * Read 8-bit configuration register.
+     *
+     * @param func PCI function
+     * @param reg Register offset
+     *
+     * @return Register value
+     */
+    virtual u8 readByte(const Function & func, u8 reg) const;
+
+    /**
+     * Write 32-bit configuration register.
+     *
+     * @param func PCI function
+     * @param reg Register offset, aligned on 4 bytes
+     * @param value New register value
+     */
+    virtual void writeLong(const Function & func, u8 reg, u32 value);
+
+    /**
+     * Write 16-bit configuration register.
+     *
+     * @param func PCI function
+     * @param reg Register offset, aligned on 2 bytes
+     * @param value New register value
+     */
+    virtual void writeWord(const Function & func, u8 reg, u16 value);
+
+    /**
+     * Probe for a function and fill its identification.
+     *
+     * @param bus Bus number
+     * @param slot Device number on the bus
+     * @param function Function number of the device
+     * @param func Output function
+     *
+     * @return Result code
+     */
+    Result probe(uint bus, uint slot, uint function, Function *func) const;
+
+    /**
+     * Check if a device implements more than one function.
+     *
+     * @param func Function zero of the device
+     *
+     * @return True if functions 1-7 must be probed as well.
+     */
+    bool isMultiFunction(const Function & func) const;
+
+    /**
+     * Find a function by vendor and device identifier.
+     *
+     * @param vendorId Vendor identifier
+     * @param deviceId Device identifier
+     * @param func Output function
+     * @param index Return the index'th match
+     *
+     * @return Result code
+     */
+    virtual Result find(u16 vendorId, u16 deviceId, Function *func, Size index = 0) const;
+
+    /**
+     * Find a function by class code.
+     *
+     * @param classCode Base class code
+     * @param subClass Sub class code
+     * @param progIf Programming interface
+     * @param func Output function
+     * @param index Return the index'th match
+     *
+     * @return Result code
+     */
+    virtual Result findClass(u8 classCode, u8 subClass, u8 progIf, Function *func, Size index = 0) const;
+
+    /**
+     * Decode a base address register.
+     *
+     * The size is determined by writing all ones to the register,
+     * with address decoding disabled while probing.
+     *
+     * @param func PCI function
+     * @param index BAR number
+     * @param bar Output BAR
+     *
+     * @return Result code. NotFound if the BAR is unused or
+     *         mapped above the 32-bit physical address space.
+     */
+    virtual Result readBAR(const Function & func, Size index, BAR *bar);
+
+    /**
+     * Set flags in the command register.
+     *
+     * @param func PCI function
+     * @param flags CommandFlags to set
+     */
+    void enable(const Function & func, u16 flags);
+
+    /**
+     * Find a capability.
+     *
+     * @param func PCI function
+     * @param id Capability identifier
+     * @param start Offset of the capability to continue after, or zero.
+     *
+     * @return Offset of the capability in configuration space, or zero if not found.
+     */
+    u8 findCapability(const Function & func, u8 id, u8 start = 0) const;
+
+    /**
+     * Deliver interrupts of a function as MSI to a local APIC.
+     *
+     * Also disables the legacy INTx interrupt of the function.
+     *
+     * @param func PCI function
+     * @param apicId Local APIC identifier of the destination core
+     * @param vector Interrupt vector to raise
+     *
+     * @return Result code. NotFound if MSI is not supported.
+     */
+    Result enableMSI(const Function & func, uint apicId, uint vector);
+
+    /**
+     * Deliver interrupts of a function as MSI-X to a local APIC.
+     *
+     * All entries of the MSI-X table raise the same vector. Also
+     * disables the legacy INTx interrupt of the function.
+     *
+     * @param func PCI function
+     * @param apicId Local APIC identifier of the destination core
+     * @param vector Interrupt vector to raise
+     *
+     * @return Result code. NotFound if MSI-X is not supported.
+     */
+    Result enableMSIX(const Function & func, uint apicId, uint vector);
+
+  private:
+
+    /**
+     * Select a configuration register.
+     *
+     * @param func PCI function
+     * @param reg Register offset
+     */
+    void select(const Function & func, u8 reg) const;
+};
+
+/**
+ * @}
+ * @}
+ * @}
+ */
+
+#endif /* __LIBARCH_INTEL_PCI_H */
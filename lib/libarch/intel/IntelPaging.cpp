@@ -15,6 +15,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <FreeNOS/System.h>
 #include <SplitAllocator.h>
 #include <MemoryBlock.h>
 #include "IntelCore.h"
@@ -91,9 +92,14 @@ MemoryContext::Result IntelPaging::map(Address virt, Address phys, Memory::Acces
 {
     MemoryContext::Result r = m_pageDirectory->map(virt, phys, acc, m_alloc);
 
-    // Flush TLB entry
-    if (r == Success && m_current == this)
-        tlb_flush(virt);
+    if (r == Success)
+    {
+        m_mapped.insert(virt & PAGEMASK, PAGESIZE);
+
+        // Flush TLB entry
+        if (m_current == this)
+            tlb_flush(virt);
+    }
 
     return r;
 }
@@ -102,9 +108,14 @@ MemoryContext::Result IntelPaging::unmap(Address virt)
 {
     MemoryContext::Result r = m_pageDirectory->unmap(virt, m_alloc);
 
-    // Flush TLB entry
-    if (r == Success && m_current == this)
-        tlb_flush(virt);
+    if (r == Success)
+    {
+        m_mapped.remove(virt & PAGEMASK, PAGESIZE);
+
+        // Flush TLB entry
+        if (m_current == this)
+            tlb_flush(virt);
+    }
 
     return r;
 }
@@ -121,10 +132,14 @@ MemoryContext::Result IntelPaging::access(Address virt, Memory::Access *access)
 
 MemoryContext::Result IntelPaging::releaseRegion(MemoryMap::Region region, bool tablesOnly)
 {
-    return m_pageDirectory->releaseRange(m_map->range(region), m_alloc, tablesOnly);
+    Memory::Range range = m_map->range(region);
+
+    m_mapped.remove(range.virt, range.size);
+    return m_pageDirectory->releaseRange(range, m_alloc, tablesOnly);
 }
 
 MemoryContext::Result IntelPaging::releaseRange(Memory::Range *range, bool tablesOnly)
 {
+    m_mapped.remove(range->virt, range->size);
     return m_pageDirectory->releaseRange(*range, m_alloc, tablesOnly);
 }
@@ -75,6 +75,27 @@ extern C void interruptHandler();
  */
 extern C void (*interruptRun)(CPUState state);
 
+/**
+ * SYSENTER system call entry.
+ *
+ * Saves only the registers needed to return to the caller in
+ * a SystemCallState on the kernel stack (found via the TSS),
+ * and returns with SYSEXIT.
+ */
+extern C void sysenterHandler();
+
+/**
+ * Process a system call.
+ *
+ * Callback function which is called by sysenterHandler()
+ * to process a system call.
+ *
+ * @return Result value for the caller.
+ *
+ * @see sysenterHandler
+ */
+extern C ulong (*systemCallRun)(SystemCallState *state);
+
 /**
  * @}
  * @}
@@ -56,7 +56,7 @@ ELF::Result ELF::detect(const u8 *image, Size size, ExecutableFormat **fmt)
     return InvalidFormat;
 }
 
-ELF::Result ELF::regions(ELF::Region *regions, Size *count) const
+ELF::Result ELF::regions(ELF::Region *regions, Size *count, bool copy) const
 {
     ELFSegment *segments;
     ELFHeader *header = (ELFHeader *) m_image;
@@ -80,10 +80,26 @@ ELF::Result ELF::regions(ELF::Region *regions, Size *count) const
         if (segments[i].type != ELF_SEGMENT_LOAD)
             continue;
 
-        regions[c].virt   = segments[i].virtualAddress;
-        regions[c].size   = segments[i].memorySize;
-        regions[c].access = Memory::User | Memory::Readable | Memory::Writable;
-        regions[c].data   = new u8[segments[i].memorySize];
+        // Segment contents must be inside the image
+        if (segments[i].offset + segments[i].fileSize > m_size ||
+            segments[i].fileSize > segments[i].memorySize)
+        {
+            return InvalidFormat;
+        }
+
+        regions[c].virt     = segments[i].virtualAddress;
+        regions[c].size     = segments[i].memorySize;
+        regions[c].access   = Memory::User | Memory::Readable | Memory::Writable;
+        regions[c].dataSize = segments[i].fileSize;
+
+        // Let the caller read directly from the image
+        if (!copy)
+        {
+            regions[c].data = (u8 *) m_image + segments[i].offset;
+            c++;
+            continue;
+        }
+        regions[c].data = new u8[segments[i].memorySize];
 
         // Read segment contents from file
         MemoryBlock::copy(regions[c].data, m_image + segments[i].offset,
@@ -57,10 +57,11 @@ class ELF : public ExecutableFormat
      * @param regions Memory regions to fill.
      * @param count Maximum number of memory regions on input.
      *              Actual number of memory regions on output.
+     * @param copy True to copy segment contents into new buffers.
      *
      * @return Result code.
      */
-    virtual Result regions(Region *regions, Size *count) const;
+    virtual Result regions(Region *regions, Size *count, bool copy = true) const;
 
     /**
      * Lookup the program entry point.
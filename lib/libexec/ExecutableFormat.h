@@ -58,6 +58,7 @@ class ExecutableFormat
         Size size;
         Memory::Access access;
         u8 *data;
+        Size dataSize; /**< Bytes of data from the image, the remainder is zero. */
     }
     Region;
 
@@ -93,10 +94,13 @@ class ExecutableFormat
      * @param regions Memory regions to fill.
      * @param count On input, the maximum number of regions to read.
      *              On output, the actual number of regions read.
+     * @param copy If true, each region receives a new zero-filled buffer
+     *             which the caller must delete. If false, data points
+     *             inside the program image and only dataSize bytes are valid.
      *
      * @return Result code.
      */
-    virtual Result regions(Region *regions, Size *count) const = 0;
+    virtual Result regions(Region *regions, Size *count, bool copy = true) const = 0;
 
     /**
      * Lookup the program entry point.
@@ -45,6 +45,16 @@ Error File::write(IOBuffer & buffer, Size size, Size offset)
     return ENOTSUP;
 }
 
+Error File::open(FileModes access)
+{
+    return ESUCCESS;
+}
+
+Error File::close(FileModes access)
+{
+    return ESUCCESS;
+}
+
 Error File::status(FileSystemMessage *msg)
 {
     FileStat st;
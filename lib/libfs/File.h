@@ -87,6 +87,26 @@ class File
      */
     virtual Error write(IOBuffer & buffer, Size size, Size offset);
 
+    /**
+     * Take a reference to the file.
+     *
+     * Only sent for files which count their users, such as pipes.
+     *
+     * @param access OwnerR for reading, OwnerW for writing or both.
+     *
+     * @return Error code
+     */
+    virtual Error open(FileModes access);
+
+    /**
+     * Release a reference taken with open().
+     *
+     * @param access Same access as given to open().
+     *
+     * @return Error code
+     */
+    virtual Error close(FileModes access);
+
     /**
      * Retrieve file statistics.
      *
@@ -39,6 +39,8 @@ FileSystem::FileSystem(const char *path)
     addIPCHandler(DeleteFile, &FileSystem::pathHandler, false);
     addIPCHandler(ReadFile,   &FileSystem::pathHandler, false);
     addIPCHandler(WriteFile,  &FileSystem::pathHandler, false);
+    addIPCHandler(OpenFile,   &FileSystem::pathHandler, false);
+    addIPCHandler(CloseFile,  &FileSystem::pathHandler, false);
 }
 
 FileSystem::~FileSystem()
@@ -182,7 +184,7 @@ Error FileSystem::processRequest(FileSystemRequest *req)
         msg->type = ChannelMessage::Response;
         msg->result = ENOENT;
         m_registry->getProducer(msg->from)->write(msg);
-        ProcessCtl(msg->from, Resume, 0);
+        ProcessCtl(msg->from, Handoff, 0);
         return msg->result;
     }
 
@@ -233,6 +235,16 @@ Error FileSystem::processRequest(FileSystemRequest *req)
             DEBUG(m_self << ": stat = " << (int)msg->result);
             break;
 
+        case OpenFile:
+            msg->result = file->open(msg->mode);
+            DEBUG(m_self << ": open = " << (int)msg->result);
+            break;
+
+        case CloseFile:
+            msg->result = file->close(msg->mode);
+            DEBUG(m_self << ": close = " << (int)msg->result);
+            break;
+
         case ReadFile:
             {
                 msg->result = file->read(req->getBuffer(), msg->size, msg->offset);
@@ -266,7 +278,7 @@ void FileSystem::sendResponse(FileSystemMessage *msg)
 {
     msg->type = ChannelMessage::Response;
     m_registry->getProducer(msg->from)->write(msg);
-    ProcessCtl(msg->from, Resume, 0);
+    ProcessCtl(msg->from, Handoff, 0);
 }
 
 void FileSystem::timeout()
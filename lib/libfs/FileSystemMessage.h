@@ -42,7 +42,9 @@ typedef enum FileSystemAction
     ReadFile,
     WriteFile,
     StatFile,
-    DeleteFile
+    DeleteFile,
+    OpenFile,
+    CloseFile
 }
 FileSystemAction;
 
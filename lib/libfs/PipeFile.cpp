@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <MemoryBlock.h>
+#include "PipeFile.h"
+
+PipeFile::PipeFile()
+    : File(FIFOFile)
+{
+    m_access = OwnerRW;
+    m_buffer = new u8[Capacity];
+    m_head    = 0;
+    m_readers = 0;
+    m_writers = 0;
+}
+
+PipeFile::~PipeFile()
+{
+    delete[] m_buffer;
+}
+
+Error PipeFile::open(FileModes access)
+{
+    if (access & OwnerR)
+        m_readers++;
+
+    if (access & OwnerW)
+        m_writers++;
+
+    return ESUCCESS;
+}
+
+Error PipeFile::close(FileModes access)
+{
+    if (((access & OwnerR) && !m_readers) || ((access & OwnerW) && !m_writers))
+        return EINVAL;
+
+    if (access & OwnerR)
+    {
+        // Nobody reads the buffered data anymore
+        if (--m_readers == 0)
+            m_size = 0;
+    }
+
+    if (access & OwnerW)
+        m_writers--;
+
+    return ESUCCESS;
+}
+
+Error PipeFile::read(IOBuffer & buffer, Size size, Size offset)
+{
+    if (size == 0)
+        return 0;
+
+    // Wait for a writer unless all writing ends are closed
+    if (m_size == 0)
+        return m_writers ? EAGAIN : 0;
+
+    const Size bytes = size < m_size ? size : m_size;
+    const Size first = bytes < Capacity - m_head ? bytes : Capacity - m_head;
+    Error r;
+
+    // Copy out at most two contiguous segments of the ring
+    if ((r = buffer.write(m_buffer + m_head, first)) < 0)
+        return r;
+
+    if (first < bytes && (r = buffer.write(m_buffer, bytes - first, first)) < 0)
+        return r;
+
+    m_head  = (m_head + bytes) % Capacity;
+    m_size -= bytes;
+    return bytes;
+}
+
+Error PipeFile::write(IOBuffer & buffer, Size size, Size offset)
+{
+    const Size space = Capacity - m_size;
+
+    if (size == 0)
+        return 0;
+
+    // Nobody reads the data anymore
+    if (!m_readers)
+        return EPIPE;
+
+    // Small writes are never split, large writes take what fits
+    if (space == 0 || (size <= Capacity && size > space))
+        return EAGAIN;
+
+    const Size bytes = size < space ? size : space;
+    const Size tail  = (m_head + m_size) % Capacity;
+    const Size first = bytes < Capacity - tail ? bytes : Capacity - tail;
+    const u8 *data   = buffer.getBuffer();
+
+    MemoryBlock::copy(m_buffer + tail, data, first);
+    MemoryBlock::copy(m_buffer, data + first, bytes - first);
+
+    m_size += bytes;
+    return bytes;
+}
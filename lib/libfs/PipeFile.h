@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIB_LIBFS_PIPEFILE_H
+#define __LIB_LIBFS_PIPEFILE_H
+
+#include <Types.h>
+#include "File.h"
+#include "IOBuffer.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libfs
+ * @{
+ */
+
+/**
+ * First-in-first-out pipe with a fixed size ring buffer.
+ *
+ * Readers receive EAGAIN while the pipe is empty, and writers
+ * receive EAGAIN while the pipe is full. The FileSystem queues such
+ * requests and retries them, which gives blocking semantics to both ends.
+ *
+ * The pipe counts the references to each end, taken with open() and
+ * released with close(). Once no writer is left, reads of the drained
+ * pipe return zero to signal end-of-file. Once no reader is left,
+ * buffered data is dropped and writes fail with EPIPE.
+ */
+class PipeFile : public File
+{
+  public:
+
+    /** Number of bytes the pipe can buffer. */
+    static const Size Capacity = 16384;
+
+  public:
+
+    /**
+     * Constructor.
+     */
+    PipeFile();
+
+    /**
+     * Destructor.
+     */
+    virtual ~PipeFile();
+
+    /**
+     * Take a reference to the reading and/or writing end.
+     *
+     * @param access OwnerR for the reading end, OwnerW for the writing end.
+     *
+     * @return Error code
+     */
+    virtual Error open(FileModes access);
+
+    /**
+     * Release a reference to the reading and/or writing end.
+     *
+     * @param access OwnerR for the reading end, OwnerW for the writing end.
+     *
+     * @return Error code. EINVAL if no such reference was taken.
+     */
+    virtual Error close(FileModes access);
+
+    /**
+     * Read bytes from the pipe.
+     *
+     * @param buffer Output buffer.
+     * @param size Number of bytes to read at maximum.
+     * @param offset Ignored.
+     *
+     * @return Number of bytes read, zero on end-of-file or EAGAIN if empty.
+     */
+    virtual Error read(IOBuffer & buffer, Size size, Size offset);
+
+    /**
+     * Write bytes to the pipe.
+     *
+     * Writes up to Capacity bytes are atomic: they are accepted entirely
+     * or not at all. Larger writes may be accepted partially, in which
+     * case the caller writes the remaining bytes again.
+     *
+     * @param buffer Input buffer to write bytes from.
+     * @param size Number of bytes to write.
+     * @param offset Ignored.
+     *
+     * @return Number of bytes written, EAGAIN if full or EPIPE if
+     *         the reading end is closed.
+     */
+    virtual Error write(IOBuffer & buffer, Size size, Size offset);
+
+  private:
+
+    /** Ring buffer storage. */
+    u8 *m_buffer;
+
+    /** Index of the first unread byte in the ring. */
+    Size m_head;
+
+    /** Number of references to the reading end. */
+    Size m_readers;
+
+    /** Number of references to the writing end. */
+    Size m_writers;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIB_LIBFS_PIPEFILE_H */
@@ -249,6 +249,21 @@ ChannelClient::Result ChannelClient::syncReceiveFrom(void *buffer, ProcessID pid
 }
 
 ChannelClient::Result ChannelClient::syncSendTo(void *buffer, ProcessID pid)
+{
+    return sendTo(buffer, pid, false);
+}
+
+ChannelClient::Result ChannelClient::syncSendReceive(void *buffer, ProcessID pid)
+{
+    // Switch to the receiver directly, as we only wait for its reply
+    Result r = sendTo(buffer, pid, true);
+    if (r != Success)
+        return r;
+
+    return syncReceiveFrom(buffer, pid);
+}
+
+ChannelClient::Result ChannelClient::sendTo(void *buffer, ProcessID pid, bool handoff)
 {
     Channel *ch = findProducer(pid);
     if (!ch)
@@ -259,7 +274,7 @@ ChannelClient::Result ChannelClient::syncSendTo(void *buffer, ProcessID pid)
         switch (ch->write(buffer))
         {
             case Channel::Success:
-                ProcessCtl(pid, Resume, 0);
+                ProcessCtl(pid, handoff ? Handoff : Resume, 0);
                 return Success;
 
             case Channel::ChannelFull:
@@ -273,12 +288,3 @@ ChannelClient::Result ChannelClient::syncSendTo(void *buffer, ProcessID pid)
     }
     return IOError;
 }
-
-ChannelClient::Result ChannelClient::syncSendReceive(void *buffer, ProcessID pid)
-{
-    Result r = syncSendTo(buffer, pid);
-    if (r != Success)
-        return r;
-
-    return syncReceiveFrom(buffer, pid);
-}
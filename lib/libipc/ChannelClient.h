@@ -214,6 +214,17 @@ class ChannelClient : public Singleton<ChannelClient>
      */
     Channel * findProducer(ProcessID pid);
 
+    /**
+     * Write a message to one process and wake it up.
+     *
+     * @param buffer Message buffer to send
+     * @param pid ProcessID for the channel
+     * @param handoff True to switch to the process directly after writing.
+     *
+     * @return Result code
+     */
+    Result sendTo(void *buffer, ProcessID pid, bool handoff);
+
   private:
 
     /** Contains registered channels */
@@ -66,6 +66,9 @@ template <class Base, class MsgType> class ChannelServer
 {
   protected:
 
+    /** Maximum number of kernel events read at once */
+    static const Size KernelEventBatch = 8;
+
     /** Member function pointer inside Base, to handle IPC messages. */
     typedef void (Base::*IPCHandlerFunction)(MsgType *);
 
@@ -141,6 +144,10 @@ template <class Base, class MsgType> class ChannelServer
      */
     int run()
     {
+        // Log lines are written out when going idle
+        if (Log::instance)
+            Log::instance->setDeferred(true);
+
         // Enter loop
         while (true)
         {
@@ -164,6 +171,9 @@ template <class Base, class MsgType> class ChannelServer
             if (m_expiry.frequency)
                 expiry = (Address) &m_expiry;
 
+            if (Log::instance)
+                Log::instance->flush();
+
             Error r = ProcessCtl(SELF, EnterSleep, expiry, (Address) &m_time);
             DEBUG("EnterSleep returned: " << (int)r);
 
@@ -289,44 +299,50 @@ template <class Base, class MsgType> class ChannelServer
      */
     Result readKernelEvents()
     {
-        ProcessEvent event;
+        ProcessEvent events[KernelEventBatch];
+        Size count;
 
-        // Try to read a message on the kernel event channel
-        while (m_kernelEvent.read(&event) == Channel::Success)
+        // Read messages in batches from the kernel event channel
+        while (m_kernelEvent.readBatch(events, KernelEventBatch, &count) == Channel::Success)
         {
-            DEBUG(m_self << ": got kernel event: " << (int) event.type);
-
-            switch (event.type)
+            for (Size i = 0; i < count; i++)
             {
-                case ShareCreated:
-                {
-                    DEBUG(m_self << ": share created for PID: " << event.share.pid);
-                    accept(event.share.pid, event.share.range);
-                    break;
-                }
-                case InterruptEvent:
-                {
-                    DEBUG(m_self << ": interrupt: " << event.number);
+                const ProcessEvent & event = events[i];
 
-                    if (m_irqHandlers->at(event.number))
+                DEBUG(m_self << ": got kernel event: " << (int) event.type);
+
+                switch (event.type)
+                {
+                    case ShareCreated:
                     {
-                        (m_instance->*(m_irqHandlers->at(event.number))->exec) (event.number);
+                        DEBUG(m_self << ": share created for PID: " << event.share.pid);
+                        accept(event.share.pid, event.share.range);
+                        break;
                     }
-                    break;
-                }
-                case ProcessTerminated:
-                {
-                    DEBUG(m_self << ": process terminated: PID " << event.number);
-                    m_registry->unregisterConsumer(event.number);
-                    m_registry->unregisterProducer(event.number);
+                    case InterruptEvent:
+                    {
+                        DEBUG(m_self << ": interrupt: " << event.number);
 
-                    // cleanup the VMShare area now for that process
-                    VMShare(event.number, API::Delete, ZERO);
-                    break;
+                        if (m_irqHandlers->at(event.number))
+                        {
+                            (m_instance->*(m_irqHandlers->at(event.number))->exec) (event.number);
+                        }
+                        break;
+                    }
+                    case ProcessTerminated:
+                    {
+                        DEBUG(m_self << ": process terminated: PID " << event.number);
+                        m_registry->unregisterConsumer(event.number);
+                        m_registry->unregisterProducer(event.number);
+
+                        // cleanup the VMShare area now for that process
+                        VMShare(event.number, API::Delete, ZERO);
+                        break;
+                    }
+                    default:
+                        DEBUG(m_self << ": ???\n");
+                        break;
                 }
-                default:
-                    DEBUG(m_self << ": ???\n");
-                    break;
             }
         }
         return Success;
@@ -381,7 +397,7 @@ template <class Base, class MsgType> class ChannelServer
                             ERROR(m_self << ": failed to send reply message to PID: " << i.key());
                         }
                         else
-                            ProcessCtl(i.key(), Resume, 0);
+                            ProcessCtl(i.key(), Handoff, 0);
                     }
                 }
             }
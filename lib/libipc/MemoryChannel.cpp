@@ -23,6 +23,7 @@ MemoryChannel::MemoryChannel()
     : Channel()
 {
     MemoryBlock::set(&m_head, 0, sizeof(m_head));
+    MemoryBlock::set(&m_remote, 0, sizeof(m_remote));
 }
 
 MemoryChannel::~MemoryChannel()
@@ -31,11 +32,11 @@ MemoryChannel::~MemoryChannel()
 
 MemoryChannel::Result MemoryChannel::setMessageSize(Size size)
 {
-    if (size < sizeof(RingHead) || size > (PAGESIZE / 2))
+    if (size < sizeof(RingHead) || size > ((PAGESIZE - HeadSize) / 2))
         return InvalidArgument;
 
     m_messageSize = size;
-    m_maximumMessages = (PAGESIZE / m_messageSize) - 1;
+    m_maximumMessages = (PAGESIZE - HeadSize) / m_messageSize;
 
     return Success;
 }
@@ -60,17 +61,18 @@ MemoryChannel::Result MemoryChannel::setPhysical(Address data, Address feedback)
 
 MemoryChannel::Result MemoryChannel::read(void *buffer)
 {
-    RingHead head;
+    // Re-read the producer ring head only if all known messages are consumed
+    if (m_head.index == m_remote.index)
+    {
+        m_data.read(0, sizeof(m_remote), &m_remote);
 
-    // Read the current ring head
-    m_data.read(0, sizeof(head), &head);
-
-    // Check if a message is present
-    if (head.index == m_head.index)
-        return NotFound;
+        // Check if a message is present
+        if (m_head.index == m_remote.index)
+            return NotFound;
+    }
 
     // Read one message
-    m_data.read((m_head.index+1) * m_messageSize, m_messageSize, buffer);
+    m_data.read(HeadSize + (m_head.index * m_messageSize), m_messageSize, buffer);
 
     // Increment head index
     m_head.index = (m_head.index + 1) % m_maximumMessages;
@@ -80,26 +82,63 @@ MemoryChannel::Result MemoryChannel::read(void *buffer)
     return Success;
 }
 
+MemoryChannel::Result MemoryChannel::readBatch(void *buffer, Size maximum, Size *count)
+{
+    u8 *output = (u8 *) buffer;
+
+    *count = 0;
+
+    // Re-read the producer ring head only if all known messages are consumed
+    if (m_head.index == m_remote.index)
+        m_data.read(0, sizeof(m_remote), &m_remote);
+
+    // Read messages until the ring is empty or the buffer is full
+    while (*count < maximum && m_head.index != m_remote.index)
+    {
+        m_data.read(HeadSize + (m_head.index * m_messageSize), m_messageSize, output);
+        m_head.index = (m_head.index + 1) % m_maximumMessages;
+        output += m_messageSize;
+        (*count)++;
+    }
+
+    if (*count == 0)
+        return NotFound;
+
+    // Update read index
+    m_feedback.write(0, sizeof(m_head), &m_head);
+    return Success;
+}
+
 MemoryChannel::Result MemoryChannel::write(void *buffer)
 {
-    RingHead reader;
+    const Size next = (m_head.index + 1) % m_maximumMessages;
 
-    // Read current ring head
-    m_feedback.read(0, sizeof(RingHead), &reader);
+    // Re-read the consumer index only if the ring appears to be full
+    if (next == m_remote.index)
+    {
+        m_feedback.read(0, sizeof(m_remote), &m_remote);
 
-    // Check if buffer space is available for the message
-    if (((m_head.index + 1) % m_maximumMessages) == reader.index)
-        return ChannelFull;
+        // Check if buffer space is available for the message
+        if (next == m_remote.index)
+            return ChannelFull;
+    }
 
     // write the message
-    m_data.write((m_head.index+1) * m_messageSize, m_messageSize, buffer);
+    m_data.write(HeadSize + (m_head.index * m_messageSize), m_messageSize, buffer);
 
-    // Increment write index
-    m_head.index = (m_head.index + 1) % m_maximumMessages;
+    // Publish the message by incrementing the write index
+    m_head.index = next;
     m_data.write(0, sizeof(m_head), &m_head);
     return Success;
 }
 
+Size MemoryChannel::pending()
+{
+    m_feedback.read(0, sizeof(m_remote), &m_remote);
+
+    return (m_head.index + m_maximumMessages - m_remote.index) % m_maximumMessages;
+}
+
 MemoryChannel::Result MemoryChannel::flush()
 {
     // Cannot flush caches in usermode. All usermode code
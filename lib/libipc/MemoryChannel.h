@@ -39,11 +39,20 @@
  * to the data page. The feedback page is written only by the
  * consumer, where it stores the feedback information from its
  * consumption, such as the total bytes read and status.
+ *
+ * The ring head occupies its own cache line at the start of the data
+ * page, such that the producer publishing the head does not invalidate
+ * the cache line containing the message the consumer is reading. Each side
+ * also keeps a local copy of the remote index and only re-reads the shared
+ * page when the ring appears to be empty (consumer) or full (producer).
  */
 class MemoryChannel : public Channel
 {
   private:
 
+    /** Size of the ring head area, padded to a full cache line. */
+    static const Size HeadSize = 64;
+
     /**
      * Defines in-memory ring header
      */
@@ -114,6 +123,28 @@ class MemoryChannel : public Channel
      */
     virtual Result read(void *buffer);
 
+    /**
+     * Read multiple messages at once.
+     *
+     * The read index is published once for all messages read.
+     *
+     * @param buffer Output buffer with room for at least maximum messages.
+     * @param maximum Maximum number of messages to read.
+     * @param count On output contains the number of messages read.
+     *
+     * @return Result code. NotFound if no message is present.
+     */
+    Result readBatch(void *buffer, Size maximum, Size *count);
+
+    /**
+     * Get the number of messages not yet read by the consumer.
+     *
+     * Only valid for the producer.
+     *
+     * @return Number of written messages which are unread.
+     */
+    Size pending();
+
     /**
      * Write a message.
      *
@@ -152,6 +183,9 @@ class MemoryChannel : public Channel
 
     /** Local RingHead. */
     RingHead m_head;
+
+    /** Last known index of the other side of the channel. */
+    RingHead m_remote;
 };
 
 /**
@@ -23,6 +23,7 @@ NetworkDevice::NetworkDevice(NetworkServer *server)
       m_transmit(1500)
 {
     m_maximumPacketSize = 1500;
+    m_checksumOffload = false;
     m_server = server;
     m_eth = 0;
     m_arp = 0;
@@ -76,6 +77,11 @@ const Size NetworkDevice::getMaximumPacketSize() const
     return m_maximumPacketSize;
 }
 
+const bool NetworkDevice::hasChecksumOffload() const
+{
+    return m_checksumOffload;
+}
+
 NetworkQueue * NetworkDevice::getReceiveQueue()
 {
     return &m_receive;
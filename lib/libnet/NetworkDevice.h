@@ -66,6 +66,13 @@ class NetworkDevice : public Device
      */
     const Size getMaximumPacketSize() const;
 
+    /**
+     * Check if the device calculates transport checksums.
+     *
+     * @return True if protocols only fill in the pseudo header checksum.
+     */
+    const bool hasChecksumOffload() const;
+
     /**
      * Read ethernet address.
      *
@@ -118,6 +125,9 @@ class NetworkDevice : public Device
     /** Maximum size of each packet */
     Size m_maximumPacketSize;
 
+    /** True if the device completes UDP checksums on transmit */
+    bool m_checksumOffload;
+
     NetworkQueue m_receive;
 
     NetworkQueue m_transmit;
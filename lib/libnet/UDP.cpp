@@ -116,9 +116,13 @@ Error UDP::sendPacket(NetworkClient::SocketInfo *src, IOBuffer & buffer, Size si
     // Insert payload. The payload is just after the 'dest' struct in the IOBuffer.
     buffer.read(pkt->data + pkt->size + sizeof(Header), size - sizeof(dest), sizeof(dest));
 
-    // Calculate final checksum
-    hdr->checksum = checksum((IPV4::Header *)(pkt->data + pkt->size - sizeof(IPV4::Header)),
-                             hdr, size - sizeof(dest));
+    // Calculate final checksum, or let the device complete it
+    const IPV4::Header *ip = (IPV4::Header *)(pkt->data + pkt->size - sizeof(IPV4::Header));
+
+    if (m_device->hasChecksumOffload())
+        hdr->checksum = pseudoChecksum(ip, size - sizeof(dest));
+    else
+        hdr->checksum = checksum(ip, hdr, size - sizeof(dest));
     DEBUG("checksum = " << (uint) hdr->checksum);
 
     // Increment packet size
@@ -158,6 +162,23 @@ const ulong UDP::calculateSum(const u16 *ptr, Size bytes)
 const u16 UDP::checksum(const IPV4::Header *ip,
                         const UDP::Header *udp,
                         const Size datalen)
+{
+    ulong sum = pseudoChecksum(ip, datalen);
+
+    // Sum the UDP header and payload
+    sum += calculateSum((u16 *) udp, sizeof(*udp) + datalen);
+
+    // Keep only last 16 bits and add carry bits
+    sum = (sum >> 16) + (sum & 0xffff);
+    sum += (sum >> 16);
+
+    // Take one's complement
+    sum = ~sum;
+    return (u16) sum;
+}
+
+const u16 UDP::pseudoChecksum(const IPV4::Header *ip,
+                              const Size datalen)
 {
     IPV4::PseudoHeader phr;
     ulong sum = 0;
@@ -172,13 +193,9 @@ const u16 UDP::checksum(const IPV4::Header *ip,
 
     // Sum the pseudo header
     sum += calculateSum((u16 *) &phr, sizeof(phr));
-    sum += calculateSum((u16 *) udp, sizeof(*udp) + datalen);
 
     // Keep only last 16 bits and add carry bits
     sum = (sum >> 16) + (sum & 0xffff);
     sum += (sum >> 16);
-
-    // Take one's complement
-    sum = ~sum;
     return (u16) sum;
 }
@@ -117,6 +117,19 @@ class UDP : public NetworkProtocol
                               const Header *header,
                               const Size datalen);
 
+    /**
+     * Calculate checksum of the IP pseudo header only
+     *
+     * Devices with checksum offload complete it over the UDP header and payload.
+     *
+     * @param ip IP header
+     * @param datalen Number of payload bytes after the UDP header
+     *
+     * @return One's complement sum of the pseudo header, not inverted
+     */
+    static const u16 pseudoChecksum(const IPV4::Header *ip,
+                                    const Size datalen);
+
   private:
 
     static const ulong calculateSum(const u16 *ptr,
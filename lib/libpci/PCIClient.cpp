@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include "PCIConfigOffset.h"
+#include "PCIClient.h"
+
+PCIClient::PCIClient(const char *path)
+    : m_path(path)
+    , m_fd(-1)
+{
+}
+
+PCIClient::~PCIClient()
+{
+    if (m_fd >= 0)
+        ::close(m_fd);
+}
+
+PCIClient::Result PCIClient::transfer(Size offset, void *data, Size size, bool write) const
+{
+    if (m_fd < 0 && (m_fd = ::open(m_path, O_RDWR)) < 0)
+        return NotFound;
+
+    if (::lseek(m_fd, offset, SEEK_SET) < 0)
+        return InvalidArgument;
+
+    const ssize_t result = write ? ::write(m_fd, data, size) : ::read(m_fd, data, size);
+    return result == (ssize_t) size ? Success : NotFound;
+}
+
+u32 PCIClient::readLong(const Function & func, u8 reg) const
+{
+    u32 value;
+
+    if (transfer(PCIConfigOffset::get(func, reg), &value, sizeof(value), false) != Success)
+        return 0xffffffff;
+
+    return value;
+}
+
+u16 PCIClient::readWord(const Function & func, u8 reg) const
+{
+    u16 value;
+
+    if (transfer(PCIConfigOffset::get(func, reg), &value, sizeof(value), false) != Success)
+        return 0xffff;
+
+    return value;
+}
+
+u8 PCIClient::readByte(const Function & func, u8 reg) const
+{
+    u8 value;
+
+    if (transfer(PCIConfigOffset::get(func, reg), &value, sizeof(value), false) != Success)
+        return 0xff;
+
+    return value;
+}
+
+void PCIClient::writeLong(const Function & func, u8 reg, u32 value)
+{
+    transfer(PCIConfigOffset::get(func, reg), &value, sizeof(value), true);
+}
+
+void PCIClient::writeWord(const Function & func, u8 reg, u16 value)
+{
+    transfer(PCIConfigOffset::get(func, reg), &value, sizeof(value), true);
+}
+
+PCIClient::Result PCIClient::find(u16 vendorId, u16 deviceId, Function *func, Size index) const
+{
+    for (Size i = 0; transfer(PCIConfigOffset::getDevice(i), func, sizeof(*func), false) == Success; i++)
+    {
+        if (func->vendorId == vendorId && func->deviceId == deviceId && index-- == 0)
+            return Success;
+    }
+    return NotFound;
+}
+
+PCIClient::Result PCIClient::findClass(u8 classCode, u8 subClass, u8 progIf, Function *func, Size index) const
+{
+    for (Size i = 0; transfer(PCIConfigOffset::getDevice(i), func, sizeof(*func), false) == Success; i++)
+    {
+        if (func->classCode == classCode && func->subClass == subClass &&
+            func->progIf == progIf && index-- == 0)
+            return Success;
+    }
+    return NotFound;
+}
+
+PCIClient::Result PCIClient::readBAR(const Function & func, Size index, BAR *bar)
+{
+    if (index >= BARs)
+        return InvalidArgument;
+
+    return transfer(PCIConfigOffset::get(func, index, PCIConfigOffset::BARSpace), bar, sizeof(*bar), false);
+}
+
+PCIClient::Result PCIClient::getMSIInterrupt(const Function & func, uint *irq) const
+{
+    return transfer(PCIConfigOffset::get(func, 0, PCIConfigOffset::MSISpace), irq, sizeof(*irq), false);
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBPCI_PCICLIENT_H
+#define __LIBPCI_PCICLIENT_H
+
+#include <Types.h>
+#include <intel/IntelPCI.h>
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libpci
+ * @{
+ */
+
+/**
+ * PCI configuration space access for drivers.
+ *
+ * Each register access is a request to the PCI server, which owns the
+ * configuration ports. Base address registers are decoded by the
+ * server as well, since decoding writes to the register.
+ *
+ * @see PCIConfigOffset
+ */
+class PCIClient : public IntelPCI
+{
+  public:
+
+    /**
+     * Constructor
+     *
+     * @param path Path to the configuration space file of the PCI server.
+     */
+    PCIClient(const char *path = "/dev/pci/config");
+
+    /**
+     * Destructor
+     */
+    virtual ~PCIClient();
+
+    /**
+     * Read 32-bit configuration register.
+     *
+     * @param func PCI function
+     * @param reg Register offset, aligned on 4 bytes
+     *
+     * @return Register value, or all ones on failure
+     */
+    virtual u32 readLong(const Function & func, u8 reg) const;
+
+    /**
+     * Read 16-bit configuration register.
+     *
+     * @param func PCI function
+     * @param reg Register offset, aligned on 2 bytes
+     *
+     * @return Register value, or all ones on failure
+     */
+    virtual u16 readWord(const Function & func, u8 reg) const;
+
+    /**
+     * Read 8-bit configuration register.
+     *
+     * @param func PCI function
+     * @param reg Register offset
+     *
+     * @return Register value, or all ones on failure
+     */
+    virtual u8 readByte(const Function & func, u8 reg) const;
+
+    /**
+     * Write 32-bit configuration register.
+     *
+     * @param func PCI function
+     * @param reg Register offset, aligned on 4 bytes
+     * @param value New register value
+     */
+    virtual void writeLong(const Function & func, u8 reg, u32 value);
+
+    /**
+     * Write 16-bit configuration register.
+     *
+     * @param func PCI function
+     * @param reg Register offset, aligned on 2 bytes
+     * @param value New register value
+     */
+    virtual void writeWord(const Function & func, u8 reg, u16 value);
+
+    /**
+     * Find a function by vendor and device identifier.
+     *
+     * Reads the functions found by the PCI server, instead of probing
+     * every bus and slot.
+     *
+     * @param vendorId Vendor identifier
+     * @param deviceId Device identifier
+     * @param func Output function
+     * @param index Return the index'th match
+     *
+     * @return Result code
+     */
+    virtual Result find(u16 vendorId, u16 deviceId, Function *func, Size index = 0) const;
+
+    /**
+     * Find a function by class code.
+     *
+     * Reads the functions found by the PCI server, instead of probing
+     * every bus and slot.
+     *
+     * @param classCode Base class code
+     * @param subClass Sub class code
+     * @param progIf Programming interface
+     * @param func Output function
+     * @param index Return the index'th match
+     *
+     * @return Result code
+     */
+    virtual Result findClass(u8 classCode, u8 subClass, u8 progIf, Function *func, Size index = 0) const;
+
+    /**
+     * Decode a base address register.
+     *
+     * @param func PCI function
+     * @param index BAR number
+     * @param bar Output BAR
+     *
+     * @return Result code. NotFound if the BAR is unused or cannot be mapped.
+     */
+    virtual Result readBAR(const Function & func, Size index, BAR *bar);
+
+    /**
+     * Get the interrupt number to use for MSI.
+     *
+     * @param func PCI function
+     * @param irq Output interrupt number, relative to the APIC interrupt base.
+     *
+     * @return Result code. NotFound if the PCI server assigned none.
+     */
+    Result getMSIInterrupt(const Function & func, uint *irq) const;
+
+  private:
+
+    /**
+     * Transfer bytes from or to the configuration space file.
+     *
+     * @param offset File offset
+     * @param data Data to read into or write from
+     * @param size Number of bytes
+     * @param write True to write, false to read
+     *
+     * @return Result code
+     */
+    Result transfer(Size offset, void *data, Size size, bool write) const;
+
+  private:
+
+    /** Path to the configuration space file */
+    const char *m_path;
+
+    /** File descriptor of the configuration space file, or -1 if not yet opened */
+    mutable int m_fd;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBPCI_PCICLIENT_H */
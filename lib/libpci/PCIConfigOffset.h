@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBPCI_PCICONFIGOFFSET_H
+#define __LIBPCI_PCICONFIGOFFSET_H
+
+#include <Types.h>
+#include <intel/IntelPCI.h>
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libpci
+ * @{
+ */
+
+/**
+ * Layout of file offsets in the configuration space file of the PCI server.
+ *
+ * The lower 24 bits use the same layout as the configuration address port:
+ * bus, slot, function and register. The upper bits select what is accessed
+ * instead of a register.
+ */
+class PCIConfigOffset
+{
+  public:
+
+    /**
+     * Offset bits selecting what to access.
+     */
+    enum Space
+    {
+        /** Configuration register of a function */
+        RegisterSpace = 0,
+
+        /** Decoded IntelPCI::BAR. The register bits hold the BAR number. */
+        BARSpace      = (1 << 24),
+
+        /** Interrupt number to use for MSI */
+        MSISpace      = (1 << 25),
+
+        /** IntelPCI::Function found by the server. The lower bits hold its index. */
+        DeviceSpace   = (1 << 26)
+    };
+
+    /** Mask of the bits selecting a function and register */
+    static const Size AddressMask = 0xffffff;
+
+  public:
+
+    /**
+     * Get the file offset of a register.
+     *
+     * @param func PCI function
+     * @param reg Register offset, or BAR number for BARSpace
+     * @param space Space to access
+     *
+     * @return File offset
+     */
+    static Size get(const IntelPCI::Function & func, u8 reg, Space space = RegisterSpace)
+    {
+        return space | (func.bus << 16) | (func.slot << 11) | (func.function << 8) | reg;
+    }
+
+    /**
+     * Get the file offset of a function found by the server.
+     *
+     * @param index Index of the function
+     *
+     * @return File offset
+     */
+    static Size getDevice(Size index)
+    {
+        return DeviceSpace | (index & AddressMask);
+    }
+
+    /**
+     * Decode the function from a file offset.
+     *
+     * Only the bus, slot and function are filled in.
+     *
+     * @param offset File offset
+     * @param func Output function
+     */
+    static void getFunction(Size offset, IntelPCI::Function *func)
+    {
+        func->bus      = (offset >> 16) & 0xff;
+        func->slot     = (offset >> 11) & 0x1f;
+        func->function = (offset >> 8) & 0x7;
+    }
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBPCI_PCICONFIGOFFSET_H */
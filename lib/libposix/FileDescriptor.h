@@ -22,6 +22,7 @@
 #include <Macros.h>
 #include <String.h>
 #include <string.h>
+#include <FileMode.h>
 #include "limits.h"
 
 /**
@@ -47,6 +48,7 @@ class FileDescriptor
         path[0]  = ZERO;
         position = 0;
         open     = false;
+        access   = 0;
     }
 
     FileDescriptor(const FileDescriptor & fd)
@@ -54,6 +56,7 @@ class FileDescriptor
         mount    = fd.mount;
         position = fd.position;
         open     = fd.open;
+        access   = fd.access;
         strlcpy(path, fd.path, PATH_MAX);
     }
 
@@ -81,6 +84,9 @@ class FileDescriptor
 
     /** State of the file descriptor. */
     bool open;
+
+    /** References to a pipe taken by open() and released by close(), or zero. */
+    FileModes access;
 };
 
 /**
@@ -73,10 +73,23 @@ int open(const char *path, int oflag, ...)
             {
                 if (!files[i].open)
                 {
+                    // Pipes count the references to each end
+                    if (st.type == FIFOFile)
+                    {
+                        msg.type   = ChannelMessage::Request;
+                        msg.action = OpenFile;
+                        msg.mode   = ((oflag & (O_RDONLY | O_RDWR)) ? OwnerR : 0) |
+                                     ((oflag & (O_WRONLY | O_RDWR)) ? OwnerW : 0);
+                        ChannelClient::instance->syncSendReceive(&msg, mnt);
+
+                        if ((errno = msg.result) != ESUCCESS)
+                            return -1;
+                    }
                     files[i].open  = true;
                     files[i].mount = mnt;
                     files[i].identifier = 0;
                     files[i].position = 0;
+                    files[i].access = st.type == FIFOFile ? msg.mode : 0;
                     strlcpy(files[i].path, fullpath, PATH_MAX);
                     return i;
                 }
@@ -267,6 +267,19 @@ extern C int stat(const char *path, struct stat *buf);
  */
 extern C int mknod(const char *path, mode_t mode, dev_t dev);
 
+/**
+ * @brief Make a FIFO special file.
+ *
+ * @param path Full path to the FIFO to create.
+ * @param mode Initial access permissions on the FIFO.
+ *
+ * @return Upon successful completion, these functions shall return 0.
+ *         Otherwise, these functions shall return -1 and set errno to
+ *         indicate the error. If -1 is returned, no FIFO shall
+ *         be created.
+ */
+extern C int mkfifo(const char *path, mode_t mode);
+
 /**
  * @brief Create a new directory.
  *
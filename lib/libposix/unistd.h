@@ -151,6 +151,21 @@ extern C int forkexec(const char *path, const char *argv[]);
  */
 extern C int spawn(Address program, Size programSize, const char *command);
 
+/**
+ * @brief Create a new process using in-memory image and argument list.
+ *
+ * Program regions are copied directly from the image. Arguments, the
+ * current directory and file descriptors are passed in a single copy.
+ *
+ * @param program In-memory executable to run
+ * @param programSize number of bytes of the executable
+ * @param argv Argument list pointer.
+ *
+ * @return New process ID on success and -1 on failure.
+ * @note  Errno is set with the appropriate error code on failure.
+ */
+extern C int spawnv(Address program, Size programSize, const char *argv[]);
+
 /**
  * @brief Get name of current host.
  *
@@ -24,6 +24,7 @@
 int close(int fildes)
 {
     FileDescriptor *files = getFiles();
+    FileSystemMessage msg;
 
     if (fildes >= FILE_DESCRIPTOR_MAX || fildes < 0)
     {
@@ -38,5 +39,23 @@ int close(int fildes)
     }
 
     files[fildes].open = false;
+
+    // Release the reference to the pipe
+    if (files[fildes].access)
+    {
+        msg.type   = ChannelMessage::Request;
+        msg.action = CloseFile;
+        msg.path   = files[fildes].path;
+        msg.mode   = files[fildes].access;
+        msg.from   = SELF;
+        files[fildes].access = 0;
+        ChannelClient::instance->syncSendReceive(&msg, files[fildes].mount);
+
+        if (msg.result != ESUCCESS)
+        {
+            errno = msg.result;
+            return -1;
+        }
+    }
     return 0;
 }
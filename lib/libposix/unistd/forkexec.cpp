@@ -16,156 +16,61 @@
  */
 
 #include <FreeNOS/System.h>
-#include <ExecutableFormat.h>
+#include <FileSystemMessage.h>
 #include <Types.h>
 #include <Runtime.h>
 #include <string.h>
+#include <stdio.h>
 #include <sys/stat.h>
 #include <errno.h>
-#include <fcntl.h>
 #include "unistd.h"
 
 int forkexec(const char *path, const char *argv[])
 {
-    ExecutableFormat *fmt;
-    ExecutableFormat::Region regions[16];
-    Memory::Range range;
-    Arch::MemoryMap map;
-    uint count = 0;
-    pid_t pid = 0;
-    Size numRegions = 16;
-    int fd;
+    FileSystemMessage msg;
+    ProcessID mnt = findMount(path);
+    char fullpath[PATH_MAX];
     struct stat st;
     u8 *image;
-    Address entry;
+    int pid;
 
     // Find program image
     if (stat(path, &st) != 0)
         return -1;
 
-    // Open program image
-    if ((fd = open(path, O_RDONLY)) < 0)
-        return -1;
-
-    // Read the program image
-    image = new u8[st.st_size];
-    if (read(fd, image, st.st_size) != st.st_size)
-    {
-        delete image;
-        close(fd);
-        return -1;
-    }
-    close(fd);
-
-    // Attempt to read executable format
-    if (ExecutableFormat::find(image, st.st_size, &fmt) != ExecutableFormat::Success)
+    // Relative or absolute?
+    if (path[0] != '/')
     {
-        delete image;
-        errno = ENOEXEC;
-        return -1;
-    }
+        char cwd[PATH_MAX];
 
-    // Retrieve entry point
-    if (fmt->entry(&entry) != ExecutableFormat::Success)
-    {
-        delete fmt;
-        delete image;
-        errno = ENOEXEC;
-        return -1;
-    }
-
-    // Create new process
-    pid = ProcessCtl(ANY, Spawn, entry);
-    if (pid == (pid_t) -1)
-    {
-        delete fmt;
-        delete image;
-        errno = EIO;
-        return -1;
-    }
-
-    // Retrieve memory regions
-    if (fmt->regions(regions, &numRegions) != ExecutableFormat::Success)
-    {
-        delete fmt;
-        delete image;
-        errno = ENOEXEC;
-        return -1;
+        // What's the current working dir?
+        getcwd(cwd, PATH_MAX);
+        snprintf(fullpath, sizeof(fullpath), "%s/%s", cwd, path);
     }
+    else
+        strlcpy(fullpath, path, sizeof(fullpath));
 
-    // Not needed anymore
-    delete fmt;
-    delete image;
-
-    // Map program regions into virtual memory of the new process
-    for (Size i = 0; i < numRegions; i++)
-    {
-        // Copy executable memory from this region
-        range.virt   = regions[i].virt;
-        range.phys   = ZERO;
-        range.size   = regions[i].size;
-        range.access = Memory::User |
-                       Memory::Readable |
-                       Memory::Writable |
-                       Memory::Executable;
-
-        // Create mapping first
-        if (VMCtl(pid, Map, &range) != 0)
-        {
-            errno = EFAULT;
-            return -1;
-        }
-        // Copy bytes
-        VMCopy(pid, API::Write, (Address) regions[i].data,
-               regions[i].virt, regions[i].size);
-
-        // Release buffer
-        delete regions[i].data;
-    }
-
-    // Create mapping for command-line arguments
-    range = map.range(MemoryMap::UserArgs);
-    range.phys = ZERO;
-    range.access = Memory::User | Memory::Readable | Memory::Writable;
-    VMCtl(pid, Map, &range);
-
-    // Allocate arguments and current working directory
-    char *arguments = new char[PAGESIZE*2];
-    memset(arguments, 0, PAGESIZE);
-
-    // Fill in arguments
-    while (argv[count] && count < PAGESIZE / ARGV_SIZE)
-    {
-        strlcpy(arguments + (ARGV_SIZE * count), argv[count], ARGV_SIZE);
-        count++;
-    }
-
-    // Fill in the current working directory
-    strlcpy(arguments + PAGESIZE, **(getCurrentDirectory()), PATH_MAX);
-
-    // Copy argc/argv into the new process
-    if ((VMCopy(pid, API::Write, (Address) arguments, range.virt, PAGESIZE * 2)) < 0)
-    {
-        delete[] arguments;
-        errno = EFAULT;
-        ProcessCtl(pid, KillPID);
-        return -1;
-    }
-
-    // Copy fds into the new process.
-    if ((VMCopy(pid, API::Write, (Address) getFiles(),
-                range.virt + (PAGESIZE * 2), range.size - (PAGESIZE * 2))) < 0)
+    // Read the program image in one request, without opening a file descriptor
+    image = new u8[st.st_size];
+    msg.type   = ChannelMessage::Request;
+    msg.action = ReadFile;
+    msg.path   = fullpath;
+    msg.buffer = (char *) image;
+    msg.size   = st.st_size;
+    msg.offset = 0;
+    msg.from   = SELF;
+    msg.deviceID.minor = 0;
+    ChannelClient::instance->syncSendReceive(&msg, mnt);
+
+    if (msg.result != st.st_size)
     {
-        delete[] arguments;
-        errno = EFAULT;
-        ProcessCtl(pid, KillPID);
+        delete[] image;
+        errno = msg.result < 0 ? msg.result : EIO;
         return -1;
     }
 
-    // Let the Child begin execution
-    ProcessCtl(pid, Resume);
-
-    // Done. Cleanup.
-    delete[] arguments;
+    // Create the process directly from the image
+    pid = spawnv((Address) image, st.st_size, argv);
+    delete[] image;
     return pid;
 }
@@ -23,13 +23,11 @@
 #include <errno.h>
 #include "unistd.h"
 
-int spawn(Address program, Size programSize, const char *command)
+int spawnv(Address program, Size programSize, const char *argv[])
 {
     ExecutableFormat *fmt;
     ExecutableFormat::Region regions[16];
-    Arch::MemoryMap map;
     Memory::Range range;
-    uint count = 0;
     pid_t pid = 0;
     Size numRegions = 16;
     Address entry;
@@ -41,37 +39,27 @@ int spawn(Address program, Size programSize, const char *command)
         return -1;
     }
 
-    // Find entry point
-    if (fmt->entry(&entry) != ExecutableFormat::Success)
+    // Find entry point and memory regions. Region data points inside the image.
+    if (fmt->entry(&entry) != ExecutableFormat::Success ||
+        fmt->regions(regions, &numRegions, false) != ExecutableFormat::Success)
     {
         delete fmt;
         errno = ENOEXEC;
         return -1;
     }
+    delete fmt;
 
     // Create new process
     pid = ProcessCtl(ANY, Spawn, entry);
     if (pid == (pid_t) -1)
     {
-        delete fmt;
         errno = EIO;
         return -1;
     }
 
-    // Retrieve memory regions
-    if (fmt->regions(regions, &numRegions) != ExecutableFormat::Success)
-    {
-        delete fmt;
-        errno = ENOEXEC;
-        return -1;
-    }
-    // Release buffers
-    delete fmt;
-
     // Map program regions into virtual memory of the new process
     for (Size i = 0; i < numRegions; i++)
     {
-        // Copy executable memory from this region
         range.virt   = regions[i].virt;
         range.phys   = ZERO;
         range.size   = regions[i].size;
@@ -81,59 +69,68 @@ int spawn(Address program, Size programSize, const char *command)
                        Memory::Executable;
 
         // Create mapping first
-        if (VMCtl(pid, Map, &range) != 0)
+        if (VMCtl(pid, Map, &range) != API::Success)
         {
+            ProcessCtl(pid, KillPID);
             errno = EFAULT;
             return -1;
         }
 
-        // Copy bytes
+        // Copy bytes straight from the image
         VMCopy(pid, API::Write, (Address) regions[i].data,
-               regions[i].virt, regions[i].size);
-
-        // Release data buffer
-        delete regions[i].data;
-    }
+               regions[i].virt, regions[i].dataSize);
 
-    // Create mapping for command-line arguments
-    range = map.range(MemoryMap::UserArgs);
-    range.phys = ZERO;
-    range.access = Memory::User | Memory::Readable | Memory::Writable;
-    VMCtl(pid, Map, &range);
-
-    // Allocate arguments
-    char *arguments = new char[PAGESIZE * 2];
-    char *arg = (char *)command;
-    memset(arguments, 0, PAGESIZE * 2);
-
-    // Fill in arguments
-    while (*command && count < PAGESIZE / ARGV_SIZE)
-    {
-        if (*command == ' ')
+        // Clear the remaining bytes
+        if (regions[i].size > regions[i].dataSize)
         {
-            strlcpy(arguments + (ARGV_SIZE * count), arg, command-arg+1);
-            count++;
-            arg = (char *)(command+1);
+            const Size zeroSize = regions[i].size - regions[i].dataSize;
+            u8 *zero = new u8[zeroSize];
+
+            memset(zero, 0, zeroSize);
+            VMCopy(pid, API::Write, (Address) zero,
+                   regions[i].virt + regions[i].dataSize, zeroSize);
+            delete[] zero;
         }
-        command++;
     }
 
-    // The last argument
-    strlcpy(arguments + (ARGV_SIZE * count), arg, command-arg+1);
-
-    // Copy argc/argv into the new process
-    if ((VMCopy(pid, API::Write, (Address) arguments, range.virt, PAGESIZE * 2)) < 0)
+    // Pass arguments, current directory and file descriptors
+    if (!setupArguments(pid, argv))
     {
-        delete[] arguments;
-        errno = EFAULT;
         ProcessCtl(pid, KillPID);
+        errno = EFAULT;
         return -1;
     }
 
     // Let the Child begin execution
     ProcessCtl(pid, Resume);
+    return pid;
+}
+
+int spawn(Address program, Size programSize, const char *command)
+{
+    const char *argv[ARGV_COUNT + 1];
+    char *line = new char[strlen(command) + 1];
+    Size count = 0;
+    int pid;
+
+    // Split the command line into arguments
+    strlcpy(line, command, strlen(command) + 1);
+
+    for (char *c = line; *c && count < ARGV_COUNT; )
+    {
+        while (*c == ' ')
+            *c++ = ZERO;
+
+        if (*c)
+            argv[count++] = c;
+
+        while (*c && *c != ' ')
+            c++;
+    }
+
+    argv[count] = ZERO;
 
-    // Done. Cleanup.
-    delete[] arguments;
+    pid = spawnv(program, programSize, argv);
+    delete[] line;
     return pid;
 }
@@ -25,6 +25,7 @@ ssize_t write(int fildes, const void *buf, size_t nbyte)
 {
     FileSystemMessage msg;
     FileDescriptor *files = getFiles();
+    size_t written = 0;
 
     if (fildes >= FILE_DESCRIPTOR_MAX || fildes < 0)
     {
@@ -39,23 +40,31 @@ ssize_t write(int fildes, const void *buf, size_t nbyte)
         return -1;
     }
 
-    // Write the file
-    msg.type   = ChannelMessage::Request;
-    msg.action = WriteFile;
-    msg.path   = files[fildes].path;
-    msg.buffer = (char *) buf;
-    msg.size   = nbyte;
-    msg.offset = files[fildes].position;
-    msg.from   = SELF;
-    msg.deviceID.minor = files[fildes].identifier;
-    ChannelClient::instance->syncSendReceive(&msg, files[fildes].mount);
-
-    // Did we write something?
-    if (msg.result >= 0)
+    // Write the file. Pipes may accept a part, so continue with the rest.
+    do
     {
-        files[fildes].position += msg.result;
-        return msg.result;
+        msg.type   = ChannelMessage::Request;
+        msg.action = WriteFile;
+        msg.path   = files[fildes].path;
+        msg.buffer = (char *) buf + written;
+        msg.size   = nbyte - written;
+        msg.offset = files[fildes].position;
+        msg.from   = SELF;
+        msg.deviceID.minor = files[fildes].identifier;
+        ChannelClient::instance->syncSendReceive(&msg, files[fildes].mount);
+
+        // Did we write something?
+        if (msg.result > 0)
+        {
+            files[fildes].position += msg.result;
+            written += msg.result;
+        }
     }
+    while (msg.result > 0 && written < nbyte);
+
+    // Report an error only if nothing was written
+    if (msg.result >= 0 || written > 0)
+        return written;
 
     // Set error number
     errno = msg.result;
@@ -170,6 +170,66 @@ void setupMappings()
         memset(files, 0, argRange.size - (PAGESIZE * 2));
         (*currentDirectory) = "/";
     }
+    // The parent only copies descriptors up to the last open one
+    else
+    {
+        Size count = *(Size *) (argRange.virt + ARGV_FILES_OFFSET);
+
+        if (count > FILE_DESCRIPTOR_MAX)
+            count = FILE_DESCRIPTOR_MAX;
+
+        memset(files + count, 0, sizeof(FileDescriptor) * (FILE_DESCRIPTOR_MAX - count));
+    }
+}
+
+bool setupArguments(ProcessID pid, const char **argv)
+{
+    Arch::MemoryMap map;
+    Memory::Range range = map.range(MemoryMap::UserArgs);
+    Size count = 0;
+    char *block;
+    bool ok;
+
+    // Find the last open file descriptor
+    for (Size i = 0; files != NULL && i < FILE_DESCRIPTOR_MAX; i++)
+    {
+        if (files[i].open)
+            count = i + 1;
+    }
+    const Size total = (PAGESIZE * 2) + (sizeof(FileDescriptor) * count);
+
+    // Create mapping for command-line arguments
+    range.phys   = ZERO;
+    range.access = Memory::User | Memory::Readable | Memory::Writable;
+
+    if (VMCtl(pid, Map, &range) != API::Success)
+        return false;
+
+    // Fill in arguments, current directory and file descriptors
+    block = new char[total];
+    memset(block, 0, PAGESIZE * 2);
+
+    for (Size i = 0; argv[i] && i < ARGV_COUNT; i++)
+        strlcpy(block + (ARGV_SIZE * i), argv[i], ARGV_SIZE);
+
+    strlcpy(block + PAGESIZE, **currentDirectory, PATH_MAX);
+    MemoryBlock::copy(block + ARGV_FILES_OFFSET, &count, sizeof(count));
+
+    if (count)
+    {
+        FileDescriptor *childFiles = (FileDescriptor *) (block + (PAGESIZE * 2));
+
+        MemoryBlock::copy(childFiles, files, sizeof(FileDescriptor) * count);
+
+        // References to pipes stay with this process, which releases them
+        for (Size i = 0; i < count; i++)
+            childFiles[i].access = 0;
+    }
+
+    // Transfer all at once
+    ok = VMCopy(pid, API::Write, (Address) block, range.virt, total) == (API::Result) total;
+    delete[] block;
+    return ok;
 }
 
 ProcessID findMount(const char *path)
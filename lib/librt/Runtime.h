@@ -40,6 +40,9 @@
 /** Number of arguments at maximum. */
 #define ARGV_COUNT (PAGESIZE / ARGV_SIZE)
 
+/** Offset of the number of inherited file descriptors in the arguments region. */
+#define ARGV_FILES_OFFSET ((PAGESIZE * 2) - sizeof(Size))
+
 /**
  * Program entry point.
  *
@@ -84,6 +87,20 @@ void refreshMounts(const char *path);
  */
 void waitMount(const char *path);
 
+/**
+ * Map and fill the arguments region of a new process.
+ *
+ * Arguments, the current directory and the used part of the file
+ * descriptors table are transferred with a single VMCopy. The new
+ * process clears the remaining file descriptors itself.
+ *
+ * @param pid ProcessID of the new process.
+ * @param argv Argument values, terminated by ZERO.
+ *
+ * @return True on success and false otherwise.
+ */
+bool setupArguments(ProcessID pid, const char **argv);
+
 /**
  * Get File Descriptors table.
  *
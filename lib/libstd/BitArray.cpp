@@ -90,6 +90,29 @@ void BitArray::setRange(Size from, Size to)
         set(i, true);
 }
 
+void BitArray::unsetRange(Size from, Size to)
+{
+    if (to >= m_size)
+        to = m_size - 1;
+
+    // Clear bits one-by-one until byte aligned
+    for (; from <= to && (from % 8); from++)
+        set(from, false);
+
+    // Clear whole bytes
+    for (; from + 7 <= to; from += 8)
+    {
+        for (u8 byte = m_array[from / 8]; byte; byte &= byte - 1)
+            m_set--;
+
+        m_array[from / 8] = 0;
+    }
+
+    // Clear remaining bits
+    for (; from <= to; from++)
+        set(from, false);
+}
+
 BitArray::Result BitArray::setNext(Size *bit, Size count, Size start, Size boundary)
 {
     Size from = 0, found = 0;
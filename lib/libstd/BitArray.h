@@ -97,6 +97,14 @@ class BitArray
      */
     void setRange(Size from, Size to);
 
+    /**
+     * Set a range of bits inside the map to 0.
+     *
+     * @param from Bit to start with.
+     * @param to End bit (inclusive).
+     */
+    void unsetRange(Size from, Size to);
+
     /**
      * Sets the next unset bit(s).
      *
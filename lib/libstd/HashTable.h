@@ -30,6 +30,9 @@
 /** Default size of the HashTable internal table. */
 #define HASHTABLE_DEFAULT_SIZE    64
 
+/** Grow the internal table when it holds more items than this per bucket. */
+#define HASHTABLE_LOAD_FACTOR     2
+
 /**
  * @addtogroup lib
  * @{
@@ -150,6 +153,7 @@ template <class K, class V> class HashTable : public Associative<K,V>
         // Key does not exist. Append it.
         m_table[idx].append(Bucket(key, value));
         m_count++;
+        grow();
         return true;
     }
 
@@ -169,6 +173,7 @@ template <class K, class V> class HashTable : public Associative<K,V>
         // Always append
         m_table[hash(key, m_table.size())].append(Bucket(key, value));
         m_count++;
+        grow();
         return true;
     }
 
@@ -197,6 +202,28 @@ template <class K, class V> class HashTable : public Associative<K,V>
         return removed;
     }
 
+    /**
+     * Remove a single key/value pair.
+     *
+     * @param key Associated key.
+     * @param value Value to remove.
+     *
+     * @return True if removed, false if not found.
+     */
+    virtual bool remove(const K & key, const V & value)
+    {
+        for (ListIterator<Bucket> i(m_table[hash(key, m_table.size())]); i.hasCurrent(); i++)
+        {
+            if (i.current().key == key && i.current().value == value)
+            {
+                i.remove();
+                m_count--;
+                return true;
+            }
+        }
+        return false;
+    }
+
     /**
      * Get the size of the HashTable.
      *
@@ -227,10 +254,19 @@ template <class K, class V> class HashTable : public Associative<K,V>
         List<K> lst;
 
         for (Size i = 0; i < m_table.count(); i++)
+        {
+            // Equal keys share a bucket, so duplicates are only searched there
+            List<K> bucketKeys;
+
             for (ListIterator<Bucket> j(m_table[i]); j.hasCurrent(); j++)
-                if (!lst.contains(j.current().key))
+            {
+                if (!bucketKeys.contains(j.current().key))
+                {
+                    bucketKeys << j.current().key;
                     lst << j.current().key;
-
+                }
+            }
+        }
         return lst;
     }
 
@@ -242,10 +278,18 @@ template <class K, class V> class HashTable : public Associative<K,V>
         List<K> lst;
 
         for (Size i = 0; i < m_table.count(); i++)
+        {
+            List<K> bucketKeys;
+
             for (ListIterator<Bucket> j(m_table[i]); j.hasCurrent(); j++)
-                if (j.current().value == value && !lst.contains(j.current().key))
+            {
+                if (j.current().value == value && !bucketKeys.contains(j.current().key))
+                {
+                    bucketKeys << j.current().key;
                     lst << j.current().key;
-
+                }
+            }
+        }
         return lst;
     }
 
@@ -365,6 +409,39 @@ template <class K, class V> class HashTable : public Associative<K,V>
 
   private:
 
+    /**
+     * Double the internal table when it is too full.
+     *
+     * Keeps the Bucket Lists short, such that lookups take constant time.
+     * All items are moved out first, because a List cannot be copied by
+     * assignment when the Vector resizes.
+     */
+    void grow()
+    {
+        const Size size = m_table.size() * 2;
+        List<Bucket> items;
+
+        if (m_count <= m_table.size() * HASHTABLE_LOAD_FACTOR)
+            return;
+
+        for (Size i = 0; i < m_table.count(); i++)
+        {
+            for (ListIterator<Bucket> j(m_table[i]); j.hasCurrent(); j++)
+                items.append(j.current());
+
+            m_table[i].clear();
+        }
+
+        if (m_table.resize(size))
+        {
+            for (Size i = m_table.count(); i < size; i++)
+                m_table.insert(i, List<Bucket>());
+        }
+
+        for (ListIterator<Bucket> i(items); i.hasCurrent(); i++)
+            m_table[hash(i.current().key, m_table.size())].append(i.current());
+    }
+
     /** Internal table. */
     Vector<List<Bucket> > m_table;
 
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IntervalSet.h"
+
+IntervalSet::IntervalSet(Size size)
+{
+    m_size  = size ? size : 1;
+    m_count = 0;
+    m_array = ZERO;
+}
+
+IntervalSet::~IntervalSet()
+{
+    if (m_array)
+        delete[] m_array;
+}
+
+IntervalSet::Result IntervalSet::insert(Address base, Size size)
+{
+    Address end = base + size;
+
+    if (!size || end < base)
+        return InvalidArgument;
+
+    // Merge with all overlapping and adjacent intervals
+    Size first = search(base);
+    if (first > 0 && m_array[first - 1].base + m_array[first - 1].size == base)
+        first--;
+
+    Size last = first;
+    while (last < m_count && m_array[last].base <= end)
+    {
+        const Interval & i = m_array[last];
+
+        if (i.base < base)
+            base = i.base;
+        if (i.base + i.size > end)
+            end = i.base + i.size;
+        last++;
+    }
+
+    Interval merged = { base, (Size) (end - base) };
+    return replace(first, last - first, &merged, 1);
+}
+
+IntervalSet::Result IntervalSet::remove(Address base, Size size)
+{
+    const Address end = base + size;
+    Interval pieces[2];
+    Size num = 0;
+
+    if (!size || end < base)
+        return InvalidArgument;
+
+    Size first = search(base);
+    Size last = first;
+
+    while (last < m_count && m_array[last].base < end)
+        last++;
+
+    if (first == last)
+        return Success;
+
+    // Keep the parts outside of the removed interval
+    if (m_array[first].base < base)
+    {
+        pieces[num].base = m_array[first].base;
+        pieces[num].size = base - m_array[first].base;
+        num++;
+    }
+    const Address lastEnd = m_array[last - 1].base + m_array[last - 1].size;
+    if (lastEnd > end)
+    {
+        pieces[num].base = end;
+        pieces[num].size = lastEnd - end;
+        num++;
+    }
+
+    return replace(first, last - first, pieces, num);
+}
+
+bool IntervalSet::overlaps(Address base, Size size) const
+{
+    const Size i = search(base);
+
+    return i < m_count && m_array[i].base < base + size;
+}
+
+IntervalSet::Result IntervalSet::findGap(Address base, Size range, Size size, Address *result) const
+{
+    const Address end = base + range;
+    Address addr = base;
+
+    if (!size || size > range)
+        return NotFound;
+
+    for (Size i = search(base); addr < end; i++)
+    {
+        const Address limit = (i < m_count && m_array[i].base < end) ?
+                               m_array[i].base : end;
+
+        if (limit > addr && limit - addr >= size)
+        {
+            *result = addr;
+            return Success;
+        }
+
+        if (limit == end)
+            break;
+
+        addr = m_array[i].base + m_array[i].size;
+    }
+
+    return NotFound;
+}
+
+Size IntervalSet::count() const
+{
+    return m_count;
+}
+
+const IntervalSet::Interval & IntervalSet::at(Size index) const
+{
+    return m_array[index];
+}
+
+void IntervalSet::clear()
+{
+    m_count = 0;
+}
+
+Size IntervalSet::search(Address addr) const
+{
+    Size low = 0, high = m_count;
+
+    while (low < high)
+    {
+        const Size mid = low + ((high - low) / 2);
+
+        if (m_array[mid].base + m_array[mid].size > addr)
+            high = mid;
+        else
+            low = mid + 1;
+    }
+
+    return low;
+}
+
+IntervalSet::Result IntervalSet::replace(Size index, Size count, const Interval *list, Size num)
+{
+    const Size total = m_count - count + num;
+
+    // Allocate the array on first use and grow it if needed
+    if (!m_array || total > m_size)
+    {
+        Size size = m_array ? m_size * 2 : m_size;
+        while (size < total)
+            size *= 2;
+
+        Interval *array = new Interval[size];
+
+        if (!array)
+            return OutOfMemory;
+
+        for (Size i = 0; i < m_count; i++)
+            array[i] = m_array[i];
+
+        if (m_array)
+            delete[] m_array;
+
+        m_array = array;
+        m_size  = size;
+    }
+
+    // Move the intervals after the replaced ones
+    if (num > count)
+    {
+        for (Size i = m_count; i > index + count; i--)
+            m_array[i - 1 + num - count] = m_array[i - 1];
+    }
+    else if (num < count)
+    {
+        for (Size i = index + count; i < m_count; i++)
+            m_array[i - count + num] = m_array[i];
+    }
+
+    for (Size i = 0; i < num; i++)
+        m_array[index + i] = list[i];
+
+    m_count = total;
+    return Success;
+}
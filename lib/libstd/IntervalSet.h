@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBSTD_INTERVALSET_H
+#define __LIBSTD_INTERVALSET_H
+
+#include "Macros.h"
+#include "Types.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libstd
+ * @{
+ */
+
+/**
+ * Set of address intervals.
+ *
+ * Intervals are kept sorted by address. Overlapping and adjacent intervals
+ * are merged, such that the set stays small for typical memory layouts.
+ * Lookups use binary search. Finding a free gap only visits the intervals
+ * inside the searched range.
+ */
+class IntervalSet
+{
+  public:
+
+    /**
+     * Single interval.
+     */
+    typedef struct Interval
+    {
+        /** First address of the interval. */
+        Address base;
+
+        /** Number of bytes in the interval. */
+        Size size;
+    }
+    Interval;
+
+    /**
+     * Result codes.
+     */
+    enum Result
+    {
+        Success,
+        InvalidArgument,
+        NotFound,
+        OutOfMemory
+    };
+
+  public:
+
+    /**
+     * Constructor.
+     *
+     * Does not allocate memory. The array is allocated on the first
+     * insert, so a set can be constructed before the heap exists.
+     *
+     * @param size Initial number of intervals to allocate room for.
+     */
+    IntervalSet(Size size = 16);
+
+    /**
+     * Destructor.
+     */
+    ~IntervalSet();
+
+    /**
+     * Add an interval.
+     *
+     * @param base First address of the interval.
+     * @param size Number of bytes in the interval.
+     *
+     * @return Result code.
+     */
+    Result insert(Address base, Size size);
+
+    /**
+     * Remove an interval.
+     *
+     * Parts of the given interval which are not in the set are ignored.
+     *
+     * @param base First address of the interval.
+     * @param size Number of bytes in the interval.
+     *
+     * @return Result code.
+     */
+    Result remove(Address base, Size size);
+
+    /**
+     * Check if any address of the given interval is in the set.
+     *
+     * @param base First address of the interval.
+     * @param size Number of bytes in the interval.
+     *
+     * @return True if overlapping, false otherwise.
+     */
+    bool overlaps(Address base, Size size) const;
+
+    /**
+     * Find the lowest gap of at least the given size.
+     *
+     * @param base First address of the range to search.
+     * @param range Number of bytes in the range to search.
+     * @param size Number of bytes needed.
+     * @param result On output the first address of the gap.
+     *
+     * @return Success if found, NotFound otherwise.
+     */
+    Result findGap(Address base, Size range, Size size, Address *result) const;
+
+    /**
+     * Get the number of intervals.
+     *
+     * @return Number of intervals.
+     */
+    Size count() const;
+
+    /**
+     * Get an interval.
+     *
+     * @param index Position of the interval, ordered by address.
+     *
+     * @return Interval reference.
+     */
+    const Interval & at(Size index) const;
+
+    /**
+     * Remove all intervals.
+     */
+    void clear();
+
+  private:
+
+    /**
+     * Find the first interval which ends after the given address.
+     *
+     * @param addr Address to search for.
+     *
+     * @return Index of the interval, or the count if none.
+     */
+    Size search(Address addr) const;
+
+    /**
+     * Replace intervals with new ones.
+     *
+     * @param index Position of the first interval to replace.
+     * @param count Number of intervals to replace.
+     * @param list New intervals.
+     * @param num Number of new intervals.
+     *
+     * @return Result code.
+     */
+    Result replace(Size index, Size count, const Interval *list, Size num);
+
+  private:
+
+    /** Array of intervals, or ZERO until the first insert. */
+    Interval *m_array;
+
+    /** Number of intervals in use. */
+    Size m_count;
+
+    /** Number of intervals allocated. */
+    Size m_size;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBSTD_INTERVALSET_H */
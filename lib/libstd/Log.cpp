@@ -16,22 +16,28 @@
  */
 
 #include "Log.h"
+#include "MemoryBlock.h"
 #include "String.h"
 
 Log::Log() : Singleton<Log>(this)
 {
     setMinimumLogLevel(Notice);
+    m_ident      = ZERO;
+    m_head       = 0;
+    m_commit     = 0;
+    m_tail       = 0;
+    m_lineLevel  = Notice;
+    m_overflow   = false;
+    m_dropped    = 0;
+    m_deferred   = false;
+    m_lineLength = 0;
+    m_line[0]    = ZERO;
 }
 
 Log::~Log()
 {
 }
 
-Log::Level Log::getMinimumLogLevel()
-{
-    return m_minimumLogLevel;
-}
-
 void Log::setMinimumLogLevel(Log::Level level)
 {
     m_minimumLogLevel = level;
@@ -47,15 +53,231 @@ void Log::setIdent(const char *ident)
     m_ident = ident;
 }
 
+void Log::setDeferred(bool deferred)
+{
+    m_deferred = deferred;
+
+    if (!deferred)
+        flush();
+}
+
+bool Log::isDeferred() const
+{
+    return m_deferred;
+}
+
+Size Log::getDropped() const
+{
+    return m_dropped;
+}
+
+bool Log::push(Log::Record type, Size size)
+{
+    const u8 tag = type;
+
+    if (m_overflow)
+        return false;
+
+    // Make room by writing out completed lines
+    if (RingSize - (m_tail - m_head) < size + 1)
+    {
+        flush();
+
+        // Drop the current line if it cannot fit
+        if (RingSize - (m_tail - m_head) < size + 1)
+        {
+            m_tail = m_commit;
+            m_overflow = true;
+            return false;
+        }
+    }
+
+    m_ring[m_tail++ % RingSize] = tag;
+    return true;
+}
+
+void Log::copy(const void *data, Size size)
+{
+    const Size offset = m_tail % RingSize;
+    const Size first = size < RingSize - offset ? size : RingSize - offset;
+
+    MemoryBlock::copy(m_ring + offset, data, first);
+    MemoryBlock::copy(m_ring, ((const u8 *) data) + first, size - first);
+    m_tail += size;
+}
+
+void Log::pop(void *data, Size size)
+{
+    const Size offset = m_head % RingSize;
+    const Size first = size < RingSize - offset ? size : RingSize - offset;
+
+    MemoryBlock::copy(data, m_ring + offset, first);
+    MemoryBlock::copy(((u8 *) data) + first, m_ring, size - first);
+    m_head += size;
+}
+
+void Log::writeLine()
+{
+    if (m_lineLength > 0)
+    {
+        m_line[m_lineLength] = ZERO;
+        write(m_line);
+        m_lineLength = 0;
+    }
+}
+
+void Log::commit()
+{
+    if (m_overflow)
+    {
+        m_overflow = false;
+        m_dropped++;
+    }
+    else if (push(EndRecord, 0))
+        m_commit = m_tail;
+    else
+    {
+        m_overflow = false;
+        m_dropped++;
+    }
+
+    if (!m_deferred || m_lineLevel <= Error)
+        flush();
+
+    m_lineLevel = Notice;
+}
+
+void Log::output(const char *str)
+{
+    while (*str)
+    {
+        if (m_lineLength == LineSize - 1)
+            writeLine();
+
+        m_line[m_lineLength++] = *str++;
+    }
+}
+
+void Log::output(ulong number, bool sign, bool hex)
+{
+    char buf[32], *p = buf + sizeof(buf) - 1;
+    const ulong base = hex ? 16 : 10;
+    const bool negative = sign && (long) number < 0;
+    ulong value = negative ? -number : number;
+
+    *p = ZERO;
+
+    do
+    {
+        const ulong digit = value % base;
+        *--p = digit < 10 ? digit + '0' : digit + 'a' - 10;
+    }
+    while (value /= base);
+
+    if (hex)
+    {
+        *--p = 'x';
+        *--p = '0';
+    }
+    if (negative)
+        *--p = '-';
+
+    output(p);
+}
+
+void Log::flush()
+{
+    // Completed lines are packed into as few writes as possible
+    while (m_head != m_commit)
+    {
+        u8 type;
+        pop(&type, sizeof(type));
+
+        switch (type)
+        {
+            case PrefixRecord: {
+                Prefix prefix(Notice, ZERO, ZERO, 0, ZERO);
+                pop(&prefix, sizeof(prefix));
+                output(prefix.type);
+                output(prefix.file);
+                output(":");
+                output(prefix.line, true, false);
+                output(" ");
+                output(prefix.function);
+                output(" -- ");
+                break;
+            }
+
+            case StringRecord: {
+                Size length;
+                pop(&length, sizeof(length));
+
+                while (length > 0)
+                {
+                    if (m_lineLength == LineSize - 1)
+                        writeLine();
+
+                    Size chunk = LineSize - 1 - m_lineLength;
+                    if (chunk > length)
+                        chunk = length;
+
+                    pop(m_line + m_lineLength, chunk);
+                    m_lineLength += chunk;
+                    length -= chunk;
+                }
+                break;
+            }
+
+            case SignedRecord:
+            case UnsignedRecord:
+            case PointerRecord: {
+                ulong number;
+                pop(&number, sizeof(number));
+                output(number, type == SignedRecord, type == PointerRecord);
+                break;
+            }
+
+            case EndRecord:
+                break;
+        }
+    }
+    writeLine();
+}
+
 void Log::append(const char *str)
 {
-    m_outputBuffer << str;
+    const Size len = String::length(str);
 
-    if (m_outputBuffer.endsWith("\n"))
+    if (push(StringRecord, sizeof(len) + len))
     {
-        write(*m_outputBuffer);
-        m_outputBuffer = "";
+        copy(&len, sizeof(len));
+        copy(str, len);
     }
+
+    if (len > 0 && str[len - 1] == '\n')
+        commit();
+}
+
+void Log::append(const Log::Prefix &prefix)
+{
+    m_lineLevel = prefix.level;
+
+    if (push(PrefixRecord, sizeof(prefix)))
+        copy(&prefix, sizeof(prefix));
+}
+
+void Log::append(ulong number, bool sign)
+{
+    if (push(sign ? SignedRecord : UnsignedRecord, sizeof(number)))
+        copy(&number, sizeof(number));
+}
+
+void Log::append(void *ptr)
+{
+    const ulong number = (ulong) ptr;
+
+    if (push(PointerRecord, sizeof(number)))
+        copy(&number, sizeof(number));
 }
 
 Log & operator << (Log &log, const char *str)
@@ -66,29 +288,30 @@ Log & operator << (Log &log, const char *str)
 
 Log & operator << (Log &log, int number)
 {
-    String s = number;
-    log.append(*s);
+    log.append((ulong) (long) number, true);
     return log;
 }
 
 Log & operator << (Log &log, unsigned number)
 {
-    String s = number;
-    log.append(*s);
+    log.append((ulong) number, false);
     return log;
 }
 
 Log & operator << (Log &log, unsigned long number)
 {
-    String s = number;
-    log.append(*s);
+    log.append(number, false);
     return log;
 }
 
 Log & operator << (Log &log, void *ptr)
 {
-    String s;
-    s << Number::Hex << ptr;
-    log.append(*s);
+    log.append(ptr);
+    return log;
+}
+
+Log & operator << (Log &log, const Log::Prefix &prefix)
+{
+    log.append(prefix);
     return log;
 }
@@ -20,6 +20,7 @@
 
 #include "Singleton.h"
 #include "Macros.h"
+#include "Types.h"
 #include "String.h"
 
 /**
@@ -30,6 +31,15 @@
  * @{
  */
 
+/**
+ * Highest log level compiled in.
+ *
+ * Messages with a higher level are removed by the compiler.
+ */
+#ifndef LOG_LEVEL
+#define LOG_LEVEL Log::Debug
+#endif /* LOG_LEVEL */
+
 /**
  * Output a log line to the system log (syslog).
  *
@@ -39,8 +49,8 @@
  */
 #define MAKE_LOG(type, typestr, msg) \
     {\
-     if (Log::instance && type <= Log::instance->getMinimumLogLevel())  \
-        (*Log::instance) << "[" typestr "] " << __FILE__ ":" <<  __LINE__ << " " << __FUNCTION__ << " -- " << msg << "\r\n"; \
+     if (type <= LOG_LEVEL && Log::instance && type <= Log::instance->getMinimumLogLevel())  \
+        (*Log::instance) << Log::Prefix(type, "[" typestr "] ", __FILE__, __LINE__, __FUNCTION__) << msg << "\r\n"; \
     }
 
 /** Action to take after printing a fatal error message */
@@ -97,6 +107,13 @@
 /**
  * Logging class.
  *
+ * Log lines are recorded in a fixed-size ring buffer without formatting:
+ * strings are copied, numbers are stored raw and the static prefix of a
+ * line is stored by reference. Lines are formatted when written to the
+ * output device. In deferred mode, lines are only written by flush(),
+ * which lets a consumer move the output cost out of the hot path.
+ * Error and more severe lines are always written immediately.
+ *
  * @note This class is a singleton
  */
 class Log : public Singleton<Log>
@@ -116,6 +133,44 @@ class Log : public Singleton<Log>
         Debug
     };
 
+    /**
+     * Static prefix of a log line.
+     *
+     * All strings must have static storage duration,
+     * because they are stored by reference.
+     */
+    struct Prefix
+    {
+        /**
+         * Constructor
+         */
+        Prefix(Level lvl, const char *typ, const char *fil, int lin, const char *func)
+            : level(lvl), type(typ), file(fil), line(lin), function(func)
+        {
+        }
+
+        /** Log level */
+        Level level;
+
+        /** Log level string */
+        const char *type;
+
+        /** Source file */
+        const char *file;
+
+        /** Source line */
+        int line;
+
+        /** Function name */
+        const char *function;
+    };
+
+    /** Size of the ring buffer in bytes. Must be a power of two. */
+    static const Size RingSize = 2048;
+
+    /** Maximum length of a single write to the output device */
+    static const Size LineSize = 256;
+
   public:
 
     /**
@@ -133,13 +188,42 @@ class Log : public Singleton<Log>
      *
      * @return Minimum LogLevel
      */
-    Level getMinimumLogLevel();
+    inline Level getMinimumLogLevel() const
+    {
+        return m_minimumLogLevel;
+    }
 
     /**
      * Set the minimum logging level.
      */
     void setMinimumLogLevel(Level level);
 
+    /**
+     * Enable or disable deferred output.
+     *
+     * @param deferred True to only write lines on flush().
+     */
+    void setDeferred(bool deferred);
+
+    /**
+     * Check for deferred output.
+     *
+     * @return True if lines are only written on flush().
+     */
+    bool isDeferred() const;
+
+    /**
+     * Get the number of lines dropped because the ring buffer was full.
+     *
+     * @return Number of dropped lines.
+     */
+    Size getDropped() const;
+
+    /**
+     * Format and write all completed lines to the output device.
+     */
+    void flush();
+
     /**
      * Append to buffered output.
      *
@@ -147,6 +231,28 @@ class Log : public Singleton<Log>
      */
     void append(const char *str);
 
+    /**
+     * Append the static prefix of a log line.
+     *
+     * @param prefix Log line prefix.
+     */
+    void append(const Prefix &prefix);
+
+    /**
+     * Append a number to buffered output.
+     *
+     * @param number Number to append.
+     * @param sign True to format the number as signed.
+     */
+    void append(ulong number, bool sign);
+
+    /**
+     * Append a pointer to buffered output.
+     *
+     * @param ptr Pointer to append as hexadecimal value.
+     */
+    void append(void *ptr);
+
     /**
      * Set log identity.
      *
@@ -168,6 +274,73 @@ class Log : public Singleton<Log>
      */
     virtual void write(const char *str) = 0;
 
+  private:
+
+    /**
+     * Types of records in the ring buffer.
+     */
+    enum Record
+    {
+        PrefixRecord,
+        StringRecord,
+        SignedRecord,
+        UnsignedRecord,
+        PointerRecord,
+        EndRecord
+    };
+
+    /**
+     * Start a record in the ring buffer.
+     *
+     * @param type Record type
+     * @param size Number of payload bytes which follow
+     *
+     * @return True if the record fits, false if the line is dropped
+     */
+    bool push(Record type, Size size);
+
+    /**
+     * Add payload bytes to the ring buffer.
+     *
+     * @param data Payload
+     * @param size Number of bytes
+     */
+    void copy(const void *data, Size size);
+
+    /**
+     * Remove bytes from the ring buffer.
+     *
+     * @param data Output buffer
+     * @param size Number of bytes to remove
+     */
+    void pop(void *data, Size size);
+
+    /**
+     * Complete the current line.
+     */
+    void commit();
+
+    /**
+     * Write the formatted output line to the output device.
+     */
+    void writeLine();
+
+    /**
+     * Add text to the formatted output line.
+     *
+     * @param str Text to add
+     */
+    void output(const char *str);
+
+    /**
+     * Add a number to the formatted output line.
+     *
+     * @param number Number to add
+     * @param sign True to format the number as signed
+     * @param hex True to format the number as hexadecimal
+     */
+    void output(ulong number, bool sign, bool hex);
+
   private:
 
     /** Minimum log level required to log. */
@@ -176,8 +349,35 @@ class Log : public Singleton<Log>
     /** Identity */
     const char *m_ident;
 
-    /** Buffered output */
-    String m_outputBuffer;
+    /** Ring buffer of records */
+    u8 m_ring[RingSize];
+
+    /** Read position of the ring buffer */
+    Size m_head;
+
+    /** End of the completed lines in the ring buffer */
+    Size m_commit;
+
+    /** Write position of the ring buffer */
+    Size m_tail;
+
+    /** Log level of the current line */
+    Level m_lineLevel;
+
+    /** True if the current line did not fit in the ring buffer */
+    bool m_overflow;
+
+    /** Number of dropped lines */
+    Size m_dropped;
+
+    /** Only write lines on flush() if true */
+    bool m_deferred;
+
+    /** Formatted output line */
+    char m_line[LineSize];
+
+    /** Length of the formatted output line */
+    Size m_lineLength;
 };
 
 /**
@@ -195,6 +395,8 @@ Log & operator << (Log &log, unsigned long number);
 
 Log & operator << (Log &log, void *ptr);
 
+Log & operator << (Log &log, const Log::Prefix &prefix);
+
 /**
  * @}
  */
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include "BenchmarkCSVReporter.h"
+
+BenchmarkCSVReporter::BenchmarkCSVReporter(int argc, char **argv)
+    : BenchmarkReporter(argc, argv)
+{
+}
+
+void BenchmarkCSVReporter::reportBegin(List<BenchmarkInstance *> & benchmarks)
+{
+    printf("name,unit,samples,bytes,min,median,p99,max,average\r\n");
+
+#ifdef __HOST__
+    fflush(stdout);
+#endif /* __HOST__ */
+}
+
+void BenchmarkCSVReporter::reportAfter(BenchmarkInstance & bench, BenchmarkResult & result)
+{
+    if (result.isSkipped())
+    {
+        printf("%s,%s,0,%u,,,,,\r\n", *bench.getName(), m_unit, bench.getBytes());
+    }
+    else
+    {
+        printf("%s,%s,%u,%u,%u,%u,%u,%u,%u\r\n",
+                *bench.getName(), m_unit, result.count(), bench.getBytes(),
+                (uint) result.getMinimum(), (uint) result.getMedian(),
+                (uint) result.getPercentile(99), (uint) result.getMaximum(),
+                (uint) result.getAverage());
+    }
+
+#ifdef __HOST__
+    fflush(stdout);
+#endif /* __HOST__ */
+}
+
+void BenchmarkCSVReporter::reportFinish(List<BenchmarkInstance *> & benchmarks)
+{
+}
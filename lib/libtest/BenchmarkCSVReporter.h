@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBTEST_BENCHMARKCSVREPORTER_H
+#define __LIBTEST_BENCHMARKCSVREPORTER_H
+
+#include "BenchmarkReporter.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libtest
+ * @{
+ */
+
+/**
+ * Output BenchmarkResults as comma separated values.
+ */
+class BenchmarkCSVReporter : public BenchmarkReporter
+{
+  public:
+
+    /**
+     * Constructor.
+     */
+    BenchmarkCSVReporter(int argc, char **argv);
+
+    /**
+     * Report start of benchmarking.
+     */
+    virtual void reportBegin(List<BenchmarkInstance *> & benchmarks);
+
+    /**
+     * Report result of a benchmark.
+     */
+    virtual void reportAfter(BenchmarkInstance & bench, BenchmarkResult & result);
+
+    /**
+     * Report completion of all benchmarks.
+     */
+    virtual void reportFinish(List<BenchmarkInstance *> & benchmarks);
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBTEST_BENCHMARKCSVREPORTER_H */
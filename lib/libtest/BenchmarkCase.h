@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBTEST_BENCHMARKCASE_H
+#define __LIBTEST_BENCHMARKCASE_H
+
+#include <Macros.h>
+#include "LocalBenchmark.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libtest
+ * @{
+ */
+
+/**
+ * Define a benchmark function which is measured once per iteration.
+ */
+#define BenchmarkCase(name) \
+    void name (void); \
+    LocalBenchmark bench_##name (QUOTE(name), name); \
+    void name (void)
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBTEST_BENCHMARKCASE_H */
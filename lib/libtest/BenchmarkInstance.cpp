@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkSuite.h"
+#include "BenchmarkInstance.h"
+
+BenchmarkInstance::BenchmarkInstance(const char *name, Size bytes)
+    : m_name(name, true)
+    , m_bytes(bytes)
+{
+    if (!BenchmarkSuite::instance)
+    {
+        BenchmarkSuite::instance = new BenchmarkSuite();
+    }
+    BenchmarkSuite::instance->addBenchmark(this);
+}
+
+BenchmarkInstance::~BenchmarkInstance()
+{
+}
+
+const String & BenchmarkInstance::getName() const
+{
+    return m_name;
+}
+
+Size BenchmarkInstance::getBytes() const
+{
+    return m_bytes;
+}
+
+bool BenchmarkInstance::setup()
+{
+    return true;
+}
+
+void BenchmarkInstance::cleanup()
+{
+}
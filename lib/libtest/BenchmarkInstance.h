@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBTEST_BENCHMARKINSTANCE_H
+#define __LIBTEST_BENCHMARKINSTANCE_H
+
+#include <Types.h>
+#include <String.h>
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libtest
+ * @{
+ */
+
+/**
+ * Represents a single benchmark.
+ *
+ * A benchmark consists of an optional setup, an operation which
+ * is executed once per iteration and measured, and an optional cleanup.
+ */
+class BenchmarkInstance
+{
+  public:
+
+    /**
+     * Class constructor
+     *
+     * @param name Name of the benchmark
+     * @param bytes Number of bytes processed per iteration or zero
+     */
+    BenchmarkInstance(const char *name, Size bytes = 0);
+
+    /**
+     * Destructor
+     */
+    virtual ~BenchmarkInstance();
+
+    /**
+     * Retrieve benchmark name
+     *
+     * @return Benchmark name
+     */
+    const String & getName() const;
+
+    /**
+     * Retrieve number of bytes processed per iteration
+     *
+     * @return Number of bytes or zero if not applicable
+     */
+    Size getBytes() const;
+
+    /**
+     * Prepare the benchmark for execution
+     *
+     * @return True if the benchmark can run, false to skip it
+     */
+    virtual bool setup();
+
+    /**
+     * Execute a single iteration of the benchmark
+     */
+    virtual void execute() = 0;
+
+    /**
+     * Release resources acquired in setup
+     */
+    virtual void cleanup();
+
+  protected:
+
+    /** Name of the benchmark */
+    String m_name;
+
+    /** Bytes processed per iteration */
+    Size m_bytes;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBTEST_BENCHMARKINSTANCE_H */
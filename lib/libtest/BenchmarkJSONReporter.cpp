@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <libgen.h>
+#include "BenchmarkJSONReporter.h"
+
+BenchmarkJSONReporter::BenchmarkJSONReporter(int argc, char **argv)
+    : BenchmarkReporter(argc, argv)
+    , m_first(true)
+{
+}
+
+void BenchmarkJSONReporter::reportBegin(List<BenchmarkInstance *> & benchmarks)
+{
+    printf("{\r\n"
+           "  \"program\": \"%s\",\r\n"
+           "  \"unit\": \"%s\",\r\n"
+           "  \"iterations\": %u,\r\n"
+           "  \"warmup\": %u,\r\n"
+           "  \"benchmarks\": [",
+            basename(m_argv[0]), m_unit, m_iterations, m_warmup);
+    m_first = true;
+
+#ifdef __HOST__
+    fflush(stdout);
+#endif /* __HOST__ */
+}
+
+void BenchmarkJSONReporter::reportAfter(BenchmarkInstance & bench, BenchmarkResult & result)
+{
+    printf("%s\r\n    { \"name\": \"%s\", ", m_first ? "" : ",", *bench.getName());
+    m_first = false;
+
+    if (result.isSkipped())
+    {
+        printf("\"skipped\": true }");
+    }
+    else
+    {
+        printf("\"skipped\": false, \"samples\": %u, \"bytes\": %u, "
+               "\"min\": %u, \"median\": %u, \"p99\": %u, \"max\": %u, \"average\": %u }",
+                result.count(), bench.getBytes(),
+                (uint) result.getMinimum(), (uint) result.getMedian(),
+                (uint) result.getPercentile(99), (uint) result.getMaximum(),
+                (uint) result.getAverage());
+    }
+
+#ifdef __HOST__
+    fflush(stdout);
+#endif /* __HOST__ */
+}
+
+void BenchmarkJSONReporter::reportFinish(List<BenchmarkInstance *> & benchmarks)
+{
+    printf("\r\n  ]\r\n}\r\n");
+
+#ifdef __HOST__
+    fflush(stdout);
+#endif /* __HOST__ */
+}
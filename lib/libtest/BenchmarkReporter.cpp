@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkReporter.h"
+
+BenchmarkReporter::BenchmarkReporter(int argc, char **argv)
+{
+    m_argc = argc;
+    m_argv = argv;
+    m_iterations = 0;
+    m_warmup = 0;
+    m_unit = "ticks";
+    m_completed = 0;
+    m_skip = 0;
+}
+
+BenchmarkReporter::~BenchmarkReporter()
+{
+}
+
+uint BenchmarkReporter::getCompleted() const
+{
+    return m_completed;
+}
+
+uint BenchmarkReporter::getSkipped() const
+{
+    return m_skip;
+}
+
+void BenchmarkReporter::setParameters(Size iterations, Size warmup, const char *unit)
+{
+    m_iterations = iterations;
+    m_warmup = warmup;
+    m_unit = unit;
+}
+
+void BenchmarkReporter::begin(List<BenchmarkInstance *> & benchmarks)
+{
+    reportBegin(benchmarks);
+}
+
+void BenchmarkReporter::collect(BenchmarkInstance & bench, BenchmarkResult & result)
+{
+    reportAfter(bench, result);
+
+    if (result.isSkipped())
+        m_skip++;
+    else
+        m_completed++;
+}
+
+void BenchmarkReporter::finish(List<BenchmarkInstance *> & benchmarks)
+{
+    reportFinish(benchmarks);
+}
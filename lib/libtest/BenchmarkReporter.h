@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBTEST_BENCHMARKREPORTER_H
+#define __LIBTEST_BENCHMARKREPORTER_H
+
+#include <Types.h>
+#include <List.h>
+#include "BenchmarkInstance.h"
+#include "BenchmarkResult.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libtest
+ * @{
+ */
+
+/**
+ * Responsible for outputting benchmark results.
+ */
+class BenchmarkReporter
+{
+  public:
+
+    /**
+     * Constructor.
+     */
+    BenchmarkReporter(int argc, char **argv);
+
+    /**
+     * Destructor.
+     */
+    virtual ~BenchmarkReporter();
+
+    /**
+     * Get number of completed benchmarks.
+     */
+    uint getCompleted() const;
+
+    /**
+     * Get number of skipped benchmarks.
+     */
+    uint getSkipped() const;
+
+    /**
+     * Set benchmark parameters for reporting.
+     *
+     * @param iterations Number of measured iterations per benchmark
+     * @param warmup Number of unmeasured warm-up iterations per benchmark
+     * @param unit Name of the time unit of samples
+     */
+    void setParameters(Size iterations, Size warmup, const char *unit);
+
+    /**
+     * Begin benchmarking.
+     */
+    virtual void begin(List<BenchmarkInstance *> & benchmarks);
+
+    /**
+     * Collect benchmark statistics.
+     */
+    virtual void collect(BenchmarkInstance & bench, BenchmarkResult & result);
+
+    /**
+     * Finish benchmarking.
+     */
+    virtual void finish(List<BenchmarkInstance *> & benchmarks);
+
+  protected:
+
+    /**
+     * Report start of benchmarking.
+     */
+    virtual void reportBegin(List<BenchmarkInstance *> & benchmarks) = 0;
+
+    /**
+     * Report result of a benchmark.
+     */
+    virtual void reportAfter(BenchmarkInstance & bench, BenchmarkResult & result) = 0;
+
+    /**
+     * Report completion of all benchmarks.
+     */
+    virtual void reportFinish(List<BenchmarkInstance *> & benchmarks) = 0;
+
+  protected:
+
+    /** Argument count */
+    int m_argc;
+
+    /** Argument values */
+    char ** m_argv;
+
+    /** Measured iterations per benchmark */
+    Size m_iterations;
+
+    /** Warm-up iterations per benchmark */
+    Size m_warmup;
+
+    /** Time unit of the samples */
+    const char *m_unit;
+
+    /** Benchmark statistics */
+    uint m_completed, m_skip;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBTEST_BENCHMARKREPORTER_H */
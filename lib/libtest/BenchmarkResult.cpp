@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkResult.h"
+
+BenchmarkResult::BenchmarkResult(Size size)
+    : m_samples(size ? size : 1)
+    , m_total(0)
+    , m_sorted(true)
+    , m_skipped(false)
+{
+}
+
+void BenchmarkResult::addSample(u64 sample)
+{
+    m_samples.insert(sample);
+    m_total += sample;
+    m_sorted = false;
+}
+
+void BenchmarkResult::setSkipped()
+{
+    m_skipped = true;
+}
+
+bool BenchmarkResult::isSkipped() const
+{
+    return m_skipped;
+}
+
+Size BenchmarkResult::count() const
+{
+    return m_samples.count();
+}
+
+u64 BenchmarkResult::getMinimum()
+{
+    return getPercentile(0);
+}
+
+u64 BenchmarkResult::getMaximum()
+{
+    return getPercentile(100);
+}
+
+u64 BenchmarkResult::getAverage() const
+{
+    if (m_samples.count() == 0)
+        return 0;
+
+    return m_total / m_samples.count();
+}
+
+u64 BenchmarkResult::getMedian()
+{
+    return getPercentile(50);
+}
+
+u64 BenchmarkResult::getPercentile(uint percent)
+{
+    const Size count = m_samples.count();
+
+    if (count == 0)
+        return 0;
+
+    if (percent > 100)
+        percent = 100;
+
+    sort();
+
+    // Nearest rank: smallest sample with at least percent% of samples at or below it
+    Size rank = ((count * percent) + 99) / 100;
+    if (rank > 0)
+        rank--;
+
+    return m_samples[rank];
+}
+
+void BenchmarkResult::sort()
+{
+    const Size count = m_samples.count();
+
+    if (m_sorted)
+        return;
+
+    // Shell sort with halving gaps: in-place and fast enough for sample sets
+    for (Size gap = count / 2; gap > 0; gap /= 2)
+    {
+        for (Size i = gap; i < count; i++)
+        {
+            u64 value = m_samples[i];
+            Size j = i;
+
+            for (; j >= gap && m_samples[j - gap] > value; j -= gap)
+                m_samples[j] = m_samples[j - gap];
+
+            m_samples[j] = value;
+        }
+    }
+    m_sorted = true;
+}
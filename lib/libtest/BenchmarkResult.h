@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBTEST_BENCHMARKRESULT_H
+#define __LIBTEST_BENCHMARKRESULT_H
+
+#include <Types.h>
+#include <Vector.h>
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libtest
+ * @{
+ */
+
+/**
+ * Collects timing samples of a benchmark and computes statistics.
+ */
+class BenchmarkResult
+{
+  public:
+
+    /**
+     * Constructor
+     *
+     * @param size Expected number of samples
+     */
+    BenchmarkResult(Size size);
+
+    /**
+     * Add a timing sample.
+     *
+     * @param sample Duration of a single iteration
+     */
+    void addSample(u64 sample);
+
+    /**
+     * Mark the benchmark as skipped.
+     */
+    void setSkipped();
+
+    /**
+     * Check if the benchmark was skipped.
+     */
+    bool isSkipped() const;
+
+    /**
+     * Get the number of samples collected.
+     */
+    Size count() const;
+
+    /**
+     * Get the lowest sample.
+     */
+    u64 getMinimum();
+
+    /**
+     * Get the highest sample.
+     */
+    u64 getMaximum();
+
+    /**
+     * Get the arithmetic mean of all samples.
+     */
+    u64 getAverage() const;
+
+    /**
+     * Get the median sample.
+     */
+    u64 getMedian();
+
+    /**
+     * Get a percentile sample.
+     *
+     * Uses the nearest-rank method on the sorted samples.
+     *
+     * @param percent Percentile in range 0-100
+     *
+     * @return Sample value at the given percentile
+     */
+    u64 getPercentile(uint percent);
+
+  private:
+
+    /**
+     * Sort the samples in ascending order, if needed.
+     */
+    void sort();
+
+  private:
+
+    /** Collected samples */
+    Vector<u64> m_samples;
+
+    /** Sum of all samples */
+    u64 m_total;
+
+    /** True if the samples are sorted */
+    bool m_sorted;
+
+    /** True if the benchmark was skipped */
+    bool m_skipped;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBTEST_BENCHMARKRESULT_H */
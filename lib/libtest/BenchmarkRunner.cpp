@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <ListIterator.h>
+#include "BenchmarkRunner.h"
+#include "BenchmarkSuite.h"
+#include "BenchmarkResult.h"
+#include "BenchmarkStdoutReporter.h"
+#include "BenchmarkJSONReporter.h"
+#include "BenchmarkCSVReporter.h"
+
+#ifdef __HOST__
+#include <time.h>
+#else
+#include <FreeNOS/System.h>
+#endif /* __HOST__ */
+
+BenchmarkRunner::BenchmarkRunner(int argc, char **argv)
+{
+    // Set member default values.
+    m_argc = argc;
+    m_argv = argv;
+    m_reporter = ZERO;
+    m_iterations = BENCHMARK_DEFAULT_ITERATIONS;
+    m_warmup = BENCHMARK_DEFAULT_WARMUP;
+    m_filter = ZERO;
+    m_overhead = 0;
+
+    // Check for command-line specified arguments.
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-i") == 0 || strcmp(argv[i], "--iterations") == 0) && i < argc - 1)
+        {
+            m_iterations = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-w") == 0 || strcmp(argv[i], "--warmup") == 0) && i < argc - 1)
+        {
+            m_warmup = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-f") == 0 || strcmp(argv[i], "--filter") == 0) && i < argc - 1)
+        {
+            m_filter = argv[++i];
+        }
+        else if ((strcmp(argv[i], "-j") == 0 || strcmp(argv[i], "--json") == 0) && !m_reporter)
+        {
+            m_reporter = new BenchmarkJSONReporter(argc, argv);
+        }
+        else if ((strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--csv") == 0) && !m_reporter)
+        {
+            m_reporter = new BenchmarkCSVReporter(argc, argv);
+        }
+    }
+
+    if (!m_reporter)
+        m_reporter = new BenchmarkStdoutReporter(argc, argv);
+
+    if (m_iterations == 0)
+        m_iterations = 1;
+
+    m_reporter->setParameters(m_iterations, m_warmup, unit());
+}
+
+BenchmarkRunner::~BenchmarkRunner()
+{
+    delete m_reporter;
+}
+
+BenchmarkReporter * BenchmarkRunner::getReporter()
+{
+    return m_reporter;
+}
+
+u64 BenchmarkRunner::now()
+{
+#ifdef __HOST__
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((u64) ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
+#else
+    return timestamp();
+#endif /* __HOST__ */
+}
+
+const char * BenchmarkRunner::unit()
+{
+#ifdef __HOST__
+    return "ns";
+#else
+    return "ticks";
+#endif /* __HOST__ */
+}
+
+u64 BenchmarkRunner::calibrate() const
+{
+    u64 lowest = ~0ULL;
+
+    for (Size i = 0; i < 64; i++)
+    {
+        u64 t1 = now();
+        u64 t2 = now();
+
+        if (t2 - t1 < lowest)
+            lowest = t2 - t1;
+    }
+    return lowest;
+}
+
+int BenchmarkRunner::run(void)
+{
+    List<BenchmarkInstance *> *benchmarks = BenchmarkSuite::instance ?
+        BenchmarkSuite::instance->getBenchmarks() : ZERO;
+    List<BenchmarkInstance *> selected;
+
+    // Select benchmarks to run
+    if (benchmarks)
+    {
+        for (ListIterator<BenchmarkInstance *> i(benchmarks); i.hasCurrent(); i++)
+        {
+            BenchmarkInstance *bench = i.current();
+
+            if (!m_filter || strncmp(*bench->getName(), m_filter, strlen(m_filter)) == 0)
+                selected.append(bench);
+        }
+    }
+    m_overhead = calibrate();
+    m_reporter->begin(selected);
+
+    // Execute benchmarks. Report per-benchmark statistics.
+    for (ListIterator<BenchmarkInstance *> i(selected); i.hasCurrent(); i++)
+        runBenchmark(*i.current());
+
+    // Finish benchmarking. Report final stats.
+    m_reporter->finish(selected);
+    return 0;
+}
+
+void BenchmarkRunner::runBenchmark(BenchmarkInstance & bench)
+{
+    BenchmarkResult result(m_iterations);
+
+    if (!bench.setup())
+    {
+        result.setSkipped();
+        m_reporter->collect(bench, result);
+        return;
+    }
+
+    // Warm up caches, TLBs and lazily allocated resources
+    for (Size i = 0; i < m_warmup; i++)
+        bench.execute();
+
+    // Measure each iteration separately, excluding the measurement cost
+    for (Size i = 0; i < m_iterations; i++)
+    {
+        u64 t1 = now();
+        bench.execute();
+        u64 t2 = now();
+        u64 elapsed = t2 - t1;
+
+        result.addSample(elapsed > m_overhead ? elapsed - m_overhead : 0);
+    }
+    bench.cleanup();
+    m_reporter->collect(bench, result);
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBTEST_BENCHMARKRUNNER_H
+#define __LIBTEST_BENCHMARKRUNNER_H
+
+#include <Types.h>
+#include "BenchmarkInstance.h"
+
+class BenchmarkReporter;
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libtest
+ * @{
+ */
+
+/** Default number of measured iterations per benchmark */
+#define BENCHMARK_DEFAULT_ITERATIONS 1000
+
+/** Default number of warm-up iterations per benchmark */
+#define BENCHMARK_DEFAULT_WARMUP     100
+
+/**
+ * Responsible for running registered benchmarks and collecting samples.
+ *
+ * Recognized arguments:
+ *
+ *   -i, --iterations N   measured iterations per benchmark
+ *   -w, --warmup N       unmeasured warm-up iterations per benchmark
+ *   -f, --filter NAME    only run benchmarks whose name starts with NAME
+ *   -j, --json           output results as JSON
+ *   -c, --csv            output results as CSV
+ */
+class BenchmarkRunner
+{
+  public:
+
+    /**
+     * Class constructor
+     *
+     * @param argc Program argument count
+     * @param argv Program argument values
+     */
+    BenchmarkRunner(int argc, char **argv);
+
+    /**
+     * Destructor
+     */
+    virtual ~BenchmarkRunner();
+
+    /**
+     * Get benchmark reporter
+     *
+     * @return BenchmarkReporter pointer
+     */
+    BenchmarkReporter * getReporter();
+
+    /**
+     * Run all registered benchmarks
+     *
+     * @return Zero on success
+     */
+    int run(void);
+
+    /**
+     * Read the current time.
+     *
+     * On the host this is a monotonic clock in nanoseconds,
+     * otherwise the CPU timestamp counter in ticks.
+     *
+     * @return Current time value
+     */
+    static u64 now();
+
+    /**
+     * Get the name of the time unit returned by now().
+     */
+    static const char * unit();
+
+  private:
+
+    /**
+     * Measure the fixed cost of reading the time twice.
+     *
+     * @return Lowest observed overhead
+     */
+    u64 calibrate() const;
+
+    /**
+     * Run a single benchmark.
+     *
+     * @param bench Benchmark to run
+     */
+    void runBenchmark(BenchmarkInstance & bench);
+
+  protected:
+
+    /** Program argument count */
+    int m_argc;
+
+    /** Program argument values */
+    char **m_argv;
+
+    /** Reports benchmark results */
+    BenchmarkReporter *m_reporter;
+
+    /** Measured iterations per benchmark */
+    Size m_iterations;
+
+    /** Warm-up iterations per benchmark */
+    Size m_warmup;
+
+    /** Only run benchmarks starting with this name, if set */
+    const char *m_filter;
+
+    /** Overhead of a single time measurement */
+    u64 m_overhead;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBTEST_BENCHMARKRUNNER_H */
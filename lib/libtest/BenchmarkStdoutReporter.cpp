@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <libgen.h>
+#include <TerminalCodes.h>
+#include "BenchmarkStdoutReporter.h"
+
+BenchmarkStdoutReporter::BenchmarkStdoutReporter(int argc, char **argv)
+    : BenchmarkReporter(argc, argv)
+{
+}
+
+void BenchmarkStdoutReporter::reportBegin(List<BenchmarkInstance *> & benchmarks)
+{
+    printf("%s%s: running %d benchmarks (%u iterations, %u warmup, unit %s)\r\n",
+            WHITE, basename(m_argv[0]), benchmarks.count(),
+            m_iterations, m_warmup, m_unit);
+
+#ifdef __HOST__
+    fflush(stdout);
+#endif /* __HOST__ */
+}
+
+void BenchmarkStdoutReporter::reportAfter(BenchmarkInstance & bench, BenchmarkResult & result)
+{
+    printf("%s%s: %s .. ", WHITE, basename(m_argv[0]), *bench.getName());
+
+    if (result.isSkipped())
+    {
+        printf("%sSKIP%s\r\n", YELLOW, WHITE);
+    }
+    else
+    {
+        printf("min %u median %u p99 %u max %u avg %u %s",
+                (uint) result.getMinimum(), (uint) result.getMedian(),
+                (uint) result.getPercentile(99), (uint) result.getMaximum(),
+                (uint) result.getAverage(), m_unit);
+
+        if (bench.getBytes())
+            printf(" (%u bytes/op)", bench.getBytes());
+
+        printf("\r\n");
+    }
+
+#ifdef __HOST__
+    fflush(stdout);
+#endif /* __HOST__ */
+}
+
+void BenchmarkStdoutReporter::reportFinish(List<BenchmarkInstance *> & benchmarks)
+{
+    printf("%s: %sOK%s   (%d completed %d skipped %d total)\r\n",
+            basename(m_argv[0]), GREEN, WHITE,
+            m_completed, m_skip, (m_completed + m_skip));
+
+#ifdef __HOST__
+    fflush(stdout);
+#endif /* __HOST__ */
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBTEST_BENCHMARKSUITE_H
+#define __LIBTEST_BENCHMARKSUITE_H
+
+#include <Singleton.h>
+#include <List.h>
+
+class BenchmarkInstance;
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libtest
+ * @{
+ */
+
+/**
+ * Maintains a list of benchmark instances
+ */
+class BenchmarkSuite : public Singleton<BenchmarkSuite>
+{
+  public:
+
+    /**
+     * Class constructor
+     */
+    BenchmarkSuite();
+
+    /**
+     * Add a benchmark
+     *
+     * @param bench BenchmarkInstance to add
+     */
+    void addBenchmark(BenchmarkInstance *bench);
+
+    /**
+     * Retrieve a list of all benchmarks
+     *
+     * @return List of BenchmarkInstances
+     */
+    List<BenchmarkInstance *> * getBenchmarks();
+
+  private:
+
+    /** List of BenchmarkInstances in the suite */
+    List<BenchmarkInstance *> m_benchmarks;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBTEST_BENCHMARKSUITE_H */
@@ -30,21 +30,35 @@ ExternalTest::ExternalTest(const char *name, int argc, char **argv)
 {
     m_argc = argc;
     m_argv = argv;
+    m_pid = -1;
+    m_status = 0;
+    m_output = -1;
 }
 
-TestResult ExternalTest::run()
+ExternalTest::~ExternalTest()
+{
+}
+
+char ** ExternalTest::createArguments() const
 {
-    int status;
-    pid_t pid;
     char **argv = new char * [m_argc + 2];
 
     for (int i = 1; i < m_argc; i++)
         argv[i] = m_argv[i];
 
-    argv[0]        = *m_name;
+    argv[0]        = (char *) *m_name;
     argv[m_argc]   = (char *) "-n";
     argv[m_argc+1] = 0;
 
+    return argv;
+}
+
+TestResult ExternalTest::run()
+{
+    int status;
+    pid_t pid;
+    char **argv = createArguments();
+
 #ifdef __HOST__
     if ((pid = fork()) == 0)
         execv(argv[0], argv);
@@ -56,3 +70,82 @@ TestResult ExternalTest::run()
 
     return status == 0 ? OK : FAIL;
 }
+
+bool ExternalTest::start()
+{
+#ifdef __HOST__
+    char path[] = "/tmp/libtest.XXXXXX";
+    char **argv;
+
+    // Buffer output in an anonymous temporary file
+    if ((m_output = mkstemp(path)) == -1)
+        return false;
+
+    unlink(path);
+    argv = createArguments();
+    fflush(stdout);
+
+    if ((m_pid = fork()) == 0)
+    {
+        dup2(m_output, STDOUT_FILENO);
+        dup2(m_output, STDERR_FILENO);
+        execv(argv[0], argv);
+        _exit(EXIT_FAILURE);
+    }
+    delete[] argv;
+
+    if (m_pid == -1)
+    {
+        close(m_output);
+        m_output = -1;
+        return false;
+    }
+    return true;
+#else
+    // The kernel discards the exit status of processes which
+    // terminate before their parent waits for them. Therefore
+    // background execution is not possible here.
+    return false;
+#endif /* __HOST__ */
+}
+
+bool ExternalTest::isFinished()
+{
+#ifdef __HOST__
+    if (m_pid == -1)
+        return true;
+
+    if (waitpid(m_pid, &m_status, WNOHANG) == m_pid)
+    {
+        m_pid = -1;
+        return true;
+    }
+    return false;
+#else
+    return true;
+#endif /* __HOST__ */
+}
+
+TestResult ExternalTest::finish()
+{
+#ifdef __HOST__
+    char buf[512];
+    ssize_t bytes;
+
+    // Output buffered test output
+    if (m_output != -1)
+    {
+        lseek(m_output, 0, SEEK_SET);
+
+        while ((bytes = read(m_output, buf, sizeof(buf))) > 0)
+            fwrite(buf, bytes, 1, stdout);
+
+        fflush(stdout);
+        close(m_output);
+        m_output = -1;
+    }
+    return m_status == 0 ? OK : FAIL;
+#else
+    return run();
+#endif /* __HOST__ */
+}
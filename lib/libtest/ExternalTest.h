@@ -44,6 +44,11 @@ class ExternalTest : public TestInstance
      */
     ExternalTest(const char *name, int argc, char **argv);
 
+    /**
+     * Destructor
+     */
+    virtual ~ExternalTest();
+
     /**
      * Run the external test
      *
@@ -51,6 +56,40 @@ class ExternalTest : public TestInstance
      */
     virtual TestResult run();
 
+    /**
+     * Start the external test in the background
+     *
+     * Output of the test program is buffered in a temporary
+     * file until finish() is called, such that the output of
+     * tests running in parallel does not interleave.
+     *
+     * @return True if started, false otherwise
+     */
+    virtual bool start();
+
+    /**
+     * Check if the test program has terminated
+     *
+     * @return True if terminated, false otherwise
+     */
+    virtual bool isFinished();
+
+    /**
+     * Output the buffered test output and retrieve the result
+     *
+     * @return TestResult
+     */
+    virtual TestResult finish();
+
+  private:
+
+    /**
+     * Create argument values for the test program
+     *
+     * @return Argument values array, to be released with delete[]
+     */
+    char ** createArguments() const;
+
   private:
 
     /** Program argument count */
@@ -58,6 +97,15 @@ class ExternalTest : public TestInstance
 
     /** Program argument values */
     char ** m_argv;
+
+    /** Process ID of the test program running in the background */
+    int m_pid;
+
+    /** Exit status of the test program running in the background */
+    int m_status;
+
+    /** File descriptor containing buffered output or -1 */
+    int m_output;
 };
 
 /**
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBTEST_LOCALBENCHMARK_H
+#define __LIBTEST_LOCALBENCHMARK_H
+
+#include "BenchmarkInstance.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libtest
+ * @{
+ */
+
+typedef void BenchmarkFunction(void);
+
+/**
+ * Represents a benchmark function inside the same process
+ */
+class LocalBenchmark : public BenchmarkInstance
+{
+  public:
+
+    /**
+     * Class constructor
+     *
+     * @param name Benchmark name
+     * @param func Function to execute on each iteration
+     */
+    LocalBenchmark(const char *name, BenchmarkFunction func);
+
+    /**
+     * Execute the benchmark function once
+     */
+    virtual void execute();
+
+  private:
+
+    /** Contains the benchmark function to run */
+    BenchmarkFunction *m_func;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBTEST_LOCALBENCHMARK_H */
@@ -60,9 +60,9 @@ void StdoutReporter::reportAfter(TestInstance & test, TestResult & result)
 
     switch (result.getResult())
     {
-        case TestResult::Success: printf("%sOK\r\n", GREEN); break;
-        case TestResult::Failure: printf("%sFAIL\r\n%s\r\n", RED, *result.getDescription()); break;
-        case TestResult::Skipped: printf("%sSKIP\r\n", YELLOW); break;
+        case TestResult::Success: printf("%sOK%s (%u ms)\r\n", GREEN, WHITE, result.getDuration()); break;
+        case TestResult::Failure: printf("%sFAIL%s (%u ms)\r\n%s\r\n", RED, WHITE, result.getDuration(), *result.getDescription()); break;
+        case TestResult::Skipped: printf("%sSKIP%s (%u ms)\r\n", YELLOW, WHITE, result.getDuration()); break;
     }
     printf("%s", WHITE);
 
@@ -84,6 +84,15 @@ void StdoutReporter::reportFinish(List<TestInstance *> & tests)
     printf("(%d passed %d failed %d skipped %d total)\r\n",
             m_ok, m_fail, m_skip, (m_ok + m_fail + m_skip));
 
+    // Output the slowest tests, if more than one test ran
+    if (m_slowest[0] && m_slowest[1])
+    {
+        printf("%s: slowest tests:\r\n", basename(m_argv[0]));
+
+        for (Size i = 0; i < MaxSlowest && m_slowest[i]; i++)
+            printf("  %u ms %s\r\n", m_slowestTime[i], *m_slowest[i]->getName());
+    }
+
 #ifdef __HOST__
     fflush(stdout);
 #endif /* __HOST__ */
@@ -50,15 +50,16 @@ void TAPReporter::reportAfter(TestInstance & test, TestResult & result)
             case TestResult::Failure: printf("not ok %d %s %s\r\n", m_count, *test.getName(), *result.getDescription()); break;
             case TestResult::Skipped: printf("ok %d %s # SKIP\r\n", m_count, *test.getName()); break;
         }
+        printf("# time %u ms\r\n", result.getDuration());
         m_count++;
     }
     else
     {
         switch (result.getResult())
         {
-            case TestResult::Success: printf("# Finish %s OK\r\n", *test.getName()); break;
-            case TestResult::Failure: printf("# Finish %s FAIL\r\n", *test.getName()); break;
-            case TestResult::Skipped: printf("# Finish %s SKIP\r\n", *test.getName()); break;
+            case TestResult::Success: printf("# Finish %s OK %u ms\r\n", *test.getName(), result.getDuration()); break;
+            case TestResult::Failure: printf("# Finish %s FAIL %u ms\r\n", *test.getName(), result.getDuration()); break;
+            case TestResult::Skipped: printf("# Finish %s SKIP %u ms\r\n", *test.getName(), result.getDuration()); break;
         }
     }
 
@@ -69,6 +70,9 @@ void TAPReporter::reportAfter(TestInstance & test, TestResult & result)
 
 void TAPReporter::reportFinish(List<TestInstance *> & tests)
 {
+    for (Size i = 0; i < MaxSlowest && m_slowest[i]; i++)
+        printf("# Slowest %s %u ms\r\n", *m_slowest[i]->getName(), m_slowestTime[i]);
+
     if (m_multiline)
     {
         printf("# Completed ");
@@ -28,7 +28,26 @@ TestInstance::TestInstance(const char *name)
     TestSuite::instance->addTest(this);
 }
 
+TestInstance::~TestInstance()
+{
+}
+
 const String & TestInstance::getName() const
 {
     return m_name;
 }
+
+bool TestInstance::start()
+{
+    return false;
+}
+
+bool TestInstance::isFinished()
+{
+    return true;
+}
+
+TestResult TestInstance::finish()
+{
+    return run();
+}
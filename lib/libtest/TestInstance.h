@@ -43,6 +43,11 @@ class TestInstance
      */
     TestInstance(const char *name);
 
+    /**
+     * Destructor
+     */
+    virtual ~TestInstance();
+
     /**
      * Retrieve test instance name
      *
@@ -57,6 +62,29 @@ class TestInstance
      */
     virtual TestResult run() = 0;
 
+    /**
+     * Start the test instance in the background
+     *
+     * @return True if started, false if the test can only be executed with run()
+     */
+    virtual bool start();
+
+    /**
+     * Check if a test started in the background has completed
+     *
+     * This function must not block.
+     *
+     * @return True if completed, false otherwise
+     */
+    virtual bool isFinished();
+
+    /**
+     * Retrieve the result of a test started in the background
+     *
+     * @return TestResult
+     */
+    virtual TestResult finish();
+
   protected:
 
     /** Name of the test instance */
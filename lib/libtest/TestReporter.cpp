@@ -28,6 +28,12 @@ TestReporter::TestReporter(int argc, char **argv)
     m_report = true;
     m_statistics = true;
     m_multiline = false;
+
+    for (Size i = 0; i < MaxSlowest; i++)
+    {
+        m_slowest[i] = ZERO;
+        m_slowestTime[i] = 0;
+    }
 }
 
 TestReporter::~TestReporter()
@@ -83,6 +89,22 @@ void TestReporter::collect(TestInstance & test, TestResult & result)
 
     if (result.isSkipped())
         m_skip++;
+
+    // Keep track of the slowest tests
+    for (Size i = 0; i < MaxSlowest; i++)
+    {
+        if (!m_slowest[i] || result.getDuration() > m_slowestTime[i])
+        {
+            for (Size j = MaxSlowest - 1; j > i; j--)
+            {
+                m_slowest[j] = m_slowest[j - 1];
+                m_slowestTime[j] = m_slowestTime[j - 1];
+            }
+            m_slowest[i] = &test;
+            m_slowestTime[i] = result.getDuration();
+            break;
+        }
+    }
 }
 
 void TestReporter::begin(List<TestInstance *> & tests)
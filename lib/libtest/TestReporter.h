@@ -34,6 +34,11 @@
  */
 class TestReporter
 {
+  protected:
+
+    /** Number of slowest tests to include in the final report */
+    static const Size MaxSlowest = 5;
+
   public:
 
     /**
@@ -137,6 +142,12 @@ class TestReporter
 
     /** Test statistics */
     uint m_ok, m_fail, m_skip;
+
+    /** Slowest tests, ordered by decreasing duration */
+    TestInstance *m_slowest[MaxSlowest];
+
+    /** Duration in milliseconds of each slowest test */
+    uint m_slowestTime[MaxSlowest];
 };
 
 /**
@@ -18,7 +18,7 @@
 #include "TestResult.h"
 
 TestResult::TestResult(Result result, const char *description)
-    : m_result(result), m_description(description, true)
+    : m_result(result), m_description(description, true), m_duration(0)
 {
 }
 
@@ -46,3 +46,13 @@ String & TestResult::getDescription()
 {
     return m_description;
 }
+
+uint TestResult::getDuration() const
+{
+    return m_duration;
+}
+
+void TestResult::setDuration(uint msec)
+{
+    m_duration = msec;
+}
@@ -18,6 +18,7 @@
 #ifndef __LIBTEST_TESTRESULT_H
 #define __LIBTEST_TESTRESULT_H
 
+#include <Types.h>
 #include <String.h>
 
 /**
@@ -90,6 +91,20 @@ class TestResult
      */
     String & getDescription();
 
+    /**
+     * Get wall-clock duration of the test.
+     *
+     * @return Duration in milliseconds
+     */
+    uint getDuration() const;
+
+    /**
+     * Set wall-clock duration of the test.
+     *
+     * @param msec Duration in milliseconds
+     */
+    void setDuration(uint msec);
+
   private:
 
     /** The result code for this test. */
@@ -97,6 +112,9 @@ class TestResult
 
     /** Text describing the result. */
     String m_description;
+
+    /** Duration of the test in milliseconds. */
+    uint m_duration;
 };
 
 /**
@@ -16,6 +16,9 @@
  */
 
 #include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/time.h>
 #include <ListIterator.h>
 #include "TestCase.h"
 #include "TestSuite.h"
@@ -30,10 +33,17 @@ TestRunner::TestRunner(int argc, char **argv)
     m_argc = argc;
     m_argv = argv;
     m_reporter = new StdoutReporter(argc, argv);
+    m_jobs = 1;
 
     // Check for command-line specified arguments.
     for (int i = 0; i < argc; i++)
     {
+        if ((strcmp(argv[i], "-j") == 0 || strcmp(argv[i], "--jobs") == 0) && i < argc - 1)
+        {
+            m_jobs = atoi(argv[i+1]);
+            if (m_jobs == 0)
+                m_jobs = 1;
+        }
         if (strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--tap") == 0)
         {
             if (m_reporter)
@@ -74,17 +84,106 @@ int TestRunner::run(void)
     m_reporter->begin(*tests);
 
     // Execute tests. Report per-test stats.
-    for (ListIterator<TestInstance *> i(tests); i.hasCurrent(); i++)
+    if (m_jobs > 1)
     {
-        TestInstance *test = i.current();
-        if (!test)
-            break;
+        runParallel(*tests);
+    }
+    else
+    {
+        for (ListIterator<TestInstance *> i(tests); i.hasCurrent(); i++)
+        {
+            TestInstance *test = i.current();
+            if (!test)
+                break;
 
-        m_reporter->prepare(*test);
-        TestResult result = test->run();
-        m_reporter->collect(*test, result);
+            runTest(*test);
+        }
     }
     // Finish testing. Report final stats.
     m_reporter->finish(*tests);
     return m_reporter->getFailed();
 }
+
+void TestRunner::runTest(TestInstance & test)
+{
+    m_reporter->prepare(test);
+
+    uint started = milliseconds();
+    TestResult result = test.run();
+    result.setDuration(milliseconds() - started);
+
+    m_reporter->collect(test, result);
+}
+
+void TestRunner::runParallel(List<TestInstance *> & tests)
+{
+    TestInstance **running = new TestInstance * [m_jobs];
+    uint *started = new uint[m_jobs];
+    ListIterator<TestInstance *> i(tests);
+    Size active = 0;
+
+    for (Size j = 0; j < m_jobs; j++)
+        running[j] = ZERO;
+
+    while (i.hasCurrent() || active > 0)
+    {
+        // Start tests in free job slots
+        for (Size j = 0; j < m_jobs && i.hasCurrent(); j++)
+        {
+            if (running[j])
+                continue;
+
+            TestInstance *test = i.current();
+            i++;
+
+            started[j] = milliseconds();
+
+            if (test->start())
+            {
+                running[j] = test;
+                active++;
+            }
+            else
+                runTest(*test);
+        }
+
+        // Report tests which completed, in order of completion
+        Size completed = 0;
+
+        for (Size j = 0; j < m_jobs; j++)
+        {
+            if (running[j] && running[j]->isFinished())
+            {
+                uint duration = milliseconds() - started[j];
+
+                m_reporter->prepare(*running[j]);
+                TestResult result = running[j]->finish();
+                result.setDuration(duration);
+                m_reporter->collect(*running[j], result);
+
+                running[j] = ZERO;
+                active--;
+                completed++;
+            }
+        }
+
+#ifdef __HOST__
+        // Avoid spinning while all job slots are busy
+        if (!completed && (active == m_jobs || !i.hasCurrent()))
+            usleep(1000);
+#endif /* __HOST__ */
+    }
+
+    delete[] running;
+    delete[] started;
+}
+
+uint TestRunner::milliseconds() const
+{
+    struct timeval tv;
+
+    if (gettimeofday(&tv, ZERO) != 0)
+        return 0;
+
+    return (tv.tv_sec * 1000) + (tv.tv_usec / 1000);
+}
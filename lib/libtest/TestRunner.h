@@ -18,6 +18,7 @@
 #ifndef __LIBTEST_TESTRUNNER_H
 #define __LIBTEST_TESTRUNNER_H
 
+#include <Types.h>
 #include "TestCase.h"
 
 class TestReporter;
@@ -32,6 +33,10 @@ class TestReporter;
 
 /**
  * Reponsible for discovering and running tests
+ *
+ * Tests run one at a time by default. With the -j (--jobs) argument,
+ * tests which support background execution, such as ExternalTest,
+ * run in parallel with the given maximum number of jobs.
  */
 class TestRunner
 {
@@ -64,6 +69,33 @@ class TestRunner
      */
     int run(void);
 
+  private:
+
+    /**
+     * Run a single test and report the result
+     *
+     * @param test Test to run
+     */
+    void runTest(TestInstance & test);
+
+    /**
+     * Run tests in parallel
+     *
+     * Tests which support background execution run in up to
+     * the configured number of jobs at the same time. Other tests
+     * run in the foreground as soon as they are selected.
+     *
+     * @param tests List of tests to run
+     */
+    void runParallel(List<TestInstance *> & tests);
+
+    /**
+     * Get the current wall-clock time
+     *
+     * @return Time in milliseconds
+     */
+    uint milliseconds() const;
+
   protected:
 
     /** Program argument count */
@@ -74,6 +106,9 @@ class TestRunner
 
     /** Reports test results */
     TestReporter *m_reporter;
+
+    /** Maximum number of tests to run in parallel */
+    Size m_jobs;
 };
 
 /**
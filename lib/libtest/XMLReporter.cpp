@@ -52,16 +52,11 @@ void XMLReporter::reportBegin(List<TestInstance *> & tests)
 
 void XMLReporter::reportBefore(TestInstance & test)
 {
+    // The testcase element is written after completion, including its duration
     if (m_multiline)
     {
         printf("<!-- Start %s -->\r\n", *test.m_name);
     }
-    else
-    {
-        printf("   <testcase id=\"%s.%s\" name=\"%s.%s\">\r\n",
-                m_argv[0], *test.m_name,
-                m_argv[0], *test.m_name);
-    }
 
 #ifdef __HOST__
     fflush(stdout);
@@ -74,13 +69,21 @@ void XMLReporter::reportAfter(TestInstance & test, TestResult & result)
     {
         switch (result.getResult())
         {
-            case TestResult::Success: printf("<!-- Finish %s OK -->\r\n", *test.m_name); break;
-            case TestResult::Failure: printf("<!-- Finish %s FAIL -->\r\n", *test.m_name); break;
-            case TestResult::Skipped: printf("<!-- Finish %s SKIP -->\r\n", *test.m_name); break;
+            case TestResult::Success: printf("<!-- Finish %s OK %u ms -->\r\n", *test.m_name, result.getDuration()); break;
+            case TestResult::Failure: printf("<!-- Finish %s FAIL %u ms -->\r\n", *test.m_name, result.getDuration()); break;
+            case TestResult::Skipped: printf("<!-- Finish %s SKIP %u ms -->\r\n", *test.m_name, result.getDuration()); break;
         }
     }
     else
     {
+        const uint msec = result.getDuration();
+
+        // Duration in seconds with three decimals
+        printf("   <testcase id=\"%s.%s\" name=\"%s.%s\" time=\"%u.%u%u%u\">\r\n",
+                m_argv[0], *test.m_name,
+                m_argv[0], *test.m_name,
+                msec / 1000, (msec / 100) % 10, (msec / 10) % 10, msec % 10);
+
         switch (result.getResult())
         {
             case TestResult::Success:
@@ -107,6 +110,9 @@ void XMLReporter::reportAfter(TestInstance & test, TestResult & result)
 
 void XMLReporter::reportFinish(List<TestInstance *> & tests)
 {
+    for (Size i = 0; i < MaxSlowest && m_slowest[i]; i++)
+        printf("<!-- Slowest %s %u ms -->\r\n", *m_slowest[i]->getName(), m_slowestTime[i]);
+
     if (m_multiline)
         printf("</testsuites>\r\n"
                "<!-- Completed ");
@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <MemoryBlock.h>
+#include "VirtQueue.h"
+
+/** Alignment of the used ring in the legacy layout */
+#define VIRTQ_USED_ALIGN 4096
+
+VirtQueue::VirtQueue(u16 index)
+    : m_index(index)
+{
+    m_size           = 0;
+    m_notifyOffset   = 0;
+    m_indirect       = false;
+    m_eventIndex     = false;
+    m_descriptors    = ZERO;
+    m_available      = ZERO;
+    m_used           = ZERO;
+    m_usedRing       = ZERO;
+    m_freeHead       = 0;
+    m_freeCount      = 0;
+    m_availableIndex = 0;
+    m_publishedIndex = 0;
+    m_usedIndex      = 0;
+    MemoryBlock::set(&m_rings, 0, sizeof(m_rings));
+    MemoryBlock::set(&m_tables, 0, sizeof(m_tables));
+}
+
+VirtQueue::Result VirtQueue::initialize(u16 size, bool indirect, bool eventIndex)
+{
+    if (!size || (size & (size - 1)))
+        return InvalidArgument;
+
+    m_size       = size;
+    m_indirect   = indirect;
+    m_eventIndex = eventIndex;
+
+    // Descriptors and available ring, followed by the used ring on the next boundary
+    const Size availableEnd = (sizeof(Descriptor) * size) + (sizeof(u16) * (3 + size));
+    const Size usedOffset = (availableEnd + VIRTQ_USED_ALIGN - 1) & ~(VIRTQ_USED_ALIGN - 1);
+    const Size usedEnd = usedOffset + (sizeof(u16) * 3) + (sizeof(UsedElement) * size);
+
+    // Allocate physically contiguous memory for the rings
+    m_rings.virt   = ZERO;
+    m_rings.phys   = ZERO;
+    m_rings.size   = (usedEnd + PAGESIZE - 1) & ~(PAGESIZE - 1);
+    m_rings.access = Memory::User | Memory::Readable | Memory::Writable;
+
+    if (VMCtl(SELF, Map, &m_rings) != API::Success)
+        return OutOfMemory;
+
+    MemoryBlock::set((void *) m_rings.virt, 0, m_rings.size);
+
+    m_descriptors = (volatile Descriptor *) m_rings.virt;
+    m_available   = (volatile u16 *) (m_rings.virt + (sizeof(Descriptor) * size));
+    m_used        = (volatile u16 *) (m_rings.virt + usedOffset);
+    m_usedRing    = (volatile UsedElement *) (m_used + 2);
+
+    // One indirect table per descriptor, since each request needs only one
+    if (m_indirect)
+    {
+        m_tables.virt   = ZERO;
+        m_tables.phys   = ZERO;
+        m_tables.size   = (sizeof(Descriptor) * MaximumBuffers * size + PAGESIZE - 1) & ~(PAGESIZE - 1);
+        m_tables.access = Memory::User | Memory::Readable | Memory::Writable;
+
+        if (VMCtl(SELF, Map, &m_tables) != API::Success)
+            return OutOfMemory;
+    }
+
+    // All descriptors start on the free list
+    for (u16 i = 0; i < size; i++)
+        m_descriptors[i].next = i + 1;
+
+    m_freeHead       = 0;
+    m_freeCount      = size;
+    m_availableIndex = 0;
+    m_publishedIndex = 0;
+    m_usedIndex      = 0;
+    return Success;
+}
+
+u16 VirtQueue::getIndex() const
+{
+    return m_index;
+}
+
+u16 VirtQueue::getSize() const
+{
+    return m_size;
+}
+
+Address VirtQueue::getDescriptorAddress() const
+{
+    return m_rings.phys;
+}
+
+Address VirtQueue::getAvailableAddress() const
+{
+    return m_rings.phys + ((Address) m_available - m_rings.virt);
+}
+
+Address VirtQueue::getUsedAddress() const
+{
+    return m_rings.phys + ((Address) m_used - m_rings.virt);
+}
+
+Size VirtQueue::getNotifyOffset() const
+{
+    return m_notifyOffset;
+}
+
+void VirtQueue::setNotifyOffset(Size offset)
+{
+    m_notifyOffset = offset;
+}
+
+VirtQueue::Result VirtQueue::submit(const Buffer *buffers, Size count, u16 *token)
+{
+    const bool indirect = m_indirect && count > 1;
+    u16 head = 0;
+
+    if (!count || count > MaximumBuffers)
+        return InvalidArgument;
+
+    if (m_freeCount < (indirect ? 1 : count))
+        return Full;
+
+    if (indirect)
+    {
+        // The request occupies a single descriptor pointing to its own table
+        head = allocate();
+
+        const Size offset = sizeof(Descriptor) * MaximumBuffers * head;
+        volatile Descriptor *table = (volatile Descriptor *) (m_tables.virt + offset);
+
+        for (Size i = 0; i < count; i++)
+        {
+            table[i].address = buffers[i].phys;
+            table[i].length  = buffers[i].size;
+            table[i].flags   = (buffers[i].writable ? Write : 0) | (i + 1 < count ? Next : 0);
+            table[i].next    = i + 1;
+        }
+
+        m_descriptors[head].address = m_tables.phys + offset;
+        m_descriptors[head].length  = sizeof(Descriptor) * count;
+        m_descriptors[head].flags   = Indirect;
+    }
+    else
+    {
+        // Chain descriptors from the free list, last buffer first
+        u16 next = 0;
+
+        for (Size i = count; i > 0; i--)
+        {
+            head = allocate();
+
+            m_descriptors[head].address = buffers[i - 1].phys;
+            m_descriptors[head].length  = buffers[i - 1].size;
+            m_descriptors[head].flags   = (buffers[i - 1].writable ? Write : 0) | (i < count ? Next : 0);
+            m_descriptors[head].next    = next;
+            next = head;
+        }
+    }
+
+    m_available[2 + (m_availableIndex & (m_size - 1))] = head;
+    m_availableIndex++;
+    *token = head;
+    return Success;
+}
+
+bool VirtQueue::kick()
+{
+    const u16 previous = m_publishedIndex;
+    const u16 current  = m_availableIndex;
+
+    if (previous == current)
+        return false;
+
+    // Descriptors and ring entries must be visible before the index
+    __sync_synchronize();
+    m_available[1] = current;
+    m_publishedIndex = current;
+
+    // The index must be visible before the device's notification state is read
+    __sync_synchronize();
+
+    if (m_eventIndex)
+    {
+        const u16 event = m_used[2 + (sizeof(UsedElement) / sizeof(u16) * m_size)];
+        return (u16) (current - event - 1) < (u16) (current - previous);
+    }
+    else
+        return !(m_used[0] & NoNotify);
+}
+
+VirtQueue::Result VirtQueue::getCompleted(u16 *token, u32 *length)
+{
+    if (m_usedIndex == getUsedIndex())
+        return Empty;
+
+    // Read the entry only after the index that covers it
+    __sync_synchronize();
+
+    const volatile UsedElement *element = &m_usedRing[m_usedIndex & (m_size - 1)];
+    *token  = element->id;
+    *length = element->length;
+    m_usedIndex++;
+
+    release(*token);
+    return Success;
+}
+
+bool VirtQueue::enableInterrupts()
+{
+    if (m_eventIndex)
+        m_available[2 + m_size] = m_usedIndex;
+    else
+        m_available[0] = 0;
+
+    // Completions added before the device saw the update raise no interrupt
+    __sync_synchronize();
+    return m_usedIndex != getUsedIndex();
+}
+
+void VirtQueue::disableInterrupts()
+{
+    // An event index just behind the device is not reached until it wraps around
+    if (m_eventIndex)
+        m_available[2 + m_size] = m_usedIndex - 1;
+    else
+        m_available[0] = NoInterrupt;
+}
+
+u16 VirtQueue::allocate()
+{
+    const u16 desc = m_freeHead;
+
+    m_freeHead = m_descriptors[desc].next;
+    m_freeCount--;
+    return desc;
+}
+
+void VirtQueue::release(u16 head)
+{
+    u16 tail = head;
+
+    m_freeCount++;
+
+    while (m_descriptors[tail].flags & Next)
+    {
+        tail = m_descriptors[tail].next;
+        m_freeCount++;
+    }
+
+    m_descriptors[tail].next = m_freeHead;
+    m_freeHead = head;
+}
+
+u16 VirtQueue::getUsedIndex() const
+{
+    return m_used[1];
+}
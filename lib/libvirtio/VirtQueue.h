@@ -0,0 +1,314 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBVIRTIO_VIRTQUEUE_H
+#define __LIBVIRTIO_VIRTQUEUE_H
+
+#include <Types.h>
+#include <Memory.h>
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libvirtio
+ * @{
+ */
+
+/**
+ * Split virtqueue shared between a driver and a virtio device.
+ *
+ * Requests are chains of buffers. A request with more than one buffer
+ * occupies a single ring descriptor when indirect descriptors are negotiated,
+ * such that the ring holds as many requests in flight as it has descriptors.
+ * Submitted requests are published to the device in batches by kick().
+ */
+class VirtQueue
+{
+  public:
+
+    /** Maximum number of buffers in a single request */
+    static const Size MaximumBuffers = 16;
+
+    /**
+     * Result codes
+     */
+    enum Result
+    {
+        Success,
+        InvalidArgument,
+        OutOfMemory,
+        Full,
+        Empty
+    };
+
+    /**
+     * Buffer in a request.
+     */
+    typedef struct Buffer
+    {
+        /** Physical address */
+        Address phys;
+
+        /** Size in bytes */
+        Size size;
+
+        /** True if the device writes to the buffer */
+        bool writable;
+    }
+    Buffer;
+
+  private:
+
+    /**
+     * Descriptor flags.
+     */
+    enum DescriptorFlags
+    {
+        Next     = (1 << 0),
+        Write    = (1 << 1),
+        Indirect = (1 << 2)
+    };
+
+    /**
+     * Ring flags.
+     */
+    enum RingFlags
+    {
+        NoNotify    = (1 << 0),
+        NoInterrupt = (1 << 0)
+    };
+
+    /**
+     * Descriptor table entry.
+     */
+    typedef struct Descriptor
+    {
+        u64 address;
+        u32 length;
+        u16 flags;
+        u16 next;
+    }
+    Descriptor;
+
+    /**
+     * Used ring entry.
+     */
+    typedef struct UsedElement
+    {
+        u32 id;
+        u32 length;
+    }
+    UsedElement;
+
+  public:
+
+    /**
+     * Constructor
+     *
+     * @param index Queue number on the device
+     */
+    VirtQueue(u16 index);
+
+    /**
+     * Allocate the rings.
+     *
+     * Uses the legacy layout, with the used ring on a separate page,
+     * which is also valid for modern devices.
+     *
+     * @param size Number of descriptors, must be a power of two.
+     * @param indirect True if indirect descriptors are negotiated.
+     * @param eventIndex True if event index notification suppression is negotiated.
+     *
+     * @return Result code
+     */
+    Result initialize(u16 size, bool indirect, bool eventIndex);
+
+    /**
+     * Get queue number.
+     *
+     * @return Queue number on the device
+     */
+    u16 getIndex() const;
+
+    /**
+     * Get number of descriptors.
+     *
+     * @return Queue size
+     */
+    u16 getSize() const;
+
+    /**
+     * Get physical address of the descriptor table.
+     *
+     * @return Physical address
+     */
+    Address getDescriptorAddress() const;
+
+    /**
+     * Get physical address of the available ring.
+     *
+     * @return Physical address
+     */
+    Address getAvailableAddress() const;
+
+    /**
+     * Get physical address of the used ring.
+     *
+     * @return Physical address
+     */
+    Address getUsedAddress() const;
+
+    /**
+     * Get offset of the notification register.
+     *
+     * @return Offset in the notification area of the transport
+     */
+    Size getNotifyOffset() const;
+
+    /**
+     * Set offset of the notification register.
+     *
+     * @param offset Offset in the notification area of the transport
+     */
+    void setNotifyOffset(Size offset);
+
+    /**
+     * Add a request to the available ring.
+     *
+     * The request is not visible to the device until kick() is called.
+     *
+     * @param buffers Array of buffers. Buffers read by the device come first.
+     * @param count Number of buffers
+     * @param token Output identifier of the request, returned again on completion.
+     *
+     * @return Result code. Full if not enough descriptors are free.
+     */
+    Result submit(const Buffer *buffers, Size count, u16 *token);
+
+    /**
+     * Publish submitted requests to the device.
+     *
+     * @return True if the device must be notified.
+     */
+    bool kick();
+
+    /**
+     * Take a completed request from the used ring.
+     *
+     * @param token Output identifier of the request
+     * @param length Output number of bytes written by the device
+     *
+     * @return Result code. Empty if no request completed.
+     */
+    Result getCompleted(u16 *token, u32 *length);
+
+    /**
+     * Request an interrupt for the next completed request.
+     *
+     * @return True if more requests completed in the meantime, which
+     *         must be taken with getCompleted() before waiting for the interrupt.
+     */
+    bool enableInterrupts();
+
+    /**
+     * Suppress interrupts for completed requests.
+     *
+     * Completions are then only taken when the driver polls with getCompleted().
+     */
+    void disableInterrupts();
+
+  private:
+
+    /**
+     * Get a descriptor from the free list.
+     *
+     * @return Descriptor number
+     */
+    u16 allocate();
+
+    /**
+     * Return a chain of descriptors to the free list.
+     *
+     * @param head First descriptor of the chain
+     */
+    void release(u16 head);
+
+    /**
+     * Get index of the device in the used ring.
+     *
+     * @return Used ring index
+     */
+    u16 getUsedIndex() const;
+
+  private:
+
+    /** Queue number on the device */
+    const u16 m_index;
+
+    /** Number of descriptors */
+    u16 m_size;
+
+    /** Offset of the notification register */
+    Size m_notifyOffset;
+
+    /** True if indirect descriptors are used */
+    bool m_indirect;
+
+    /** True if event index notification suppression is used */
+    bool m_eventIndex;
+
+    /** Physically contiguous memory for the rings */
+    Memory::Range m_rings;
+
+    /** Physically contiguous memory for the indirect descriptor tables */
+    Memory::Range m_tables;
+
+    /** Descriptor table */
+    volatile Descriptor *m_descriptors;
+
+    /** Available ring: flags, index, ring and used event */
+    volatile u16 *m_available;
+
+    /** Used ring header: flags and index */
+    volatile u16 *m_used;
+
+    /** Used ring entries */
+    volatile UsedElement *m_usedRing;
+
+    /** First descriptor of the free list */
+    u16 m_freeHead;
+
+    /** Number of free descriptors */
+    u16 m_freeCount;
+
+    /** Available ring index, including requests not yet published */
+    u16 m_availableIndex;
+
+    /** Available ring index at the last kick */
+    u16 m_publishedIndex;
+
+    /** Used ring index of the next completed request to take */
+    u16 m_usedIndex;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBVIRTIO_VIRTQUEUE_H */
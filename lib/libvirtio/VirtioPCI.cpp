@@ -0,0 +1,312 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <intel/IntelAPIC.h>
+#include <MemoryBlock.h>
+#include <Log.h>
+#include "VirtioPCI.h"
+
+/** First PCI device identifier of transitional devices, for type 1 */
+#define VIRTIO_PCI_LEGACY_DEVICE 0x1000
+
+/** PCI device identifier of modern devices, for type 0 */
+#define VIRTIO_PCI_MODERN_DEVICE 0x1040
+
+VirtioPCI::VirtioPCI()
+{
+    m_modern = false;
+    m_msix   = false;
+    m_notifyMultiplier = 0;
+    MemoryBlock::set(&m_function, 0, sizeof(m_function));
+}
+
+VirtioPCI::Result VirtioPCI::initialize(DeviceType type, Size index)
+{
+    IntelPCI::BAR bar;
+
+    if (m_pci.find(VendorID, VIRTIO_PCI_LEGACY_DEVICE + type - 1, &m_function, index) != IntelPCI::Success &&
+        m_pci.find(VendorID, VIRTIO_PCI_MODERN_DEVICE + type, &m_function, index) != IntelPCI::Success)
+    {
+        return NotFound;
+    }
+
+    m_pci.enable(m_function, IntelPCI::IOSpace | IntelPCI::MemorySpace | IntelPCI::BusMaster);
+
+    // Prefer the modern transport, if the device offers it
+    if (mapModern() == Success)
+        m_modern = true;
+    else if (m_pci.readBAR(m_function, 0, &bar) == IntelPCI::Success && bar.io)
+        m_legacy.setBase(bar.address);
+    else
+    {
+        ERROR("no usable transport for virtio device " << m_function.deviceId);
+        return IOError;
+    }
+
+    // Reset, which completes once the status reads back as zero
+    setStatus(0);
+    while (getStatus() != 0)
+        ;
+
+    return Success;
+}
+
+const IntelPCI::Function & VirtioPCI::getFunction() const
+{
+    return m_function;
+}
+
+bool VirtioPCI::isModern() const
+{
+    return m_modern;
+}
+
+VirtioPCI::Result VirtioPCI::negotiate(u64 wanted, u64 *accepted)
+{
+    u64 features;
+
+    setStatus(Acknowledge);
+    setStatus(Acknowledge | Driver);
+
+    if (m_modern)
+    {
+        m_common.write(DeviceFeatureSelect, 0);
+        features = m_common.read(DeviceFeature);
+        m_common.write(DeviceFeatureSelect, 1);
+        features |= (u64) m_common.read(DeviceFeature) << 32;
+
+        // Modern devices require the driver to accept the modern interface
+        *accepted = features & (wanted | ((u64) 1 << Version1));
+        if (!(*accepted & ((u64) 1 << Version1)))
+        {
+            setStatus(Failed);
+            return IOError;
+        }
+
+        m_common.write(DriverFeatureSelect, 0);
+        m_common.write(DriverFeature, *accepted & 0xffffffff);
+        m_common.write(DriverFeatureSelect, 1);
+        m_common.write(DriverFeature, *accepted >> 32);
+
+        setStatus(Acknowledge | Driver | FeaturesOK);
+        if (!(getStatus() & FeaturesOK))
+        {
+            setStatus(Failed);
+            return IOError;
+        }
+    }
+    else
+    {
+        // Legacy devices only have the lower 32 feature bits
+        features = m_legacy.inl(LegacyDeviceFeatures);
+        *accepted = features & wanted & 0xffffffff;
+        m_legacy.outl(LegacyDriverFeatures, *accepted);
+    }
+
+    return Success;
+}
+
+VirtioPCI::Result VirtioPCI::enableInterrupts(uint *irq)
+{
+    SystemInformation info;
+
+    if (m_pci.getMSIInterrupt(m_function, irq) != IntelPCI::Success ||
+        m_pci.enableMSIX(m_function, info.coreId, IntelAPIC::InterruptBase + *irq) != IntelPCI::Success)
+    {
+        ERROR("MSI-X is not supported by virtio device " << m_function.deviceId);
+        return NotFound;
+    }
+    m_msix = true;
+
+    // Configuration changes use the same table entry as the queues
+    if (m_modern)
+        writeWord(m_common, ConfigVector, InterruptEntry);
+    else
+        m_legacy.outw(LegacyConfigVector, InterruptEntry);
+
+    return Success;
+}
+
+VirtioPCI::Result VirtioPCI::setupQueue(VirtQueue *queue, bool indirect, bool eventIndex)
+{
+    const u16 index = queue->getIndex();
+    u16 size;
+
+    if (m_modern)
+    {
+        writeWord(m_common, QueueSelect, index);
+        size = readWord(m_common, QueueSize);
+    }
+    else
+    {
+        m_legacy.outw(LegacyQueueSelect, index);
+        size = m_legacy.inw(LegacyQueueSize);
+    }
+
+    if (!size)
+        return NotFound;
+
+    if (queue->initialize(size, indirect, eventIndex) != VirtQueue::Success)
+        return OutOfMemory;
+
+    if (m_modern)
+    {
+        m_common.write(QueueDescriptor,     queue->getDescriptorAddress());
+        m_common.write(QueueDescriptor + 4, 0);
+        m_common.write(QueueAvailable,      queue->getAvailableAddress());
+        m_common.write(QueueAvailable + 4,  0);
+        m_common.write(QueueUsed,           queue->getUsedAddress());
+        m_common.write(QueueUsed + 4,       0);
+
+        if (m_msix)
+        {
+            writeWord(m_common, QueueVector, InterruptEntry);
+            if (readWord(m_common, QueueVector) != InterruptEntry)
+                return IOError;
+        }
+
+        queue->setNotifyOffset(readWord(m_common, QueueNotifyOffset) * m_notifyMultiplier);
+        writeWord(m_common, QueueEnable, 1);
+    }
+    else
+    {
+        if (m_msix)
+            m_legacy.outw(LegacyQueueVector, InterruptEntry);
+
+        // Legacy devices take the page number of the descriptor table
+        m_legacy.outl(LegacyQueueAddress, queue->getDescriptorAddress() / PAGESIZE);
+    }
+
+    return Success;
+}
+
+void VirtioPCI::setReady()
+{
+    setStatus(getStatus() | DriverOK);
+}
+
+void VirtioPCI::notify(const VirtQueue *queue)
+{
+    if (m_modern)
+        writeWord(m_notify, queue->getNotifyOffset(), queue->getIndex());
+    else
+        m_legacy.outw(LegacyQueueNotify, queue->getIndex());
+}
+
+u32 VirtioPCI::readConfig(Size offset)
+{
+    if (m_modern)
+        return m_device.read(offset);
+    else
+        return m_legacy.inl((m_msix ? LegacyConfigMSIX : LegacyConfig) + offset);
+}
+
+u8 VirtioPCI::readConfigByte(Size offset)
+{
+    if (m_modern)
+        return readByte(m_device, offset);
+    else
+        return m_legacy.inb((m_msix ? LegacyConfigMSIX : LegacyConfig) + offset);
+}
+
+VirtioPCI::Result VirtioPCI::mapModern()
+{
+    u8 common = 0, notify = 0, device = 0;
+
+    // Vendor capabilities describe where each register structure lives
+    for (u8 cap = m_pci.findCapability(m_function, IntelPCI::VendorCapability);
+         cap != 0;
+         cap = m_pci.findCapability(m_function, IntelPCI::VendorCapability, cap))
+    {
+        switch (m_pci.readByte(m_function, cap + 3))
+        {
+            case CommonConfig: if (!common) common = cap; break;
+            case NotifyConfig: if (!notify) notify = cap; break;
+            case DeviceConfig: if (!device) device = cap; break;
+            default: break;
+        }
+    }
+
+    if (!common || !notify || !device)
+        return NotFound;
+
+    if (mapCapability(common, &m_common) != Success ||
+        mapCapability(notify, &m_notify) != Success ||
+        mapCapability(device, &m_device) != Success)
+        return IOError;
+
+    m_notifyMultiplier = m_pci.readLong(m_function, notify + 16);
+    return Success;
+}
+
+VirtioPCI::Result VirtioPCI::mapCapability(u8 cap, IntelIO *io)
+{
+    IntelPCI::BAR bar;
+    const u8 index = m_pci.readByte(m_function, cap + 4);
+    const u32 offset = m_pci.readLong(m_function, cap + 8);
+    const u32 length = m_pci.readLong(m_function, cap + 12);
+
+    if (m_pci.readBAR(m_function, index, &bar) != IntelPCI::Success || bar.io)
+        return NotFound;
+
+    const Address base = bar.address + offset;
+    const Size pageOffset = base & ~PAGEMASK;
+
+    if (io->map(base & PAGEMASK, (pageOffset + length + PAGESIZE - 1) & PAGEMASK,
+                Memory::User | Memory::Readable | Memory::Writable | Memory::Device) != IO::Success)
+        return IOError;
+
+    io->setBase(io->getBase() + pageOffset);
+    return Success;
+}
+
+u8 VirtioPCI::getStatus()
+{
+    if (m_modern)
+        return readByte(m_common, DeviceStatus);
+    else
+        return m_legacy.inb(LegacyDeviceStatus);
+}
+
+void VirtioPCI::setStatus(u8 status)
+{
+    if (m_modern)
+        writeByte(m_common, DeviceStatus, status);
+    else
+        m_legacy.outb(LegacyDeviceStatus, status);
+}
+
+u8 VirtioPCI::readByte(const IntelIO & io, Size offset) const
+{
+    return *(volatile u8 *) (io.getBase() + offset);
+}
+
+u16 VirtioPCI::readWord(const IntelIO & io, Size offset) const
+{
+    return *(volatile u16 *) (io.getBase() + offset);
+}
+
+void VirtioPCI::writeByte(IntelIO & io, Size offset, u8 value)
+{
+    *(volatile u8 *) (io.getBase() + offset) = value;
+}
+
+void VirtioPCI::writeWord(IntelIO & io, Size offset, u16 value)
+{
+    *(volatile u16 *) (io.getBase() + offset) = value;
+}
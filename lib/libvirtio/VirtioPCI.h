@@ -0,0 +1,320 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBVIRTIO_VIRTIOPCI_H
+#define __LIBVIRTIO_VIRTIOPCI_H
+
+#include <Types.h>
+#include <intel/IntelIO.h>
+#include <PCIClient.h>
+#include "VirtQueue.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libvirtio
+ * @{
+ */
+
+/**
+ * Virtio device on the PCI bus.
+ *
+ * Supports both the modern transport, with its registers in memory
+ * space described by vendor capabilities, and the legacy transport
+ * in the I/O space of BAR0. The modern transport is preferred when
+ * the device offers both.
+ */
+class VirtioPCI
+{
+  public:
+
+    /** PCI vendor identifier of virtio devices */
+    static const u16 VendorID = 0x1af4;
+
+    /**
+     * Result codes
+     */
+    enum Result
+    {
+        Success,
+        NotFound,
+        IOError,
+        OutOfMemory
+    };
+
+    /**
+     * Virtio device types.
+     */
+    enum DeviceType
+    {
+        NetworkDevice = 1,
+        BlockDevice   = 2
+    };
+
+    /**
+     * Device status flags.
+     */
+    enum Status
+    {
+        Acknowledge = (1 << 0),
+        Driver      = (1 << 1),
+        DriverOK    = (1 << 2),
+        FeaturesOK  = (1 << 3),
+        Failed      = (1 << 7)
+    };
+
+    /**
+     * Feature bits shared by all device types.
+     */
+    enum Features
+    {
+        IndirectDescriptors = 28,
+        EventIndex          = 29,
+        Version1            = 32
+    };
+
+  private:
+
+    /**
+     * Legacy registers in I/O space.
+     */
+    enum LegacyRegisters
+    {
+        LegacyDeviceFeatures = 0x00,
+        LegacyDriverFeatures = 0x04,
+        LegacyQueueAddress   = 0x08,
+        LegacyQueueSize      = 0x0c,
+        LegacyQueueSelect    = 0x0e,
+        LegacyQueueNotify    = 0x10,
+        LegacyDeviceStatus   = 0x12,
+        LegacyISRStatus      = 0x13,
+        LegacyConfigVector   = 0x14,
+        LegacyQueueVector    = 0x16,
+        LegacyConfig         = 0x14,
+        LegacyConfigMSIX     = 0x18
+    };
+
+    /**
+     * Modern common configuration registers.
+     */
+    enum CommonRegisters
+    {
+        DeviceFeatureSelect = 0x00,
+        DeviceFeature       = 0x04,
+        DriverFeatureSelect = 0x08,
+        DriverFeature       = 0x0c,
+        ConfigVector        = 0x10,
+        DeviceStatus        = 0x14,
+        QueueSelect         = 0x16,
+        QueueSize           = 0x18,
+        QueueVector         = 0x1a,
+        QueueEnable         = 0x1c,
+        QueueNotifyOffset   = 0x1e,
+        QueueDescriptor     = 0x20,
+        QueueAvailable      = 0x28,
+        QueueUsed           = 0x30
+    };
+
+    /**
+     * Structure types of the vendor capabilities.
+     */
+    enum CapabilityType
+    {
+        CommonConfig = 1,
+        NotifyConfig = 2,
+        ISRConfig    = 3,
+        DeviceConfig = 4
+    };
+
+    /** MSI-X table entry used for all interrupts */
+    static const u16 InterruptEntry = 0;
+
+  public:
+
+    /**
+     * Constructor
+     */
+    VirtioPCI();
+
+    /**
+     * Find and reset a virtio device.
+     *
+     * @param type Device type to find
+     * @param index Use the index'th device of the given type
+     *
+     * @return Result code
+     */
+    Result initialize(DeviceType type, Size index = 0);
+
+    /**
+     * Get the PCI function of the device.
+     *
+     * @return PCI function
+     */
+    const IntelPCI::Function & getFunction() const;
+
+    /**
+     * Check if the modern transport is used.
+     *
+     * @return True for modern, false for legacy.
+     */
+    bool isModern() const;
+
+    /**
+     * Negotiate features with the device.
+     *
+     * @param wanted Feature bits supported by the driver
+     * @param accepted Output feature bits supported by both
+     *
+     * @return Result code
+     */
+    Result negotiate(u64 wanted, u64 *accepted);
+
+    /**
+     * Route interrupts of the device to this core as MSI-X.
+     *
+     * Must be called before setupQueue().
+     *
+     * @param irq Output interrupt number to watch for
+     *
+     * @return Result code
+     */
+    Result enableInterrupts(uint *irq);
+
+    /**
+     * Allocate a virtqueue and pass it to the device.
+     *
+     * @param queue Queue to set up
+     * @param indirect True if indirect descriptors are negotiated.
+     * @param eventIndex True if event index notification suppression is negotiated.
+     *
+     * @return Result code
+     */
+    Result setupQueue(VirtQueue *queue, bool indirect, bool eventIndex);
+
+    /**
+     * Mark the driver ready, after which the device processes requests.
+     */
+    void setReady();
+
+    /**
+     * Notify the device of new requests in a queue.
+     *
+     * @param queue Queue with new requests
+     */
+    void notify(const VirtQueue *queue);
+
+    /**
+     * Read 32-bit device specific configuration.
+     *
+     * @param offset Offset in the device configuration
+     *
+     * @return Configuration value
+     */
+    u32 readConfig(Size offset);
+
+    /**
+     * Read 8-bit device specific configuration.
+     *
+     * @param offset Offset in the device configuration
+     *
+     * @return Configuration value
+     */
+    u8 readConfigByte(Size offset);
+
+  private:
+
+    /**
+     * Locate and map the modern register structures.
+     *
+     * @return Result code
+     */
+    Result mapModern();
+
+    /**
+     * Map the region described by a vendor capability.
+     *
+     * @param cap Offset of the capability in configuration space
+     * @param io Output I/O object with its base set to the region
+     *
+     * @return Result code
+     */
+    Result mapCapability(u8 cap, IntelIO *io);
+
+    /**
+     * Read device status.
+     *
+     * @return Status flags
+     */
+    u8 getStatus();
+
+    /**
+     * Write device status.
+     *
+     * @param status Status flags
+     */
+    void setStatus(u8 status);
+
+    /** Read 8-bit memory mapped register */
+    u8 readByte(const IntelIO & io, Size offset) const;
+
+    /** Read 16-bit memory mapped register */
+    u16 readWord(const IntelIO & io, Size offset) const;
+
+    /** Write 8-bit memory mapped register */
+    void writeByte(IntelIO & io, Size offset, u8 value);
+
+    /** Write 16-bit memory mapped register */
+    void writeWord(IntelIO & io, Size offset, u16 value);
+
+  private:
+
+    /** PCI configuration space */
+    PCIClient m_pci;
+
+    /** PCI function of the device */
+    IntelPCI::Function m_function;
+
+    /** True if the modern transport is used */
+    bool m_modern;
+
+    /** True if interrupts are delivered as MSI-X */
+    bool m_msix;
+
+    /** Legacy registers in I/O space */
+    IntelIO m_legacy;
+
+    /** Modern common configuration */
+    IntelIO m_common;
+
+    /** Modern queue notification area */
+    IntelIO m_notify;
+
+    /** Modern device specific configuration */
+    IntelIO m_device;
+
+    /** Multiplier for the queue notification offset */
+    u32 m_notifyMultiplier;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBVIRTIO_VIRTIOPCI_H */
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <intel/IntelAPIC.h>
+#include <MemoryBlock.h>
+#include <Log.h>
+#include "AHCIController.h"
+
+/** PCI class code of mass storage controllers */
+#define AHCI_PCI_CLASS    0x01
+
+/** PCI sub class code of SATA controllers */
+#define AHCI_PCI_SUBCLASS 0x06
+
+/** PCI programming interface of AHCI */
+#define AHCI_PCI_PROGIF   0x01
+
+AHCIController::AHCIController()
+{
+    m_capabilities = 0;
+    m_irq = 0;
+    MemoryBlock::set(&m_function, 0, sizeof(m_function));
+}
+
+AHCIController::Result AHCIController::initialize()
+{
+    SystemInformation info;
+    IntelPCI::BAR bar;
+
+    if (m_pci.findClass(AHCI_PCI_CLASS, AHCI_PCI_SUBCLASS, AHCI_PCI_PROGIF, &m_function) != IntelPCI::Success)
+        return NotFound;
+
+    if (m_pci.readBAR(m_function, RegistersBAR, &bar) != IntelPCI::Success || bar.io)
+    {
+        ERROR("AHCI registers not found");
+        return IOError;
+    }
+
+    if (m_io.map(bar.address & PAGEMASK, (bar.size + PAGESIZE - 1) & PAGEMASK,
+                 Memory::User | Memory::Readable | Memory::Writable | Memory::Device) != IO::Success)
+    {
+        ERROR("failed to map AHCI registers");
+        return IOError;
+    }
+    m_io.setBase(m_io.getBase() + (bar.address & ~PAGEMASK));
+
+    m_pci.enable(m_function, IntelPCI::MemorySpace | IntelPCI::BusMaster);
+
+    // PCI interrupt lines are level triggered and cannot be masked by the kernel
+    if (m_pci.getMSIInterrupt(m_function, &m_irq) != IntelPCI::Success ||
+        m_pci.enableMSI(m_function, info.coreId, IntelAPIC::InterruptBase + m_irq) != IntelPCI::Success)
+    {
+        ERROR("MSI is not supported by the AHCI controller");
+        return IOError;
+    }
+
+    m_io.set(GlobalControl, AHCIEnable);
+    m_capabilities = m_io.read(Capabilities);
+
+    // Discard interrupts raised before the ports are configured
+    m_io.write(InterruptStatus, m_io.read(InterruptStatus));
+    m_io.set(GlobalControl, InterruptEnable);
+
+    NOTICE("AHCI " << (m_io.read(Version) >> 16) << "." << ((m_io.read(Version) >> 8) & 0xff) <<
+           " controller with " << getCommandSlots() << " command slots" <<
+           (hasCommandQueuing() ? " and NCQ" : ""));
+    return Success;
+}
+
+uint AHCIController::getInterrupt() const
+{
+    return m_irq;
+}
+
+Size AHCIController::getCommandSlots() const
+{
+    return ((m_capabilities >> 8) & 0x1f) + 1;
+}
+
+bool AHCIController::hasCommandQueuing() const
+{
+    return m_capabilities & NativeCommandQueuing;
+}
+
+bool AHCIController::isAttached(Size port)
+{
+    const Address base = PortBase + (port * PortSize);
+
+    if (port >= MaximumPorts || !(m_io.read(PortsImplemented) & (1u << port)))
+        return false;
+
+    return (m_io.read(base + PortSATAStatus) & 0xf) == LinkEstablished &&
+            m_io.read(base + PortSignature) == DiskSignature;
+}
+
+void AHCIController::clearInterrupt(Size port)
+{
+    m_io.write(InterruptStatus, 1u << port);
+}
+
+IntelIO & AHCIController::getIO()
+{
+    return m_io;
+}
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SERVER_AHCI_AHCICONTROLLER_H
+#define __SERVER_AHCI_AHCICONTROLLER_H
+
+#include <Types.h>
+#include <intel/IntelIO.h>
+#include <PCIClient.h>
+
+/**
+ * @addtogroup server
+ * @{
+ *
+ * @addtogroup ahci
+ * @{
+ */
+
+/**
+ * AHCI host bus adapter.
+ *
+ * Maps the global registers, switches the adapter to AHCI mode
+ * and routes its interrupt to this core as MSI. Each port with
+ * a disk attached is driven by an AHCIPort.
+ */
+class AHCIController
+{
+  public:
+
+    /** Maximum number of ports */
+    static const Size MaximumPorts = 32;
+
+    /**
+     * Result codes
+     */
+    enum Result
+    {
+        Success,
+        NotFound,
+        IOError
+    };
+
+    /**
+     * Global registers.
+     */
+    enum Registers
+    {
+        Capabilities     = 0x00,
+        GlobalControl    = 0x04,
+        InterruptStatus  = 0x08,
+        PortsImplemented = 0x0c,
+        Version          = 0x10,
+        PortBase         = 0x100,
+        PortSize         = 0x80
+    };
+
+    /**
+     * Capabilities register flags.
+     */
+    enum CapabilityFlags
+    {
+        NativeCommandQueuing = (1 << 30),
+        Addressing64Bit      = (1u << 31)
+    };
+
+    /**
+     * Global control register flags.
+     */
+    enum GlobalControlFlags
+    {
+        InterruptEnable = (1 << 1),
+        AHCIEnable      = (1u << 31)
+    };
+
+  private:
+
+    /** Base address register with the AHCI registers */
+    static const Size RegistersBAR = 5;
+
+    /**
+     * Port registers used to detect disks.
+     */
+    enum PortRegisters
+    {
+        PortSignature  = 0x24,
+        PortSATAStatus = 0x28
+    };
+
+    /** Device detection value of an established link in the SATA status */
+    static const u32 LinkEstablished = 3;
+
+    /** Signature of a SATA disk */
+    static const u32 DiskSignature = 0x00000101;
+
+  public:
+
+    /**
+     * Constructor
+     */
+    AHCIController();
+
+    /**
+     * Find and configure the adapter.
+     *
+     * @return Result code
+     */
+    Result initialize();
+
+    /**
+     * Get interrupt number.
+     *
+     * @return Interrupt number of the adapter
+     */
+    uint getInterrupt() const;
+
+    /**
+     * Get number of command slots per port.
+     *
+     * @return Number of command slots
+     */
+    Size getCommandSlots() const;
+
+    /**
+     * Check for native command queuing support.
+     *
+     * @return True if NCQ is supported by the adapter.
+     */
+    bool hasCommandQueuing() const;
+
+    /**
+     * Check if a port is implemented and has a disk attached.
+     *
+     * @param port Port number
+     *
+     * @return True if a SATA disk is attached.
+     */
+    bool isAttached(Size port);
+
+    /**
+     * Acknowledge the interrupt of a port.
+     *
+     * @param port Port number
+     */
+    void clearInterrupt(Size port);
+
+    /**
+     * Get memory mapped registers.
+     *
+     * @return I/O object with its base set to the registers.
+     */
+    IntelIO & getIO();
+
+  private:
+
+    /** PCI configuration space */
+    PCIClient m_pci;
+
+    /** PCI function of the adapter */
+    IntelPCI::Function m_function;
+
+    /** Memory mapped registers */
+    IntelIO m_io;
+
+    /** Capabilities register */
+    u32 m_capabilities;
+
+    /** Interrupt number */
+    uint m_irq;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __SERVER_AHCI_AHCICONTROLLER_H */
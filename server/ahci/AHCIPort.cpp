@@ -0,0 +1,362 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <MemoryBlock.h>
+#include <Macros.h>
+#include <Log.h>
+#include <errno.h>
+#include "AHCIPort.h"
+
+/** Offset of the received FIS area in the port memory */
+#define AHCI_FIS_OFFSET   1024
+
+/** Offset of the command tables in the port memory */
+#define AHCI_TABLE_OFFSET PAGESIZE
+
+AHCIPort::AHCIPort(AHCIController *controller, Size port)
+    : Device(BlockDeviceFile)
+    , m_controller(controller)
+    , m_port(port)
+    , m_registers(AHCIController::PortBase + (port * AHCIController::PortSize))
+{
+    m_identifier << "sata" << (uint) port;
+    m_commandList   = ZERO;
+    m_commandTables = ZERO;
+    m_slots         = 0;
+    m_active        = 0;
+    m_queuing       = false;
+    m_capacity      = 0;
+    MemoryBlock::set(&m_memory, 0, sizeof(m_memory));
+    MemoryBlock::set(m_requests, 0, sizeof(m_requests));
+}
+
+Error AHCIPort::initialize()
+{
+    // Command list, received FIS area and all command tables
+    m_memory.virt   = ZERO;
+    m_memory.phys   = ZERO;
+    m_memory.size   = AHCI_TABLE_OFFSET + (sizeof(CommandTable) * CommandSlots);
+    m_memory.access = Memory::User | Memory::Readable | Memory::Writable;
+
+    if (VMCtl(SELF, Map, &m_memory) != API::Success)
+    {
+        ERROR("failed to allocate command list for port " << m_port);
+        return ENOMEM;
+    }
+    MemoryBlock::set((void *) m_memory.virt, 0, m_memory.size);
+
+    m_commandList   = (volatile CommandHeader *) m_memory.virt;
+    m_commandTables = (volatile CommandTable *) (m_memory.virt + AHCI_TABLE_OFFSET);
+
+    for (Size i = 0; i < CommandSlots; i++)
+    {
+        const Address table = m_memory.phys + AHCI_TABLE_OFFSET + (sizeof(CommandTable) * i);
+
+        m_commandList[i].tableBase      = table;
+        m_commandList[i].tableBaseUpper = 0;
+
+        m_requests[i].data.virt   = ZERO;
+        m_requests[i].data.phys   = ZERO;
+        m_requests[i].data.size   = MaximumTransfer;
+        m_requests[i].data.access = Memory::User | Memory::Readable | Memory::Writable;
+
+        if (VMCtl(SELF, Map, &m_requests[i].data) != API::Success)
+        {
+            ERROR("failed to allocate request buffers for port " << m_port);
+            return ENOMEM;
+        }
+    }
+
+    // The port must be idle before its memory is changed
+    stop();
+    writePort(CommandListBase, m_memory.phys);
+    writePort(CommandListBaseUpper, 0);
+    writePort(FISBase, m_memory.phys + AHCI_FIS_OFFSET);
+    writePort(FISBaseUpper, 0);
+    start();
+
+    const Error result = identify();
+    if (result != ESUCCESS)
+        return result;
+
+    writePort(InterruptStatus, readPort(InterruptStatus));
+    writePort(InterruptEnable, DeviceToHostFIS | SetDeviceBitsFIS | TaskFileError);
+
+    NOTICE("SATA disk on port " << m_port << " with " << (uint) (m_capacity / 2048) << " MiB" <<
+           (m_queuing ? " and NCQ" : ""));
+    return ESUCCESS;
+}
+
+Error AHCIPort::read(IOBuffer & buffer, Size size, Size offset)
+{
+    return transfer(buffer, size, offset, false);
+}
+
+Error AHCIPort::write(IOBuffer & buffer, Size size, Size offset)
+{
+    return transfer(buffer, size, offset, true);
+}
+
+Error AHCIPort::interrupt(Size vector)
+{
+    const u32 status = readPort(InterruptStatus);
+    writePort(InterruptStatus, status);
+
+    if (status & TaskFileError)
+    {
+        // The disk aborts all queued commands on an error
+        ERROR("port " << m_port << " task file error: " << readPort(TaskFileData));
+
+        for (Size i = 0; i < m_slots; i++)
+        {
+            if (m_active & (1u << i))
+            {
+                m_requests[i].completed = true;
+                m_requests[i].failed    = true;
+            }
+        }
+        m_active = 0;
+
+        stop();
+        writePort(SATAError, readPort(SATAError));
+        writePort(InterruptStatus, readPort(InterruptStatus));
+        start();
+    }
+    else
+    {
+        // Slots no longer outstanding in either register are done
+        const u32 done = m_active & ~(readPort(SATAActive) | readPort(CommandIssue));
+
+        for (Size i = 0; i < m_slots; i++)
+        {
+            if (done & (1u << i))
+                m_requests[i].completed = true;
+        }
+        m_active &= ~done;
+    }
+
+    m_controller->clearInterrupt(m_port);
+    return ESUCCESS;
+}
+
+Error AHCIPort::transfer(IOBuffer & buffer, Size size, Size offset, bool write)
+{
+    const int slot = findRequest(buffer.getMessage());
+
+    if (slot < 0)
+    {
+        const u64 end = m_capacity * SectorSize;
+
+        if (write && ((offset % SectorSize) || (size % SectorSize)))
+            return EINVAL;
+
+        if (offset >= end)
+            return write ? EIO : 0;
+
+        if (offset + size > end)
+            size = end - offset;
+
+        return submit(buffer, size, offset, write);
+    }
+
+    Request *req = &m_requests[slot];
+
+    if (!req->completed)
+        return EAGAIN;
+
+    // Release the slot before returning the result
+    const Error result = req->failed ? EIO : (Error) req->size;
+
+    if (result != EIO && !write)
+        buffer.bufferedWrite((u8 *) req->data.virt + req->skip, req->size);
+
+    req->message = ZERO;
+    return result;
+}
+
+Error AHCIPort::submit(IOBuffer & buffer, Size size, Size offset, bool write)
+{
+    // Without NCQ the disk only accepts a single command
+    if (!m_queuing && m_active)
+        return EAGAIN;
+
+    // Retried when a completion frees a slot
+    const int slot = findRequest(ZERO);
+    if (slot < 0)
+        return EAGAIN;
+
+    Request *req = &m_requests[slot];
+    req->skip = offset % SectorSize;
+
+    // Larger transfers return a partial count to the client
+    Size length = CEIL(req->skip + size, SectorSize) * SectorSize;
+    if (length > MaximumTransfer)
+    {
+        length = MaximumTransfer;
+        size   = MaximumTransfer - req->skip;
+    }
+    req->size      = size;
+    req->message   = buffer.getMessage();
+    req->completed = false;
+    req->failed    = false;
+
+    if (write)
+        MemoryBlock::copy((void *) req->data.virt, buffer.getBuffer(), size);
+
+    if (m_queuing)
+        issue(slot, write ? WriteFPDMAQueued : ReadFPDMAQueued,
+              offset / SectorSize, length / SectorSize, length, write);
+    else
+        issue(slot, write ? WriteDMAExt : ReadDMAExt,
+              offset / SectorSize, length / SectorSize, length, write);
+
+    return EAGAIN;
+}
+
+void AHCIPort::issue(Size slot, u8 command, u64 sector, Size sectors, Size length, bool write)
+{
+    volatile CommandTable *table = &m_commandTables[slot];
+    volatile u8 *fis = table->fis;
+    const bool queued = command == ReadFPDMAQueued || command == WriteFPDMAQueued;
+
+    for (Size i = 0; i < sizeof(table->fis); i++)
+        fis[i] = 0;
+
+    // Register host to device FIS, with the command bit set
+    fis[0]  = 0x27;
+    fis[1]  = 0x80;
+    fis[2]  = command;
+    fis[4]  = sector & 0xff;
+    fis[5]  = (sector >> 8) & 0xff;
+    fis[6]  = (sector >> 16) & 0xff;
+    fis[7]  = 0x40;
+    fis[8]  = (sector >> 24) & 0xff;
+    fis[9]  = (sector >> 32) & 0xff;
+    fis[10] = (sector >> 40) & 0xff;
+
+    // Queued commands carry the count in the features and the tag in the count
+    if (queued)
+    {
+        fis[3]  = sectors & 0xff;
+        fis[11] = (sectors >> 8) & 0xff;
+        fis[12] = slot << 3;
+    }
+    else if (command != IdentifyDevice)
+    {
+        fis[12] = sectors & 0xff;
+        fis[13] = (sectors >> 8) & 0xff;
+    }
+    else
+        fis[7] = 0;
+
+    // The data buffer is physically contiguous and needs a single entry
+    table->prd[0].base      = m_requests[slot].data.phys;
+    table->prd[0].baseUpper = 0;
+    table->prd[0].reserved  = 0;
+    table->prd[0].byteCount = length - 1;
+
+    m_commandList[slot].flags        = (5 | (write ? HeaderWrite : 0));
+    m_commandList[slot].prdtLength   = 1;
+    m_commandList[slot].prdByteCount = 0;
+
+    m_active |= (1u << slot);
+
+    if (queued)
+        writePort(SATAActive, 1u << slot);
+
+    writePort(CommandIssue, 1u << slot);
+}
+
+Error AHCIPort::identify()
+{
+    const u16 *id = (const u16 *) m_requests[0].data.virt;
+    Size i;
+
+    // Wait for the disk to finish its reset
+    for (i = 0; i < PollLimit && (readPort(TaskFileData) & (StatusBusy | StatusDataRequest)); i++)
+        ;
+
+    issue(0, IdentifyDevice, 0, 1, SectorSize, false);
+
+    for (i = 0; i < PollLimit && (readPort(CommandIssue) & 1); i++)
+        if (readPort(InterruptStatus) & TaskFileError)
+            break;
+
+    m_active = 0;
+
+    if (i == PollLimit || (readPort(TaskFileData) & StatusError) ||
+        (readPort(InterruptStatus) & TaskFileError))
+    {
+        ERROR("failed to identify disk on port " << m_port);
+        return EIO;
+    }
+
+    // Use 48-bit addressing when supported
+    if (id[83] & (1 << 10))
+        m_capacity = id[100] | ((u64) id[101] << 16) | ((u64) id[102] << 32) | ((u64) id[103] << 48);
+    else
+        m_capacity = id[60] | ((u64) id[61] << 16);
+
+    m_queuing = m_controller->hasCommandQueuing() && (id[76] & (1 << 8));
+    m_slots   = m_controller->getCommandSlots();
+
+    if (m_queuing && m_slots > (Size) (id[75] & 0x1f) + 1)
+        m_slots = (id[75] & 0x1f) + 1;
+
+    if (m_slots > CommandSlots)
+        m_slots = CommandSlots;
+
+    return ESUCCESS;
+}
+
+void AHCIPort::stop()
+{
+    writePort(Command, readPort(Command) & ~(Start | FISReceiveEnable));
+
+    for (Size i = 0; i < PollLimit && (readPort(Command) & (CommandListRunning | FISReceiveRunning)); i++)
+        ;
+}
+
+void AHCIPort::start()
+{
+    for (Size i = 0; i < PollLimit && (readPort(Command) & CommandListRunning); i++)
+        ;
+
+    writePort(Command, readPort(Command) | FISReceiveEnable);
+    writePort(SATAError, readPort(SATAError));
+    writePort(Command, readPort(Command) | Start);
+}
+
+int AHCIPort::findRequest(const FileSystemMessage *message) const
+{
+    for (Size i = 0; i < m_slots; i++)
+        if (m_requests[i].message == message)
+            return i;
+
+    return -1;
+}
+
+u32 AHCIPort::readPort(Size reg)
+{
+    return m_controller->getIO().read(m_registers + reg);
+}
+
+void AHCIPort::writePort(Size reg, u32 value)
+{
+    m_controller->getIO().write(m_registers + reg, value);
+}
@@ -0,0 +1,355 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SERVER_AHCI_AHCIPORT_H
+#define __SERVER_AHCI_AHCIPORT_H
+
+#include <Types.h>
+#include <Memory.h>
+#include <Device.h>
+#include <IOBuffer.h>
+#include "AHCIController.h"
+
+/**
+ * @addtogroup server
+ * @{
+ *
+ * @addtogroup ahci
+ * @{
+ */
+
+/**
+ * SATA disk on an AHCI port.
+ *
+ * Every command slot of the port carries one request. Reads and writes
+ * are issued and answered with EAGAIN, such that with native command
+ * queuing up to 32 requests are outstanding on the disk. The interrupt
+ * marks completed slots, after which the retried read or write returns
+ * the result. Without NCQ only a single command is issued at a time.
+ */
+class AHCIPort : public Device
+{
+  private:
+
+    /** Size of a sector in bytes */
+    static const Size SectorSize = 512;
+
+    /** Maximum number of command slots */
+    static const Size CommandSlots = 32;
+
+    /** Maximum number of bytes transferred by a single command */
+    static const Size MaximumTransfer = 32768;
+
+    /** Number of scatter-gather entries in each command table */
+    static const Size PRDEntries = 8;
+
+    /** Maximum number of polls for a command during initialization */
+    static const Size PollLimit = 1000000;
+
+    /**
+     * Port registers.
+     */
+    enum Registers
+    {
+        CommandListBase      = 0x00,
+        CommandListBaseUpper = 0x04,
+        FISBase              = 0x08,
+        FISBaseUpper         = 0x0c,
+        InterruptStatus      = 0x10,
+        InterruptEnable      = 0x14,
+        Command              = 0x18,
+        TaskFileData         = 0x20,
+        SATAError            = 0x30,
+        SATAActive           = 0x34,
+        CommandIssue         = 0x38
+    };
+
+    /**
+     * Command register flags.
+     */
+    enum CommandFlags
+    {
+        Start              = (1 << 0),
+        FISReceiveEnable   = (1 << 4),
+        FISReceiveRunning  = (1 << 14),
+        CommandListRunning = (1 << 15)
+    };
+
+    /**
+     * Interrupt status and enable flags.
+     */
+    enum InterruptFlags
+    {
+        DeviceToHostFIS  = (1 << 0),
+        PIOSetupFIS      = (1 << 1),
+        SetDeviceBitsFIS = (1 << 3),
+        TaskFileError    = (1 << 30)
+    };
+
+    /**
+     * Task file data flags.
+     */
+    enum TaskFileFlags
+    {
+        StatusError       = (1 << 0),
+        StatusDataRequest = (1 << 3),
+        StatusBusy        = (1 << 7)
+    };
+
+    /**
+     * ATA commands.
+     */
+    enum ATACommand
+    {
+        ReadDMAExt       = 0x25,
+        WriteDMAExt      = 0x35,
+        ReadFPDMAQueued  = 0x60,
+        WriteFPDMAQueued = 0x61,
+        IdentifyDevice   = 0xec
+    };
+
+    /**
+     * Command header flags.
+     */
+    enum CommandHeaderFlags
+    {
+        HeaderWrite = (1 << 6)
+    };
+
+    /**
+     * Entry in the command list.
+     */
+    typedef struct CommandHeader
+    {
+        u16 flags;
+        u16 prdtLength;
+        u32 prdByteCount;
+        u32 tableBase;
+        u32 tableBaseUpper;
+        u32 reserved[4];
+    }
+    CommandHeader;
+
+    /**
+     * Physical region descriptor, one scatter-gather entry.
+     */
+    typedef struct PRD
+    {
+        u32 base;
+        u32 baseUpper;
+        u32 reserved;
+        u32 byteCount;
+    }
+    PRD;
+
+    /**
+     * Command table, pointed to by a command header.
+     */
+    typedef struct CommandTable
+    {
+        u8 fis[64];
+        u8 atapi[16];
+        u8 reserved[48];
+        PRD prd[PRDEntries];
+    }
+    CommandTable;
+
+    /**
+     * Request in a command slot.
+     */
+    typedef struct Request
+    {
+        /** Message of the client, or ZERO if the slot is free */
+        const FileSystemMessage *message;
+
+        /** True if the disk completed the command */
+        bool completed;
+
+        /** True if the command failed */
+        bool failed;
+
+        /** Bytes to skip in the first sector */
+        Size skip;
+
+        /** Bytes to return to the client */
+        Size size;
+
+        /** Physically contiguous data buffer */
+        Memory::Range data;
+    }
+    Request;
+
+  public:
+
+    /**
+     * Constructor
+     *
+     * @param controller AHCI controller of the port
+     * @param port Port number
+     */
+    AHCIPort(AHCIController *controller, Size port);
+
+    /**
+     * Start the port and identify the disk.
+     *
+     * @return Error result code.
+     */
+    virtual Error initialize();
+
+    /**
+     * Read bytes from the disk.
+     *
+     * @param buffer Buffer to store bytes to read.
+     * @param size Number of bytes to read.
+     * @param offset Offset in the disk.
+     *
+     * @return Number of bytes on success and an error code on failure.
+     */
+    virtual Error read(IOBuffer & buffer, Size size, Size offset);
+
+    /**
+     * Write bytes to the disk.
+     *
+     * @param buffer Buffer with bytes to write.
+     * @param size Number of bytes to write, a multiple of the sector size.
+     * @param offset Offset in the disk, aligned on the sector size.
+     *
+     * @return Number of bytes on success and an error code on failure.
+     */
+    virtual Error write(IOBuffer & buffer, Size size, Size offset);
+
+    /**
+     * Mark completed command slots.
+     *
+     * @param vector Interrupt number.
+     *
+     * @return Error result code.
+     */
+    virtual Error interrupt(Size vector);
+
+  private:
+
+    /**
+     * Issue a new command or collect the result of a completed one.
+     *
+     * @param buffer Buffer of the client
+     * @param size Number of bytes
+     * @param offset Offset in the disk
+     * @param write True to write, false to read.
+     *
+     * @return Number of bytes on success, EAGAIN while outstanding, or an error code on failure.
+     */
+    Error transfer(IOBuffer & buffer, Size size, Size offset, bool write);
+
+    /**
+     * Issue a new read or write command.
+     *
+     * @param buffer Buffer of the client
+     * @param size Number of bytes
+     * @param offset Offset in the disk
+     * @param write True to write, false to read.
+     *
+     * @return EAGAIN, also when no slot is free and the request must be retried.
+     */
+    Error submit(IOBuffer & buffer, Size size, Size offset, bool write);
+
+    /**
+     * Fill a command slot and hand it to the disk.
+     *
+     * @param slot Command slot
+     * @param command ATA command
+     * @param sector First sector
+     * @param sectors Number of sectors
+     * @param length Number of bytes to transfer
+     * @param write True if data is written to the disk.
+     */
+    void issue(Size slot, u8 command, u64 sector, Size sectors, Size length, bool write);
+
+    /**
+     * Identify the attached disk.
+     *
+     * @return Error result code.
+     */
+    Error identify();
+
+    /**
+     * Stop processing the command list.
+     */
+    void stop();
+
+    /**
+     * Start processing the command list.
+     */
+    void start();
+
+    /**
+     * Find the command slot of a client message.
+     *
+     * @param message Message of the client
+     *
+     * @return Command slot or -1 if not issued yet.
+     */
+    int findRequest(const FileSystemMessage *message) const;
+
+    /** Read a port register */
+    u32 readPort(Size reg);
+
+    /** Write a port register */
+    void writePort(Size reg, u32 value);
+
+  private:
+
+    /** AHCI controller of the port */
+    AHCIController *m_controller;
+
+    /** Port number */
+    const Size m_port;
+
+    /** Offset of the port registers */
+    const Address m_registers;
+
+    /** Physically contiguous command list, received FIS area and command tables */
+    Memory::Range m_memory;
+
+    /** Command list */
+    volatile CommandHeader *m_commandList;
+
+    /** Command tables, one per slot */
+    volatile CommandTable *m_commandTables;
+
+    /** Requests, one per slot */
+    Request m_requests[CommandSlots];
+
+    /** Number of usable command slots */
+    Size m_slots;
+
+    /** Slots issued to the disk and not yet completed */
+    u32 m_active;
+
+    /** True if native command queuing is used */
+    bool m_queuing;
+
+    /** Number of sectors */
+    u64 m_capacity;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __SERVER_AHCI_AHCIPORT_H */
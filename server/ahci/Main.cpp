@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <DeviceServer.h>
+#include <KernelLog.h>
+#include <stdlib.h>
+#include <Runtime.h>
+#include "AHCIController.h"
+#include "AHCIPort.h"
+
+int main(int argc, char **argv)
+{
+    DeviceServer server("/dev/ahci");
+    AHCIController *controller = new AHCIController;
+
+    // Open the logging facilities
+    Log *log = new KernelLog();
+    log->setMinimumLogLevel(Log::Notice);
+
+    // Configuration space is accessed through the PCI server
+    waitMount("/dev/pci");
+
+    // Only mount when there is a controller to serve
+    if (controller->initialize() != AHCIController::Success)
+    {
+        NOTICE("no AHCI controller found");
+        return EXIT_FAILURE;
+    }
+    server.initialize();
+
+    // Serve every attached disk, all ports share the interrupt of the controller
+    for (Size i = 0; i < AHCIController::MaximumPorts; i++)
+    {
+        if (controller->isAttached(i))
+        {
+            AHCIPort *dev = new AHCIPort(controller, i);
+            server.registerDevice(dev, *dev->getIdentifier());
+            server.registerInterrupt(dev, controller->getInterrupt());
+        }
+    }
+
+    // Start serving requests
+    return server.run();
+}
@@ -40,6 +40,9 @@ CoreServer::CoreServer()
     m_fromMaster = ZERO;
     m_toSlave = ZERO;
     m_fromSlave = ZERO;
+    m_toKernel = ZERO;
+    m_fromKernel = ZERO;
+    m_ipiInterrupt = 0;
 
     // Register IPC handlers
     addIPCHandler(ReadFile,  &CoreServer::getCoreCount);
@@ -212,6 +215,9 @@ CoreServer::Result CoreServer::initialize()
         return r;
     }
 
+    // Serve page broker requests from other cores
+    addIRQHandler(m_ipiInterrupt, &CoreServer::interruptHandler);
+
     return bootAll();
 }
 
@@ -276,19 +282,8 @@ CoreServer::Result CoreServer::prepareCore(uint coreId, CoreInfo *info,
     API::Result r;
     SystemInformation sysInfo;
 
-    DEBUG("Reserving: " << (void *)info->memory.phys << " size=" <<
-            info->memory.size << " available=" << sysInfo.memoryAvail);
-
-    // Claim the core's memory
-    if ((r = VMCtl(SELF, ReserveMem, &info->memory)) != API::Success)
-    {
-        ERROR("VMCtl(ReserveMem) failed for core" << coreId <<
-              " at " << (void *)info->memory.phys << ": result " << (int) r);
-        return OutOfMemory;
-    }
-
     DEBUG("Starting core" << coreId << " with "
-          << info->memory.size / 1024 / 1024 << "MB");
+          << info->memoryOwned / 1024 / 1024 << "MB");
 
     // Map the kernel
     for (Size i = 0; i < m_numRegions; i++)
@@ -374,7 +369,10 @@ CoreServer::Result CoreServer::prepareCore(uint coreId, CoreInfo *info,
 CoreServer::Result CoreServer::prepareCoreInfo()
 {
     SystemInformation sysInfo;
-    Size memPerCore = 0;
+    Arch::MemoryMap map;
+    const Address memoryEnd = RAM_ADDR + sysInfo.memorySize;
+    const Size windowSize = map.range(MemoryMap::KernelData).size;
+    Address base = RAM_ADDR;
 
     List<uint> & cores = m_cores->getCores();
     if (cores.count() == 0)
@@ -383,12 +381,8 @@ CoreServer::Result CoreServer::prepareCoreInfo()
         return NotFound;
     }
 
-    memPerCore = sysInfo.memorySize / cores.count();
-    memPerCore /= MegaByte(4);
-    memPerCore *= MegaByte(4);
-
     NOTICE("found " << cores.count() << " cores: " <<
-            (memPerCore / 1024 / 1024) << "MB per core");
+            (InitialMemory / 1024 / 1024) << "MB initial memory per core");
 
     // Allocate CoreInfo for each core
     m_coreInfo = new Index<CoreInfo>(cores.count());
@@ -404,16 +398,48 @@ CoreServer::Result CoreServer::prepareCoreInfo()
             m_coreInfo->insert(coreId, *info);
             MemoryBlock::set(info, 0, sizeof(CoreInfo));
 
+            // Kernel, BootImage, channels and initial free memory
+            Size owned = MegaByte(4) + sysInfo.bootImageSize + (PAGESIZE * 9) + InitialMemory;
+            if (owned % MegaByte(4))
+                owned += MegaByte(4) - (owned % MegaByte(4));
+
+            // Claim the lowest free area. The kernel maps its memory
+            // in 4MB pages, starting at the base address.
+            Memory::Range range;
+            range.virt = 0;
+            range.size = owned;
+            range.access = Memory::Readable | Memory::Writable;
+
+            for (range.phys = base; range.phys + owned <= memoryEnd; range.phys += MegaByte(4))
+            {
+                if (VMCtl(SELF, ReserveMem, &range) == API::Success)
+                    break;
+            }
+
+            if (range.phys + owned > memoryEnd)
+            {
+                ERROR("no memory available for core" << coreId);
+                return OutOfMemory;
+            }
+            base = range.phys + owned;
+
+            // The kernel can address memory from its base address up to the
+            // end of its window. Any memory beyond the owned part is granted
+            // on demand by the page broker.
             info->coreId = coreId;
-            info->memory.phys = RAM_ADDR + (memPerCore * coreId);
-            info->memory.size = memPerCore - PAGESIZE;
+            info->memory.phys = range.phys;
+            info->memory.size = memoryEnd - range.phys;
+            if (info->memory.size > windowSize)
+                info->memory.size = windowSize;
+            info->memoryOwned = owned;
+            info->brokerInterrupt = m_ipiInterrupt;
             info->kernel.phys = info->memory.phys;
             info->kernel.size = MegaByte(4);
             info->bootImageAddress = info->kernel.phys + info->kernel.size;
             info->bootImageSize    = sysInfo.bootImageSize;
             info->coreChannelAddress = info->bootImageAddress + info->bootImageSize;
             info->coreChannelAddress += PAGESIZE - (info->bootImageSize % PAGESIZE);
-            info->coreChannelSize    = PAGESIZE * 4;
+            info->coreChannelSize    = PAGESIZE * 8;
             clearPages(info->coreChannelAddress, info->coreChannelSize);
 
             m_kernel->entry(&info->kernelEntry);
@@ -479,6 +505,8 @@ CoreServer::Result CoreServer::setupChannels()
 
         m_toSlave    = new Index<MemoryChannel>(numCores);
         m_fromSlave  = new Index<MemoryChannel>(numCores);
+        m_toKernel   = new Index<MemoryChannel>(numCores);
+        m_fromKernel = new Index<MemoryChannel>(numCores);
 
         for (Size i = 1; i < numCores; i++)
         {
@@ -496,6 +524,21 @@ CoreServer::Result CoreServer::setupChannels()
             ch->setPhysical(coreInfo->coreChannelAddress,
                             coreInfo->coreChannelAddress + PAGESIZE);
             m_fromSlave->insert(i, *ch);
+
+            // Page broker channels with the kernel of the core
+            ch = new MemoryChannel();
+            ch->setMode(Channel::Consumer);
+            ch->setMessageSize(sizeof(CoreMemoryMessage));
+            ch->setPhysical(coreInfo->coreChannelAddress + (PAGESIZE * 4),
+                            coreInfo->coreChannelAddress + (PAGESIZE * 5));
+            m_fromKernel->insert(i, *ch);
+
+            ch = new MemoryChannel();
+            ch->setMode(Channel::Producer);
+            ch->setMessageSize(sizeof(CoreMemoryMessage));
+            ch->setPhysical(coreInfo->coreChannelAddress + (PAGESIZE * 6),
+                            coreInfo->coreChannelAddress + (PAGESIZE * 7));
+            m_toKernel->insert(i, *ch);
         }
     }
     else
@@ -516,6 +559,94 @@ CoreServer::Result CoreServer::setupChannels()
     return Success;
 }
 
+void CoreServer::interruptHandler(Size irq)
+{
+    CoreMemoryMessage msg;
+
+    if (!m_fromKernel)
+        return;
+
+    for (Size i = 1; i < m_fromKernel->size(); i++)
+    {
+        MemoryChannel *ch = (MemoryChannel *) m_fromKernel->get(i);
+
+        while (ch && ch->read(&msg) == Channel::Success)
+            transferMemory(i, &msg);
+    }
+}
+
+CoreServer::Result CoreServer::transferMemory(uint coreId, CoreMemoryMessage *msg)
+{
+    CoreInfo *info = (CoreInfo *) m_coreInfo->get(coreId);
+    MemoryChannel *ch = (MemoryChannel *) m_toKernel->get(coreId);
+    const Address end = info->memory.phys + info->memory.size;
+    Result result = Success;
+    Memory::Range range;
+
+    range.virt   = 0;
+    range.phys   = msg->phys;
+    range.size   = msg->size;
+    range.access = Memory::Readable | Memory::Writable;
+
+    // Every message is answered, such that the kernel never waits forever
+    if (!msg->size || msg->size > info->memory.size || msg->size % PAGESIZE)
+    {
+        ERROR("invalid memory size " << msg->size << " from core" << coreId);
+        msg->phys = ZERO;
+        result = MemoryError;
+    }
+    // Take back pages returned by the core
+    else if (msg->phys)
+    {
+        if (range.phys < info->memory.phys || range.phys > end - range.size ||
+            VMCtl(SELF, AddMem, &range) != API::Success)
+        {
+            // The answer hands the pages back to the core
+            ERROR("failed to reclaim memory at " << (void *) msg->phys <<
+                  " from core" << coreId);
+            result = MemoryError;
+        }
+        else
+            return Success;
+    }
+    // Grant the highest free chunk in the memory window of the core,
+    // which is the least likely to conflict with allocations on core0
+    else
+    {
+        range.phys = end - range.size;
+        range.phys -= range.phys % range.size;
+
+        while (range.phys >= info->memory.phys)
+        {
+            if (VMCtl(SELF, ReserveMem, &range) == API::Success)
+            {
+                msg->phys = range.phys;
+                break;
+            }
+
+            if (range.phys < info->memory.phys + range.size)
+                break;
+
+            range.phys -= range.size;
+        }
+
+        DEBUG("core" << coreId << ": granted " << msg->size << " bytes at " << (void *) msg->phys);
+    }
+
+    if (ch->write(msg) != Channel::Success)
+    {
+        // The kernel drops requests which are not answered in time
+        ERROR("failed to write page broker channel for core" << coreId);
+
+        if (msg->phys && result == Success)
+            VMCtl(SELF, AddMem, &range);
+
+        return IOError;
+    }
+
+    return result;
+}
+
 CoreServer::Result CoreServer::receiveFromMaster(FileSystemMessage *msg)
 {
     Channel::Result result = Channel::NotFound;
@@ -529,7 +660,8 @@ CoreServer::Result CoreServer::receiveFromMaster(FileSystemMessage *msg)
         }
 
         // Wait for IPI which will wake us
-        waitIPI();
+        if (result != Channel::Success)
+            waitIPI();
     }
 
     return Success;
@@ -540,6 +672,13 @@ CoreServer::Result CoreServer::sendToMaster(FileSystemMessage *msg)
     while (m_toMaster->write(msg) != Channel::Success)
         ;
 
+    // Send IPI to ensure the master wakes up for the message
+    if (sendIPI(0) != Success)
+    {
+        ERROR("failed to send IPI to core0");
+        return IOError;
+    }
+
     return Success;
 }
 
@@ -549,8 +688,20 @@ CoreServer::Result CoreServer::receiveFromSlave(uint coreId, FileSystemMessage *
     if (!ch)
         return IOError;
 
-    while (ch->read(msg) != Channel::Success)
-        ;
+    Channel::Result result = Channel::NotFound;
+
+    // wait for a message of the slave core
+    while (result != Channel::Success)
+    {
+        for (uint i = 0; i < MaxMessageRetry && result != Channel::Success; i++)
+        {
+            result = ch->read(msg);
+        }
+
+        // Wait for IPI which will wake us
+        if (result != Channel::Success)
+            waitIPI();
+    }
 
     return Success;
 }
@@ -53,6 +53,9 @@ class CoreServer : public ChannelServer<CoreServer, FileSystemMessage>
     /** Number of times to busy wait on receiving a message */
     static const Size MaxMessageRetry = 128;
 
+    /** Free memory owned by a secondary core at boot, on top of its kernel and BootImage */
+    static const Size InitialMemory = MegaByte(16);
+
     /** The default kernel for starting new cores. */
     static const char *kernelPath;
 
@@ -202,6 +205,28 @@ class CoreServer : public ChannelServer<CoreServer, FileSystemMessage>
      */
     void createProcess(FileSystemMessage *msg);
 
+    /**
+     * Called when an Inter-Processor-Interrupt is received.
+     *
+     * Serves requests from the kernels of other cores to the page broker.
+     *
+     * @param irq Interrupt number
+     */
+    void interruptHandler(Size irq);
+
+    /**
+     * Grant or reclaim memory for the kernel of another core.
+     *
+     * Requests are always answered, with a zero address if no memory
+     * is left. Returned pages which cannot be reclaimed are sent back.
+     *
+     * @param coreId Core identifier
+     * @param msg CoreMemoryMessage received from the kernel
+     *
+     * @return Result code
+     */
+    Result transferMemory(uint coreId, CoreMemoryMessage *msg);
+
     /**
      * Receive message from master
      *
@@ -244,6 +269,9 @@ class CoreServer : public ChannelServer<CoreServer, FileSystemMessage>
 
     CoreManager *m_cores;
 
+    /** Interrupt number used for Inter-Processor-Interrupts */
+    uint m_ipiInterrupt;
+
   private:
 
     ExecutableFormat *m_kernel;
@@ -259,6 +287,9 @@ class CoreServer : public ChannelServer<CoreServer, FileSystemMessage>
     Index<MemoryChannel> *m_fromSlave;
     Index<MemoryChannel> *m_toSlave;
 
+    Index<MemoryChannel> *m_fromKernel;
+    Index<MemoryChannel> *m_toKernel;
+
     MemoryChannel *m_toMaster;
     MemoryChannel *m_fromMaster;
 };
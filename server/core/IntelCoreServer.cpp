@@ -30,12 +30,13 @@ IntelCoreServer::IntelCoreServer()
     : CoreServer()
     , m_mp(m_apic)
 {
+    m_ipiInterrupt = IPIInterrupt;
 }
 
 IntelCoreServer::Result IntelCoreServer::initialize()
 {
-    // Register IPI vector. Minus 32 because of IRQ() in IntelKernel
-    API::Result r = ProcessCtl(SELF, WatchIRQ, IPIVector - 32);
+    // Register IPI interrupt
+    API::Result r = ProcessCtl(SELF, WatchIRQ, IPIInterrupt);
 
     if (r != API::Success)
     {
@@ -87,16 +88,18 @@ IntelCoreServer::Result IntelCoreServer::discoverCores()
 void IntelCoreServer::waitIPI() const
 {
     // Wait for IPI which will wake us
-    ProcessCtl(SELF, EnableIRQ, IPIVector);
+    ProcessCtl(SELF, EnableIRQ, IPIInterrupt);
     ProcessCtl(SELF, EnterSleep, 0, 0);
 }
 
 IntelCoreServer::Result IntelCoreServer::sendIPI(uint coreId)
 {
-    // Send IPI to ensure the slave wakes up for the message
-    if (m_apic.sendIPI(coreId, IPIVector) != IntController::Success)
+    // Send IPI to ensure the other core wakes up for the message.
+    // Uses the kernel, because only core0 has the APIC mapped.
+    API::Result r = ProcessCtl(SELF, SendIRQ, (coreId << 16) | IPIInterrupt);
+    if (r != API::Success)
     {
-        ERROR("failed to send IPI to core" << coreId);
+        ERROR("failed to send IPI to core" << coreId << ": " << (uint)r);
         return IOError;
     }
 
@@ -43,8 +43,8 @@ class IntelCoreServer : public CoreServer
 {
   private:
 
-    /** Inter-Processor-Interrupt vector number */
-    static const uint IPIVector = 50;
+    /** Inter-Processor-Interrupt number, relative to the interrupt base */
+    static const uint IPIInterrupt = IntelAPIC::IPIVector - IntelAPIC::InterruptBase;
 
   public:
 
@@ -31,6 +31,7 @@ SunxiCoreServer::SunxiCoreServer()
     , m_cpuConfig()
 {
     m_cores = &m_cpuConfig;
+    m_ipiInterrupt = SoftwareInterruptNumber;
 }
 
 SunxiCoreServer::Result SunxiCoreServer::initialize()
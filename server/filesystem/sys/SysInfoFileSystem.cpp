@@ -20,6 +20,7 @@
 #include "SysInfoFileSystem.h"
 #include "MountsFile.h"
 #include "MountWaitFile.h"
+#include "TraceFile.h"
 
 SysInfoFileSystem::SysInfoFileSystem(const char *path)
     : FileSystem(path)
@@ -27,4 +28,5 @@ SysInfoFileSystem::SysInfoFileSystem(const char *path)
     setRoot(new Directory);
     registerFile(new MountsFile, "mounts");
     registerFile(new MountWaitFile, "mountwait");
+    registerFile(new TraceFile, "trace");
 }
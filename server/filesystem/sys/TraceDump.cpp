@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/TraceEvent.h>
+#include <Types.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+static const char *eventNames[] =
+{
+    "Switch",
+    "SysEnter",
+    "SysExit",
+    "Interrupt",
+    "Resume",
+    "Wakeup",
+    "PageMap"
+};
+
+static const char *apiNames[] =
+{
+    "???",
+    "PrivExec",
+    "ProcessCtl",
+    "SystemInfo",
+    "VMCopy",
+    "VMCtl",
+    "VMShare",
+    "IOCtl",
+    "TraceCtl"
+};
+
+void usage(char *prog)
+{
+    printf("usage: %s FILE [OPTIONS...]\r\n"
+           "Decodes a kernel trace drained from /sys/trace into a timeline\r\n"
+           "\r\n"
+           "-m MHZ      Show time in microseconds using the given timestamp frequency.\r\n"
+           "-h          Show this help message.\r\n",
+            prog);
+}
+
+void printArgument(const TraceEvent *ev)
+{
+    switch (ev->type)
+    {
+        case TraceSwitch:
+        case TraceResume:
+        case TraceWakeup:
+            printf("-> %u", ev->arg);
+            break;
+
+        case TraceSystemCallEnter:
+            if (ev->arg < sizeof(apiNames) / sizeof(apiNames[0]))
+                printf("%s", apiNames[ev->arg]);
+            else
+                printf("API %u", ev->arg);
+            break;
+
+        case TraceSystemCallExit:
+            printf("result %d", (int) ev->arg);
+            break;
+
+        case TraceInterrupt:
+            printf("vector %u", ev->arg);
+            break;
+
+        case TracePageMap:
+            printf("virt 0x%x", ev->arg);
+            break;
+
+        default:
+            printf("%u", ev->arg);
+            break;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    TraceEvent ev;
+    unsigned long long first = 0, previous = 0;
+    unsigned long counts[TraceEventTypes];
+    unsigned long total = 0;
+    unsigned long mhz = 0;
+    FILE *fp;
+
+    // Verify command-line arguments.
+    if (argc < 2)
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    // Process command-line options.
+    for (int i = 2; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-h"))
+        {
+            usage(argv[0]);
+            return EXIT_SUCCESS;
+        }
+        else if (!strcmp(argv[i], "-m") && i + 1 < argc)
+        {
+            mhz = strtoul(argv[++i], NULL, 10);
+        }
+        else
+        {
+            printf("%s: unknown option: %s\r\n", argv[0], argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+    // Open the trace file.
+    if ((fp = fopen(argv[1], "rb")) == NULL)
+    {
+        printf("%s: failed to open '%s': %s\r\n",
+                argv[0], argv[1], strerror(errno));
+        return EXIT_FAILURE;
+    }
+    memset(counts, 0, sizeof(counts));
+
+    printf("%8s %16s %12s %5s  %-10s %s\r\n",
+           "SEQ", mhz ? "TIME(us)" : "TIME(cycles)",
+           mhz ? "DELTA(us)" : "DELTA", "PID", "EVENT", "ARGUMENT");
+
+    // Decode all events.
+    while (fread(&ev, sizeof(ev), 1, fp) == 1)
+    {
+        if (total == 0)
+            first = previous = ev.timestamp;
+
+        unsigned long long time = ev.timestamp - first;
+        unsigned long long delta = ev.timestamp - previous;
+        previous = ev.timestamp;
+
+        if (mhz)
+        {
+            time /= mhz;
+            delta /= mhz;
+        }
+        printf("%8lu %16llu %12llu %5u  %-10s ",
+                total, time, delta, ev.pid,
+                ev.type < TraceEventTypes ? eventNames[ev.type] : "???");
+        printArgument(&ev);
+        printf("\r\n");
+
+        if (ev.type < TraceEventTypes)
+            counts[ev.type]++;
+        total++;
+    }
+    fclose(fp);
+
+    // Summary per event type.
+    printf("\r\n%lu events\r\n", total);
+
+    for (int i = 0; i < TraceEventTypes; i++)
+        printf("%12lu %s\r\n", counts[i], eventNames[i]);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <stdlib.h>
+#include "TraceFile.h"
+
+TraceFile::TraceFile()
+    : File(RegularFile)
+{
+    m_access = OwnerRW;
+}
+
+TraceFile::~TraceFile()
+{
+}
+
+Error TraceFile::read(IOBuffer & buffer, Size size, Size offset)
+{
+    TraceEvent events[ChunkEvents];
+    Size total = 0;
+    Error r;
+
+    // Drain whole events until the output is full or the ring is empty
+    while (size - total >= sizeof(TraceEvent))
+    {
+        Size max = (size - total) / sizeof(TraceEvent);
+        if (max > ChunkEvents)
+            max = ChunkEvents;
+
+        API::Result count = TraceCtl(TraceRead, (Address) events, max);
+        if (count < 0)
+            return EIO;
+        else if (count == 0)
+            break;
+
+        if ((r = buffer.write(events, count * sizeof(TraceEvent), total)) < 0)
+            return r;
+
+        total += count * sizeof(TraceEvent);
+    }
+    return total;
+}
+
+Error TraceFile::write(IOBuffer & buffer, Size size, Size offset)
+{
+    char mask[16];
+    Error r;
+
+    // Input is the mask as a decimal number
+    if (size >= sizeof(mask))
+        return EIO;
+
+    if ((r = buffer.read(mask, size)) <= 0)
+        return r;
+
+    mask[size] = 0;
+
+    if (TraceCtl(TraceSetMask, atoi(mask)) != API::Success)
+        return EIO;
+
+    return size;
+}
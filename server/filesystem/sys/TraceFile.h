@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __FILESYSTEM_SYS_TRACEFILE_H
+#define __FILESYSTEM_SYS_TRACEFILE_H
+
+#include <File.h>
+
+/**
+ * @addtogroup server
+ * @{
+ *
+ * @addtogroup sysfs
+ * @{
+ */
+
+/**
+ * Drains the kernel event trace ring.
+ *
+ * Reading returns binary TraceEvent records and removes them from the kernel.
+ * Writing a decimal number sets the run-time mask of traced event types.
+ *
+ * @see TraceEvent
+ */
+class TraceFile : public File
+{
+  private:
+
+    /** Number of events to drain from the kernel at once */
+    static const Size ChunkEvents = 64;
+
+  public:
+
+    /**
+     * Constructor function.
+     */
+    TraceFile();
+
+    /**
+     * Destructor function.
+     */
+    virtual ~TraceFile();
+
+    /**
+     * @brief Read bytes from the file.
+     *
+     * @param buffer Input/Output buffer to output bytes to.
+     * @param size Number of bytes to read, at maximum.
+     * @param offset Offset inside the file to start reading.
+     *
+     * @return Number of bytes read on success, Error on failure.
+     */
+    virtual Error read(IOBuffer & buffer, Size size, Size offset);
+
+    /**
+     * Write bytes to the file.
+     *
+     * @param buffer Input/Output buffer to input bytes from.
+     * @param size Number of bytes to write, at maximum.
+     * @param offset Offset inside the file to start writing.
+     *
+     * @return Number of bytes written on success, Error on failure.
+     */
+    virtual Error write(IOBuffer & buffer, Size size, Size offset);
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __FILESYSTEM_SYS_TRACEFILE_H */
@@ -17,6 +17,7 @@
 
 #include <File.h>
 #include <PseudoFile.h>
+#include <PipeFile.h>
 #include <Directory.h>
 #include "TmpFileSystem.h"
 
@@ -37,6 +38,9 @@ File * TmpFileSystem::createFile(FileType type, DeviceID deviceID)
         case DirectoryFile:
             return new Directory;
 
+        case FIFOFile:
+            return new PipeFile;
+
         default:
             return ZERO;
     }
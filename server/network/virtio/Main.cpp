@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <KernelLog.h>
+#include <stdlib.h>
+#include <Runtime.h>
+#include <NetworkServer.h>
+#include "VirtioNet.h"
+
+int main(int argc, char **argv)
+{
+    KernelLog log;
+    log.setMinimumLogLevel(Log::Notice);
+
+    NetworkServer server("/network/virtio");
+
+    // Configuration space is accessed through the PCI server
+    waitMount("/dev/pci");
+
+    // Only mount when there is a device to serve
+    VirtioNet *dev = new VirtioNet(&server);
+    if (dev->probe() != ESUCCESS)
+    {
+        NOTICE("no virtio network device found");
+        return EXIT_FAILURE;
+    }
+    server.initialize();
+
+    server.registerDevice(dev, "io");
+    server.registerInterrupt(dev, dev->getInterrupt());
+
+    // Start serving requests
+    return server.run();
+}
@@ -0,0 +1,286 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <MemoryBlock.h>
+#include <Core.h>
+#include <Log.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <IPV4.h>
+#include <UDP.h>
+#include "VirtioNet.h"
+
+VirtioNet::VirtioNet(NetworkServer *server)
+    : NetworkDevice(server)
+    , m_rxQueue(ReceiveQueue)
+    , m_txQueue(TransmitQueue)
+{
+    DEBUG("");
+
+    m_rxSlots     = ZERO;
+    m_txSlots     = ZERO;
+    m_txFreeCount = 0;
+    m_headerSize  = 0;
+    m_irq         = 0;
+    MemoryBlock::set(&m_rxBuffers, 0, sizeof(m_rxBuffers));
+    MemoryBlock::set(&m_txBuffers, 0, sizeof(m_txBuffers));
+
+    // Used when the device has no address of its own
+    m_address.addr[0] = 0x52;
+    m_address.addr[1] = 0x54;
+    m_address.addr[2] = 0x00;
+    m_address.addr[3] = 0x12;
+    m_address.addr[4] = 0x34;
+    m_address.addr[5] = 0x56;
+}
+
+Error VirtioNet::probe()
+{
+    if (m_virtio.initialize(VirtioPCI::NetworkDevice) != VirtioPCI::Success)
+        return ENODEV;
+
+    return ESUCCESS;
+}
+
+Error VirtioNet::initialize()
+{
+    const u64 wanted = ((u64) 1 << VirtioPCI::EventIndex) |
+                       ((u64) 1 << Checksum) |
+                       ((u64) 1 << MACAddress);
+    u64 features;
+
+    DEBUG("");
+
+    Error r = NetworkDevice::initialize();
+    if (r != ESUCCESS)
+    {
+        ERROR("failed to initialize NetworkDevice");
+        return r;
+    }
+
+    if (m_virtio.negotiate(wanted, &features) != VirtioPCI::Success)
+    {
+        ERROR("failed to negotiate virtio network device features");
+        exit(EXIT_FAILURE);
+    }
+
+    // Every packet fits in a single descriptor, so indirect descriptors are not needed
+    const bool eventIndex = features & ((u64) 1 << VirtioPCI::EventIndex);
+
+    if (m_virtio.enableInterrupts(&m_irq) != VirtioPCI::Success ||
+        m_virtio.setupQueue(&m_rxQueue, false, eventIndex) != VirtioPCI::Success ||
+        m_virtio.setupQueue(&m_txQueue, false, eventIndex) != VirtioPCI::Success)
+    {
+        ERROR("failed to configure virtio network device");
+        exit(EXIT_FAILURE);
+    }
+
+    // Allocate physically contiguous packet buffers
+    m_rxBuffers.size   = ReceiveBuffers * BufferSize;
+    m_rxBuffers.access = Memory::User | Memory::Readable | Memory::Writable;
+    m_txBuffers.size   = TransmitBuffers * BufferSize;
+    m_txBuffers.access = Memory::User | Memory::Readable | Memory::Writable;
+
+    if (VMCtl(SELF, Map, &m_rxBuffers) != API::Success ||
+        VMCtl(SELF, Map, &m_txBuffers) != API::Success)
+    {
+        ERROR("failed to allocate packet buffers");
+        exit(EXIT_FAILURE);
+    }
+
+    m_rxSlots = new Size[m_rxQueue.getSize()];
+    m_txSlots = new Size[m_txQueue.getSize()];
+
+    for (Size i = 0; i < TransmitBuffers && i < m_txQueue.getSize(); i++)
+        m_txFree[m_txFreeCount++] = i;
+
+    // Modern devices always include the number of buffers in the header
+    m_headerSize      = m_virtio.isModern() ? sizeof(Header) : sizeof(Header) - sizeof(u16);
+    m_checksumOffload = features & ((u64) 1 << Checksum);
+
+    if (features & ((u64) 1 << MACAddress))
+    {
+        for (Size i = 0; i < sizeof(m_address.addr); i++)
+            m_address.addr[i] = m_virtio.readConfigByte(i);
+    }
+
+    // Fill the receive queue and start
+    for (Size i = 0; i < ReceiveBuffers && i < m_rxQueue.getSize(); i++)
+        postReceive(i);
+
+    m_txQueue.disableInterrupts();
+    m_virtio.setReady();
+
+    if (m_rxQueue.kick())
+        m_virtio.notify(&m_rxQueue);
+
+    NOTICE("virtio network device " << m_address <<
+           (m_checksumOffload ? " with checksum offload" : "") <<
+           (m_virtio.isModern() ? "" : " (legacy)"));
+    return ESUCCESS;
+}
+
+uint VirtioNet::getInterrupt() const
+{
+    return m_irq;
+}
+
+Error VirtioNet::getAddress(Ethernet::Address *address)
+{
+    DEBUG("");
+    MemoryBlock::copy(address, &m_address, sizeof(Ethernet::Address));
+    return ESUCCESS;
+}
+
+Error VirtioNet::setAddress(Ethernet::Address *address)
+{
+    DEBUG("");
+    MemoryBlock::copy(&m_address, address, sizeof(Ethernet::Address));
+    return ESUCCESS;
+}
+
+Error VirtioNet::transmit(NetworkQueue::Packet *pkt)
+{
+    const Size size = pkt->size;
+    VirtQueue::Buffer buffer;
+    u16 token;
+
+    DEBUG("size = " << size);
+
+    if (size > BufferSize - m_headerSize)
+    {
+        ERROR("packet size too large: " << size);
+        m_transmit.release(pkt);
+        return ERANGE;
+    }
+
+    // Reclaim in batches, once half of the transmit buffers are in flight
+    if (m_txFreeCount < TransmitBuffers / 2)
+        reclaimTransmit();
+
+    // Ask for an interrupt to retry when all buffers are in flight
+    if (!m_txFreeCount && !m_txQueue.enableInterrupts())
+    {
+        m_transmit.release(pkt);
+        return EAGAIN;
+    }
+    else if (!m_txFreeCount)
+        reclaimTransmit();
+
+    const Size slot = m_txFree[--m_txFreeCount];
+    u8 *data = (u8 *) m_txBuffers.virt + (slot * BufferSize);
+    Header *hdr = (Header *) data;
+
+    MemoryBlock::set(hdr, 0, m_headerSize);
+    MemoryBlock::copy(data + m_headerSize, pkt->data, size);
+    m_transmit.release(pkt);
+
+    // UDP only contains the pseudo header checksum, the device completes it
+    if (m_checksumOffload && size > sizeof(Ethernet::Header) + sizeof(IPV4::Header))
+    {
+        const Ethernet::Header *ether = (const Ethernet::Header *) (data + m_headerSize);
+        const IPV4::Header *ip = (const IPV4::Header *) (ether + 1);
+
+        if (be16_to_cpu(ether->type) == Ethernet::IPV4 && ip->protocol == IPV4::UDP)
+        {
+            hdr->flags          = NeedsChecksum;
+            hdr->checksumStart  = sizeof(Ethernet::Header) + ((ip->versionIHL & 0xf) * sizeof(u32));
+            hdr->checksumOffset = sizeof(u16) * 3;
+        }
+    }
+
+    buffer.phys     = m_txBuffers.phys + (slot * BufferSize);
+    buffer.size     = m_headerSize + size;
+    buffer.writable = false;
+
+    if (m_txQueue.submit(&buffer, 1, &token) != VirtQueue::Success)
+    {
+        m_txFree[m_txFreeCount++] = slot;
+        return EAGAIN;
+    }
+    m_txSlots[token] = slot;
+
+    // The device only needs a notification if it stopped processing
+    if (m_txQueue.kick())
+        m_virtio.notify(&m_txQueue);
+
+    return size;
+}
+
+Error VirtioNet::interrupt(Size vector)
+{
+    DEBUG("");
+
+    receive();
+
+    // Transmit interrupts are only wanted while all buffers are in flight
+    reclaimTransmit();
+    m_txQueue.disableInterrupts();
+    return ESUCCESS;
+}
+
+void VirtioNet::receive()
+{
+    NetworkQueue::Packet pkt;
+    u16 token;
+    u32 length;
+
+    // Take all packets, also those that raced with re-enabling the interrupt
+    do
+    {
+        while (m_rxQueue.getCompleted(&token, &length) == VirtQueue::Success)
+        {
+            const Size slot = m_rxSlots[token];
+
+            if (length > m_headerSize)
+            {
+                pkt.data = (u8 *) m_rxBuffers.virt + (slot * BufferSize) + m_headerSize;
+                pkt.size = length - m_headerSize;
+                process(&pkt);
+            }
+            postReceive(slot);
+        }
+    }
+    while (m_rxQueue.enableInterrupts());
+
+    // Publish all re-posted buffers at once
+    if (m_rxQueue.kick())
+        m_virtio.notify(&m_rxQueue);
+}
+
+void VirtioNet::postReceive(Size slot)
+{
+    VirtQueue::Buffer buffer;
+    u16 token;
+
+    buffer.phys     = m_rxBuffers.phys + (slot * BufferSize);
+    buffer.size     = BufferSize;
+    buffer.writable = true;
+
+    if (m_rxQueue.submit(&buffer, 1, &token) == VirtQueue::Success)
+        m_rxSlots[token] = slot;
+}
+
+void VirtioNet::reclaimTransmit()
+{
+    u16 token;
+    u32 length;
+
+    while (m_txQueue.getCompleted(&token, &length) == VirtQueue::Success)
+        m_txFree[m_txFreeCount++] = m_txSlots[token];
+}
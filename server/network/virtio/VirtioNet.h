@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SERVER_NETWORK_VIRTIO_VIRTIONET_H
+#define __SERVER_NETWORK_VIRTIO_VIRTIONET_H
+
+#include <Types.h>
+#include <Memory.h>
+#include <NetworkDevice.h>
+#include <Ethernet.h>
+#include <VirtioPCI.h>
+#include <VirtQueue.h>
+
+/**
+ * @addtogroup server
+ * @{
+ *
+ * @addtogroup virtio
+ * @{
+ */
+
+/**
+ * Virtio network device.
+ *
+ * All receive buffers are posted to the device in advance and
+ * re-posted in a batch after each interrupt. Transmit buffers are
+ * reclaimed in batches without interrupts, which are only requested
+ * when all transmit buffers are in flight.
+ */
+class VirtioNet : public NetworkDevice
+{
+  private:
+
+    /** Number of receive buffers */
+    static const Size ReceiveBuffers = 64;
+
+    /** Number of transmit buffers */
+    static const Size TransmitBuffers = 64;
+
+    /** Size of each buffer, including the virtio header */
+    static const Size BufferSize = 2048;
+
+    /**
+     * Queue numbers.
+     */
+    enum Queues
+    {
+        ReceiveQueue  = 0,
+        TransmitQueue = 1
+    };
+
+    /**
+     * Network device feature bits.
+     */
+    enum Features
+    {
+        Checksum   = 0,
+        MACAddress = 5
+    };
+
+    /**
+     * Header flags.
+     */
+    enum HeaderFlags
+    {
+        NeedsChecksum = (1 << 0)
+    };
+
+    /**
+     * Header in front of each packet.
+     *
+     * The buffers field is only present for modern devices.
+     */
+    typedef struct Header
+    {
+        u8 flags;
+        u8 gsoType;
+        u16 headerLength;
+        u16 gsoSize;
+        u16 checksumStart;
+        u16 checksumOffset;
+        u16 buffers;
+    }
+    Header;
+
+  public:
+
+    /**
+     * Constructor
+     *
+     * @param server Network server
+     */
+    VirtioNet(NetworkServer *server);
+
+    /**
+     * Find the virtio network device.
+     *
+     * @return Error code. ENODEV if no device is present.
+     */
+    Error probe();
+
+    /**
+     * Configure the virtio network device.
+     *
+     * @return Error code
+     */
+    virtual Error initialize();
+
+    /**
+     * Get interrupt number.
+     *
+     * @return Interrupt number of the device
+     */
+    uint getInterrupt() const;
+
+    /**
+     * Read ethernet address.
+     *
+     * @param address Ethernet address reference for output
+     *
+     * @return Error code
+     */
+    virtual Error getAddress(Ethernet::Address *address);
+
+    /**
+     * Set ethernet address
+     *
+     * @param address New ethernet address to set
+     *
+     * @return Error code
+     */
+    virtual Error setAddress(Ethernet::Address *address);
+
+    /**
+     * Transmit one network packet
+     *
+     * @param pkt Network packet buffer
+     *
+     * @return Number of bytes on success, EAGAIN if all transmit buffers are in flight.
+     */
+    virtual Error transmit(NetworkQueue::Packet *pkt);
+
+    /**
+     * Process received packets and reclaim transmit buffers.
+     *
+     * @param vector Interrupt number.
+     *
+     * @return Error code
+     */
+    virtual Error interrupt(Size vector);
+
+  private:
+
+    /**
+     * Pass all received packets to the protocols.
+     */
+    void receive();
+
+    /**
+     * Post a receive buffer to the device.
+     *
+     * @param slot Receive buffer number
+     */
+    void postReceive(Size slot);
+
+    /**
+     * Take all transmitted buffers back.
+     */
+    void reclaimTransmit();
+
+  private:
+
+    /** PCI transport */
+    VirtioPCI m_virtio;
+
+    /** Receive queue */
+    VirtQueue m_rxQueue;
+
+    /** Transmit queue */
+    VirtQueue m_txQueue;
+
+    /** Physically contiguous receive buffers */
+    Memory::Range m_rxBuffers;
+
+    /** Physically contiguous transmit buffers */
+    Memory::Range m_txBuffers;
+
+    /** Maps receive queue tokens to receive buffers */
+    Size *m_rxSlots;
+
+    /** Maps transmit queue tokens to transmit buffers */
+    Size *m_txSlots;
+
+    /** Stack of free transmit buffers */
+    Size m_txFree[TransmitBuffers];
+
+    /** Number of free transmit buffers */
+    Size m_txFreeCount;
+
+    /** Size of the header in front of each packet */
+    Size m_headerSize;
+
+    /** Ethernet address */
+    Ethernet::Address m_address;
+
+    /** Interrupt number */
+    uint m_irq;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __SERVER_NETWORK_VIRTIO_VIRTIONET_H */
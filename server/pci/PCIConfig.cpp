@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <MemoryBlock.h>
+#include <errno.h>
+#include "PCIConfig.h"
+#include "PCIServer.h"
+
+/** Size of the largest MSI capability: 64-bit address with per-vector masking */
+#define PCI_MSI_CAPABILITY_SIZE 24
+
+PCIConfig::PCIConfig(PCIServer *server)
+    : File(CharacterDeviceFile)
+    , m_server(server)
+{
+    m_access = OwnerRW;
+}
+
+bool PCIConfig::isWritable(const IntelPCI::Function & func, u8 reg, Size size) const
+{
+    IntelPCI & pci = m_server->getPCI();
+    u8 cap;
+
+    if (reg == IntelPCI::Command && size == sizeof(u16))
+        return true;
+
+    if (reg >= IntelPCI::BAR0 && reg < IntelPCI::BAR0 + (IntelPCI::BARs * 4) && size == sizeof(u32))
+        return true;
+
+    // Message control and everything after it, but not the capability list links
+    if ((cap = pci.findCapability(func, IntelPCI::MSICapability)) != 0)
+        if (reg >= cap + 2 && reg + size <= (Size) cap + PCI_MSI_CAPABILITY_SIZE)
+            return true;
+
+    // The MSI-X table itself lives in memory space
+    if ((cap = pci.findCapability(func, IntelPCI::MSIXCapability)) != 0)
+        if (reg == cap + 2 && size == sizeof(u16))
+            return true;
+
+    return false;
+}
+
+Error PCIConfig::read(IOBuffer & buffer, Size size, Size offset)
+{
+    IntelPCI & pci = m_server->getPCI();
+    const u8 reg = offset & 0xff;
+    IntelPCI::Function func;
+    IntelPCI::BAR bar;
+    uint irq;
+    u32 value;
+
+    if (offset & PCIConfigOffset::DeviceSpace)
+    {
+        if (size != sizeof(func))
+            return EINVAL;
+
+        if (m_server->getFunction(offset & PCIConfigOffset::AddressMask, &func) != PCIServer::Success)
+            return ENOENT;
+
+        return buffer.write(&func, sizeof(func));
+    }
+
+    MemoryBlock::set(&func, 0, sizeof(func));
+    PCIConfigOffset::getFunction(offset, &func);
+
+    if (offset & PCIConfigOffset::BARSpace)
+    {
+        if (size != sizeof(bar))
+            return EINVAL;
+
+        if (pci.readBAR(func, reg, &bar) != IntelPCI::Success)
+            return ENOENT;
+
+        return buffer.write(&bar, sizeof(bar));
+    }
+
+    if (offset & PCIConfigOffset::MSISpace)
+    {
+        if (size != sizeof(irq))
+            return EINVAL;
+
+        if (m_server->getMSIInterrupt(func, &irq) != PCIServer::Success)
+            return ENOENT;
+
+        return buffer.write(&irq, sizeof(irq));
+    }
+
+    // Registers are accessed at their natural alignment
+    if (reg & (size - 1))
+        return EINVAL;
+
+    switch (size)
+    {
+        case 1: value = pci.readByte(func, reg); break;
+        case 2: value = pci.readWord(func, reg); break;
+        case 4: value = pci.readLong(func, reg); break;
+        default: return EINVAL;
+    }
+
+    return buffer.write(&value, size);
+}
+
+Error PCIConfig::write(IOBuffer & buffer, Size size, Size offset)
+{
+    IntelPCI & pci = m_server->getPCI();
+    const u8 reg = offset & 0xff;
+    const u8 *data = buffer.getBuffer();
+    IntelPCI::Function func;
+
+    if ((offset & ~PCIConfigOffset::AddressMask) || (size != 2 && size != 4) || (reg & (size - 1)))
+        return EINVAL;
+
+    MemoryBlock::set(&func, 0, sizeof(func));
+    PCIConfigOffset::getFunction(offset, &func);
+
+    switch (m_server->claimFunction(func, buffer.getMessage()->from))
+    {
+        case PCIServer::Success:          break;
+        case PCIServer::PermissionDenied: return EACCES;
+        default:                          return ENOENT;
+    }
+
+    if (!isWritable(func, reg, size))
+        return EACCES;
+
+    if (size == 2)
+        pci.writeWord(func, reg, *(const u16 *) data);
+    else
+        pci.writeLong(func, reg, *(const u32 *) data);
+
+    return size;
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SERVER_PCI_PCICONFIG_H
+#define __SERVER_PCI_PCICONFIG_H
+
+#include <Types.h>
+#include <File.h>
+#include <IOBuffer.h>
+#include <intel/IntelPCI.h>
+#include <PCIConfigOffset.h>
+
+/**
+ * @addtogroup server
+ * @{
+ *
+ * @addtogroup pci
+ * @{
+ */
+
+class PCIServer;
+
+/**
+ * Configuration space of all PCI functions as a single file.
+ *
+ * File offsets are laid out as described by PCIConfigOffset. Besides the
+ * registers, the file gives the decoded BARs, the MSI interrupt number and
+ * the list of functions found by the server.
+ *
+ * All accesses are done by the PCI server, one request at a time, so
+ * drivers never interleave the address and data port accesses.
+ *
+ * Writes are limited to the command register, the BARs and the MSI and
+ * MSI-X capabilities. The first process writing to a function owns it,
+ * and writes by other processes are denied while the owner is alive.
+ */
+class PCIConfig : public File
+{
+  public:
+
+    /**
+     * Constructor
+     *
+     * @param server PCI server owning the configuration space
+     */
+    PCIConfig(PCIServer *server);
+
+    /**
+     * Read a register, a decoded BAR, the MSI interrupt number or a function.
+     *
+     * @param buffer Output buffer.
+     * @param size Number of bytes to read: 1, 2 or 4 for registers,
+     *             sizeof(IntelPCI::BAR) for a BAR, sizeof(uint) for MSI and
+     *             sizeof(IntelPCI::Function) for a function.
+     * @param offset File offset from PCIConfigOffset.
+     *
+     * @return Number of bytes read on success, Error on failure.
+     */
+    virtual Error read(IOBuffer & buffer, Size size, Size offset);
+
+    /**
+     * Write a register.
+     *
+     * @param buffer Input buffer.
+     * @param size Number of bytes to write: 2 or 4.
+     * @param offset File offset from PCIConfigOffset.
+     *
+     * @return Number of bytes written on success, Error on failure.
+     */
+    virtual Error write(IOBuffer & buffer, Size size, Size offset);
+
+  private:
+
+    /**
+     * Check if a register may be written by drivers.
+     *
+     * @param func PCI function
+     * @param reg Register offset
+     * @param size Number of bytes to write
+     *
+     * @return True if the register is the command register, a BAR or
+     *         part of the MSI or MSI-X capability.
+     */
+    bool isWritable(const IntelPCI::Function & func, u8 reg, Size size) const;
+
+  private:
+
+    /** PCI server owning the configuration space */
+    PCIServer *m_server;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __SERVER_PCI_PCICONFIG_H */
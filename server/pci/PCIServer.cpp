@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Log.h>
+#include <Directory.h>
+#include <PseudoFile.h>
+#include <stdio.h>
+#include <intel/IntelAPIC.h>
+#include "PCIServer.h"
+
+PCIServer::PCIServer(const char *path)
+    : DeviceServer(path)
+    , m_msiCount(0)
+    , m_msiNext(MSIInterruptBase)
+{
+}
+
+Error PCIServer::initialize()
+{
+    IntelPCI::Function func;
+
+    DeviceServer::initialize();
+
+    for (uint bus = 0; bus < IntelPCI::Buses; bus++)
+    {
+        for (uint slot = 0; slot < IntelPCI::Slots; slot++)
+        {
+            for (uint function = 0; function < IntelPCI::Functions; function++)
+            {
+                if (m_pci.probe(bus, slot, function, &func) != IntelPCI::Success)
+                {
+                    if (function == 0)
+                        break;
+                    else
+                        continue;
+                }
+
+                registerFunction(func);
+
+                if (function == 0 && !m_pci.isMultiFunction(func))
+                    break;
+            }
+        }
+    }
+
+    NOTICE("found " << m_devices.count() << " functions");
+
+    // Drivers access the configuration space through the server
+    registerFile(new PCIConfig(this), "/config");
+    return ESUCCESS;
+}
+
+IntelPCI & PCIServer::getPCI()
+{
+    return m_pci;
+}
+
+PCIServer::Result PCIServer::getFunction(Size index, IntelPCI::Function *func) const
+{
+    if (index >= m_devices.count())
+        return NotFound;
+
+    *func = m_devices[index].func;
+    return Success;
+}
+
+PCIServer::Result PCIServer::claimFunction(const IntelPCI::Function & func, ProcessID pid)
+{
+    ProcessInfo info;
+    Device key;
+
+    key.func = func;
+
+    for (Size i = 0; i < m_devices.count(); i++)
+    {
+        Device & dev = m_devices[i];
+
+        if (dev != key)
+            continue;
+
+        // Take over functions of terminated drivers
+        if (dev.owner == ANY || dev.owner == pid ||
+            ProcessCtl(dev.owner, InfoPID, (Address) &info) != API::Success)
+        {
+            dev.owner = pid;
+            return Success;
+        }
+        return PermissionDenied;
+    }
+    return NotFound;
+}
+
+PCIServer::Result PCIServer::getMSIInterrupt(const IntelPCI::Function & func, uint *irq) const
+{
+    const u32 address = PCIConfigOffset::get(func, 0);
+
+    for (Size i = 0; i < m_msiCount; i++)
+    {
+        if (m_msiFunctions[i] == address)
+        {
+            *irq = m_msiInterrupts[i];
+            return Success;
+        }
+    }
+    return NotFound;
+}
+
+PCIServer::Result PCIServer::allocateMSIInterrupt(const IntelPCI::Function & func, uint *irq)
+{
+    while (m_msiNext < MSIInterruptBase + MSIInterrupts)
+    {
+        *irq = m_msiNext++;
+
+        // The kernel compares interrupt numbers against these vectors
+        if (*irq == IntelAPIC::TimerVector || *irq == IntelAPIC::IPIVector)
+            continue;
+
+        m_msiFunctions[m_msiCount]  = PCIConfigOffset::get(func, 0);
+        m_msiInterrupts[m_msiCount] = *irq;
+        m_msiCount++;
+        return Success;
+    }
+    return NotFound;
+}
+
+void PCIServer::registerFunction(const IntelPCI::Function & func)
+{
+    IntelPCI::BAR bar;
+    Device dev;
+    char name[16], path[32], line[64];
+
+    snprintf(name, sizeof(name), "%02x:%02x.%x", func.bus, func.slot, func.function);
+    snprintf(path, sizeof(path), "/%s", name);
+    registerFile(new Directory, path);
+
+    snprintf(path, sizeof(path), "/%s/vendor", name);
+    registerFile(new PseudoFile("%04x\n", func.vendorId), path);
+
+    snprintf(path, sizeof(path), "/%s/device", name);
+    registerFile(new PseudoFile("%04x\n", func.deviceId), path);
+
+    snprintf(path, sizeof(path), "/%s/class", name);
+    registerFile(new PseudoFile("%02x%02x%02x\n", func.classCode, func.subClass, func.progIf), path);
+
+    snprintf(path, sizeof(path), "/%s/irq", name);
+    registerFile(new PseudoFile("%u\n", func.interruptLine), path);
+
+    // Interrupt number to use when the function is switched to MSI or MSI-X
+    if (m_pci.findCapability(func, IntelPCI::MSICapability) ||
+        m_pci.findCapability(func, IntelPCI::MSIXCapability))
+    {
+        uint irq;
+
+        if (allocateMSIInterrupt(func, &irq) == Success)
+        {
+            snprintf(path, sizeof(path), "/%s/msi", name);
+            registerFile(new PseudoFile("%u\n", irq), path);
+        }
+        else
+            WARNING("no MSI interrupt left for " << name);
+    }
+
+    for (uint i = 0; i < IntelPCI::BARs; i++)
+    {
+        if (m_pci.readBAR(func, i, &bar) == IntelPCI::Success)
+        {
+            snprintf(path, sizeof(path), "/%s/bar%u", name, i);
+            registerFile(new PseudoFile("%s %x %x\n", bar.io ? "io" : "mem",
+                                        (uint) bar.address, (uint) bar.size), path);
+        }
+    }
+
+    snprintf(line, sizeof(line), "%s %04x:%04x class %02x%02x%02x",
+             name, func.vendorId, func.deviceId, func.classCode, func.subClass, func.progIf);
+    NOTICE(line);
+
+    dev.func  = func;
+    dev.owner = ANY;
+    m_devices.insert(dev);
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SERVER_PCI_PCISERVER_H
+#define __SERVER_PCI_PCISERVER_H
+
+#include <DeviceServer.h>
+#include <Vector.h>
+#include <intel/IntelPCI.h>
+#include "PCIConfig.h"
+
+/**
+ * @addtogroup server
+ * @{
+ *
+ * @addtogroup pci
+ * @{
+ */
+
+/**
+ * Enumerates PCI functions and exports them as files.
+ *
+ * Each function is a directory named bus:slot.function, containing
+ * text files with its identification, interrupt and base address registers.
+ *
+ * The server is the only process accessing the configuration space.
+ * Drivers use PCIClient, which accesses it through the config file.
+ */
+class PCIServer : public DeviceServer
+{
+  private:
+
+    /** First interrupt number used for MSI, relative to the APIC interrupt base */
+    static const uint MSIInterruptBase = 32;
+
+    /** Number of interrupt numbers available for MSI */
+    static const uint MSIInterrupts = 32;
+
+    /**
+     * A function found while scanning the buses.
+     */
+    typedef struct Device
+    {
+        /** Identification of the function */
+        IntelPCI::Function func;
+
+        /** Process which writes to the function, or ANY if none yet */
+        ProcessID owner;
+
+        bool operator == (const struct Device & dev) const
+        {
+            return func.bus == dev.func.bus && func.slot == dev.func.slot &&
+                   func.function == dev.func.function;
+        }
+
+        bool operator != (const struct Device & dev) const
+        {
+            return !(*this == dev);
+        }
+    }
+    Device;
+
+  public:
+
+    /**
+     * Result codes
+     */
+    enum Result
+    {
+        Success,
+        NotFound,
+        PermissionDenied
+    };
+
+  public:
+
+    /**
+     * Constructor
+     *
+     * @param path Mount path
+     */
+    PCIServer(const char *path);
+
+    /**
+     * Initialize the server.
+     *
+     * Scans all PCI buses and registers files for each function found.
+     *
+     * @return Error code
+     */
+    virtual Error initialize();
+
+    /**
+     * Get configuration space access.
+     *
+     * @return IntelPCI reference
+     */
+    IntelPCI & getPCI();
+
+    /**
+     * Get the interrupt number to use for MSI.
+     *
+     * @param func PCI function
+     * @param irq Output interrupt number, relative to the APIC interrupt base.
+     *
+     * @return Result code. NotFound if the function has none.
+     */
+    Result getMSIInterrupt(const IntelPCI::Function & func, uint *irq) const;
+
+    /**
+     * Get a function found while scanning the buses.
+     *
+     * @param index Index of the function
+     * @param func Output function
+     *
+     * @return Result code. NotFound if index is past the last function.
+     */
+    Result getFunction(Size index, IntelPCI::Function *func) const;
+
+    /**
+     * Claim a function for writing its configuration registers.
+     *
+     * The first process writing to a function becomes its owner.
+     * Ownership is released when the owner terminates.
+     *
+     * @param func PCI function
+     * @param pid Process writing to the function
+     *
+     * @return Result code. PermissionDenied if another process owns the
+     *         function and NotFound if no such function was found.
+     */
+    Result claimFunction(const IntelPCI::Function & func, ProcessID pid);
+
+  private:
+
+    /**
+     * Allocate an interrupt number for MSI.
+     *
+     * Interrupt numbers are never reused, so no two functions share one.
+     * The numbers of the APIC timer and IPI vectors are skipped.
+     *
+     * @param func PCI function
+     * @param irq Output interrupt number, relative to the APIC interrupt base.
+     *
+     * @return Result code. NotFound if no interrupt numbers are left.
+     */
+    Result allocateMSIInterrupt(const IntelPCI::Function & func, uint *irq);
+
+    /**
+     * Register files for a single PCI function.
+     *
+     * @param func PCI function
+     */
+    void registerFunction(const IntelPCI::Function & func);
+
+  private:
+
+    /** PCI configuration space */
+    IntelPCI m_pci;
+
+    /** Functions found */
+    Vector<Device> m_devices;
+
+    /** Configuration address of each function with an MSI interrupt */
+    u32 m_msiFunctions[MSIInterrupts];
+
+    /** Interrupt number of each function with an MSI interrupt */
+    uint m_msiInterrupts[MSIInterrupts];
+
+    /** Number of MSI interrupts allocated */
+    Size m_msiCount;
+
+    /** Next interrupt number to consider for MSI */
+    uint m_msiNext;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __SERVER_PCI_PCISERVER_H */
@@ -19,6 +19,7 @@
 #include "Terminal.h"
 #include <stdlib.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <Runtime.h>
 #include <KernelLog.h>
 
@@ -36,7 +37,17 @@ int main(int argc, char **argv)
     DeviceServer server("/console");
     server.initialize();
 
+    // Use the framebuffer console when the video server found one.
+    // Unlike stat(), open() looks up mounts which are not known yet.
+    const char *output = "/dev/video/fb0";
+    int fd = ::open(output, O_RDWR);
+
+    if (fd >= 0)
+        ::close(fd);
+    else
+        output = "/dev/video/vga0";
+
     // Start serving requests.
-    server.registerDevice(new Terminal("/dev/ps2/keyboard0", "/dev/video/vga0"), "tty0");
+    server.registerDevice(new Terminal("/dev/ps2/keyboard0", output), "tty0");
     return server.run();
 }
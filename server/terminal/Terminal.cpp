@@ -46,6 +46,8 @@ Terminal::Terminal(const char *in, const char *out,
 {
     m_identifier << "tty0";
     buffer = new u16[width * height];
+    dirtyBegin = width * height;
+    dirtyEnd   = 0;
 }
 
 Error Terminal::initialize()
@@ -72,6 +74,9 @@ Error Terminal::initialize()
         exit(EXIT_FAILURE);
     }
 
+    // Start with the current screen, later writes only send changes
+    ::read(output, buffer, width * height * sizeof(u16));
+
     // Fill in function pointers
     funcs.tf_bell    = (tf_bell_t *)    bell;
     funcs.tf_cursor  = (tf_cursor_t *)  cursor;
@@ -88,8 +93,8 @@ Error Terminal::initialize()
     teken_init(&state, &funcs, this);
 
     // Set appropriate terminal sizes
-    winsz.tp_col = 80;
-    winsz.tp_row = 25;
+    winsz.tp_col = width;
+    winsz.tp_row = height;
     teken_set_winsize(&state, &winsz);
 
     // Print banners
@@ -141,6 +146,15 @@ u16 * Terminal::getCursorValue()
     return &cursorValue;
 }
 
+void Terminal::setDirty(Size begin, Size end)
+{
+    if (begin < dirtyBegin)
+        dirtyBegin = begin;
+
+    if (end > dirtyEnd)
+        dirtyEnd = end;
+}
+
 Error Terminal::read(IOBuffer & buffer, Size size, Size offset)
 {
     char tmp[255];
@@ -157,10 +171,6 @@ Error Terminal::write(IOBuffer & buffer, Size size, Size offset)
 {
     char cr = '\r', ch;
 
-    // Initialize buffer with the current screen first
-    ::lseek(output, 0, SEEK_SET);
-    ::read(output, this->buffer, width * height * 2);
-
     // Loop all input characters. Add an additional carriage return
     // whenever a linefeed is detected.
     for (Size i = 0; i < size; i++)
@@ -173,9 +183,14 @@ Error Terminal::write(IOBuffer & buffer, Size size, Size offset)
         teken_input(&state, &ch, 1);
     }
 
-    // Flush changes back to our output device
-    ::lseek(output, 0, SEEK_SET);
-    ::write(output, this->buffer, width * height * 2);
+    // Flush only the changed cells back to our output device
+    if (dirtyBegin < dirtyEnd)
+    {
+        ::lseek(output, dirtyBegin * sizeof(u16), SEEK_SET);
+        ::write(output, this->buffer + dirtyBegin, (dirtyEnd - dirtyBegin) * sizeof(u16));
+        dirtyBegin = width * height;
+        dirtyEnd   = 0;
+    }
 
     // Done
     return size;
@@ -188,6 +203,7 @@ void Terminal::hideCursor()
     // Restore old attributes
     buffer[index] &= 0xff;
     buffer[index] |= (cursorValue & 0xff00);
+    setDirty(index, index + 1);
 }
 
 void Terminal::setCursor(const teken_pos_t *pos)
@@ -207,6 +223,7 @@ void Terminal::showCursor()
     // Write cursor
     buffer[index] &= 0xff;
     buffer[index] |= VGA_ATTR(LIGHTGREY, LIGHTGREY) << 8;
+    setDirty(index, index + 1);
 }
 
 void bell(Terminal *term)
@@ -227,6 +244,8 @@ void putchar(Terminal *term, const teken_pos_t *pos,
     // Write the buffer
     buffer[pos->tp_col + (pos->tp_row * width)] =
         VGA_CHAR(ch, tekenToVGA[attr->ta_fgcolor], BLACK);
+    term->setDirty(pos->tp_col + (pos->tp_row * width),
+                   pos->tp_col + (pos->tp_row * width) + 1);
 
     // Show cursor again
     term->showCursor();
@@ -257,10 +276,32 @@ void fill(Terminal *term, const teken_rect_t *rect,
                 VGA_CHAR(ch, tekenToVGA[attr->ta_fgcolor], BLACK);
         }
     }
+    if (rect->tr_end.tp_row > rect->tr_begin.tp_row)
+    {
+        term->setDirty(rect->tr_begin.tp_col + (rect->tr_begin.tp_row * term->getWidth()),
+                       rect->tr_end.tp_col + ((rect->tr_end.tp_row - 1) * term->getWidth()));
+    }
     // Show cursor again
     term->showCursor();
 }
 
+/**
+ * Copy character cells, which may overlap.
+ */
+static void copyCells(u16 *dst, const u16 *src, Size count)
+{
+    if (dst < src)
+    {
+        for (Size i = 0; i < count; i++)
+            dst[i] = src[i];
+    }
+    else
+    {
+        for (Size i = count; i > 0; i--)
+            dst[i - 1] = src[i - 1];
+    }
+}
+
 void copy(Terminal *term, const teken_rect_t *rect,
           const teken_pos_t *pos)
 {
@@ -275,10 +316,34 @@ void copy(Terminal *term, const teken_rect_t *rect,
     // Hide cursor first
     term->hideCursor();
 
-    // Copy video memory
-    memcpy(buffer + pos->tp_col + (pos->tp_row * width),
-           buffer + rect->tr_begin.tp_col + (rect->tr_begin.tp_row * width),
-           numCols + (numRows * width) * sizeof(u16));
+    // Whole rows are contiguous, such as when scrolling
+    if (numCols == width)
+    {
+        copyCells(buffer + (pos->tp_row * width),
+                  buffer + (rect->tr_begin.tp_row * width),
+                  numRows * width);
+    }
+    // Copy row by row, in the order which does not overwrite the source
+    else if (pos->tp_row <= rect->tr_begin.tp_row)
+    {
+        for (Size row = 0; row < numRows; row++)
+            copyCells(buffer + pos->tp_col + ((pos->tp_row + row) * width),
+                      buffer + rect->tr_begin.tp_col + ((rect->tr_begin.tp_row + row) * width),
+                      numCols);
+    }
+    else
+    {
+        for (Size row = numRows; row > 0; row--)
+            copyCells(buffer + pos->tp_col + ((pos->tp_row + row - 1) * width),
+                      buffer + rect->tr_begin.tp_col + ((rect->tr_begin.tp_row + row - 1) * width),
+                      numCols);
+    }
+
+    if (numRows)
+    {
+        term->setDirty(pos->tp_col + (pos->tp_row * width),
+                       pos->tp_col + ((pos->tp_row + numRows - 1) * width) + numCols);
+    }
 
     // Show cursor again
     term->showCursor();
@@ -104,6 +104,14 @@ class Terminal : public Device
      */
     u16 * getCursorValue();
 
+    /**
+     * Mark character cells to be flushed to the output device.
+     *
+     * @param begin Index of the first changed cell.
+     * @param end Index after the last changed cell.
+     */
+    void setDirty(Size begin, Size end);
+
     /**
      * Hides the cursor from the VGA screen.
      */
@@ -167,6 +175,9 @@ class Terminal : public Device
     /** Saved value at cursor position. */
         u16 cursorValue;
 
+    /** Range of changed cells not yet written to the output device. */
+    Size dirtyBegin, dirtyEnd;
+
     /**
      * @brief Path to the input and output files.
      */
@@ -0,0 +1,322 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <intel/IntelConstant.h>
+#include <PCIClient.h>
+#include <MemoryBlock.h>
+#include <Log.h>
+#include <errno.h>
+#include "Framebuffer.h"
+#include "VGA.h"
+
+/** Pixel values of the VGA colors */
+static const u32 palette[] =
+{
+    0x000000, 0x0000aa, 0x00aa00, 0x00aaaa,
+    0xaa0000, 0xaa00aa, 0xaa5500, 0xaaaaaa,
+    0x555555, 0x5555ff, 0x55ff55, 0x55ffff,
+    0xff5555, 0xff55ff, 0xffff55, 0xffffff
+};
+
+Framebuffer::Framebuffer(Size width, Size height)
+    : Device(BlockDeviceFile)
+    , m_width(width)
+    , m_height(height)
+{
+    m_identifier << "fb0";
+    m_framebufferAddress = 0;
+    m_framebuffer = ZERO;
+    m_pitch       = width * GlyphWidth;
+    m_cells       = ZERO;
+    m_glyphs      = ZERO;
+    MemoryBlock::set(m_font, 0, sizeof(m_font));
+    MemoryBlock::set(m_glyphTags, 0xff, sizeof(m_glyphTags));
+}
+
+bool Framebuffer::detect()
+{
+    PCIClient pci;
+    IntelPCI::Function func;
+    IntelPCI::BAR bar;
+
+    if (pci.find(VendorID, DeviceID, &func) != IntelPCI::Success)
+        return false;
+
+    if (readVBE(VBEIdentifier) < VBEMinimumVersion)
+        return false;
+
+    if (pci.readBAR(func, FramebufferBAR, &bar) != IntelPCI::Success || bar.io)
+        return false;
+
+    pci.enable(func, IntelPCI::MemorySpace);
+    m_framebufferAddress = bar.address;
+    return true;
+}
+
+Error Framebuffer::initialize()
+{
+    Memory::Range range;
+
+    // Already done when the video server checked for failures
+    if (m_framebuffer)
+        return ESUCCESS;
+
+    // The font is only available before leaving text mode
+    Error r = readFont();
+    if (r != ESUCCESS)
+    {
+        ERROR("failed to read VGA font");
+        return r;
+    }
+
+    // Allocate everything before leaving text mode, such that VGA remains usable
+    m_cells  = new u16[m_width * m_height];
+    m_glyphs = new u32[GlyphCacheSize * GlyphWidth * GlyphHeight];
+
+    if (!m_cells || !m_glyphs)
+    {
+        ERROR("failed to allocate character cells");
+        release();
+        return ENOMEM;
+    }
+
+    // Map the framebuffer cached, like the VGA text buffer
+    range.virt   = ZERO;
+    range.phys   = m_framebufferAddress;
+    range.size   = ((m_pitch * m_height * GlyphHeight * sizeof(u32)) + PAGESIZE - 1) & PAGEMASK;
+    range.access = Memory::User | Memory::Readable | Memory::Writable;
+
+    if (VMCtl(SELF, Map, &range) != API::Success)
+    {
+        ERROR("failed to map framebuffer");
+        release();
+        return EIO;
+    }
+    m_framebuffer = (u32 *) range.virt;
+
+    writeVBE(VBEEnable, 0);
+    writeVBE(VBEWidth, m_width * GlyphWidth);
+    writeVBE(VBEHeight, m_height * GlyphHeight);
+    writeVBE(VBEDepth, 32);
+    writeVBE(VBEEnable, VBEEnabled | VBELinearFramebuffer);
+
+    // Clear screen
+    for (Size i = 0; i < m_width * m_height; i++)
+    {
+        m_cells[i] = VGA_CHAR(' ', LIGHTGREY, BLACK);
+        draw(i);
+    }
+
+    NOTICE("framebuffer console at " << (m_width * GlyphWidth) << "x" << (m_height * GlyphHeight));
+    return ESUCCESS;
+}
+
+Error Framebuffer::read(IOBuffer & buffer, Size size, Size offset)
+{
+    if (offset + size > m_width * m_height * sizeof(u16))
+    {
+        return EFAULT;
+    }
+    buffer.write(m_cells + (offset / sizeof(u16)), size);
+    return size;
+}
+
+Error Framebuffer::write(IOBuffer & buffer, Size size, Size offset)
+{
+    if (offset + size > m_width * m_height * sizeof(u16))
+    {
+        return EFAULT;
+    }
+
+    if ((offset % sizeof(u16)) || (size % sizeof(u16)))
+    {
+        return EINVAL;
+    }
+
+    const u16 *cells = (const u16 *) buffer.getBuffer();
+    const Size first = offset / sizeof(u16);
+    const Size count = size / sizeof(u16);
+
+    // Scroll the pixels along when the whole rows moved up
+    if (!(first % m_width) && !(count % m_width) && count > m_width)
+    {
+        const Size lines = findScroll(cells, first / m_width, count / m_width);
+
+        if (lines)
+            scroll(first / m_width, count / m_width, lines);
+    }
+
+    // Only draw the cells which changed
+    for (Size i = 0; i < count; i++)
+    {
+        if (m_cells[first + i] != cells[i])
+        {
+            m_cells[first + i] = cells[i];
+            draw(first + i);
+        }
+    }
+    return size;
+}
+
+void Framebuffer::release()
+{
+    if (m_cells)
+        delete[] m_cells;
+
+    if (m_glyphs)
+        delete[] m_glyphs;
+
+    m_cells  = ZERO;
+    m_glyphs = ZERO;
+}
+
+Error Framebuffer::readFont()
+{
+    Memory::Range range;
+    u8 memoryMode, readMap, mode, misc;
+
+    range.virt   = ZERO;
+    range.phys   = FontAddress;
+    range.size   = 256 * 32;
+    range.access = Memory::User | Memory::Readable;
+
+    if (VMCtl(SELF, Map, &range) != API::Success)
+        return EIO;
+
+    // Expose plane 2 with the font at the start of VGA memory
+    m_io.outb(SequencerIndex, 4);
+    memoryMode = m_io.inb(SequencerData);
+    m_io.outb(SequencerData, 0x06);
+    m_io.outb(GraphicsIndex, 4);
+    readMap = m_io.inb(GraphicsData);
+    m_io.outb(GraphicsData, 0x02);
+    m_io.outb(GraphicsIndex, 5);
+    mode = m_io.inb(GraphicsData);
+    m_io.outb(GraphicsData, 0x00);
+    m_io.outb(GraphicsIndex, 6);
+    misc = m_io.inb(GraphicsData);
+    m_io.outb(GraphicsData, 0x04);
+
+    // Each character takes 32 bytes, of which the first are used
+    const volatile u8 *font = (const volatile u8 *) range.virt;
+
+    for (Size ch = 0; ch < 256; ch++)
+        for (Size y = 0; y < GlyphHeight; y++)
+            m_font[(ch * GlyphHeight) + y] = font[(ch * 32) + y];
+
+    // Restore text mode access
+    m_io.outb(SequencerIndex, 4);
+    m_io.outb(SequencerData, memoryMode);
+    m_io.outb(GraphicsIndex, 4);
+    m_io.outb(GraphicsData, readMap);
+    m_io.outb(GraphicsIndex, 5);
+    m_io.outb(GraphicsData, mode);
+    m_io.outb(GraphicsIndex, 6);
+    m_io.outb(GraphicsData, misc);
+
+    VMCtl(SELF, UnMap, &range);
+    return ESUCCESS;
+}
+
+void Framebuffer::writeVBE(u16 reg, u16 value)
+{
+    m_io.outw(VBEIndex, reg);
+    m_io.outw(VBEData, value);
+}
+
+u16 Framebuffer::readVBE(u16 reg)
+{
+    m_io.outw(VBEIndex, reg);
+    return m_io.inw(VBEData);
+}
+
+Size Framebuffer::findScroll(const u16 *cells, Size row, Size rows) const
+{
+    const u16 *screen = m_cells + (row * m_width);
+    const Size count = rows * m_width;
+    Size changed = 0;
+
+    for (Size i = 0; i < count; i++)
+        if (cells[i] != screen[i])
+            changed++;
+
+    // Moving is only worth it if less lines must be drawn afterwards
+    for (Size lines = 1; lines < rows && (lines * m_width) < changed; lines++)
+    {
+        const Size moved = (rows - lines) * m_width;
+        Size i;
+
+        for (i = 0; i < moved && cells[i] == screen[i + (lines * m_width)]; i++)
+            ;
+
+        if (i == moved)
+            return lines;
+    }
+    return 0;
+}
+
+void Framebuffer::scroll(Size row, Size rows, Size lines)
+{
+    u32 *dst = m_framebuffer + (row * GlyphHeight * m_pitch);
+    const u32 *src = dst + (lines * GlyphHeight * m_pitch);
+    const Size pixels = (rows - lines) * GlyphHeight * m_pitch;
+    u16 *cells = m_cells + (row * m_width);
+
+    // Moving up, so a forward copy only overwrites what was already moved
+    for (Size i = 0; i < pixels; i++)
+        dst[i] = src[i];
+
+    for (Size i = 0; i < (rows - lines) * m_width; i++)
+        cells[i] = cells[i + (lines * m_width)];
+}
+
+void Framebuffer::draw(Size index)
+{
+    const u32 *glyph = getGlyph(m_cells[index]);
+    u32 *dst = m_framebuffer + ((index / m_width) * GlyphHeight * m_pitch) +
+                               ((index % m_width) * GlyphWidth);
+
+    for (Size y = 0; y < GlyphHeight; y++)
+    {
+        for (Size x = 0; x < GlyphWidth; x++)
+            dst[x] = glyph[x];
+
+        dst   += m_pitch;
+        glyph += GlyphWidth;
+    }
+}
+
+const u32 * Framebuffer::getGlyph(u16 cell)
+{
+    const Size index = (cell + ((cell >> 8) * 67)) & (GlyphCacheSize - 1);
+    u32 *glyph = m_glyphs + (index * GlyphWidth * GlyphHeight);
+
+    if (m_glyphTags[index] == cell)
+        return glyph;
+
+    const u8 *bitmap = m_font + ((cell & 0xff) * GlyphHeight);
+    const u32 front = palette[(cell >> 8) & 0xf];
+    const u32 back  = palette[(cell >> 12) & 0xf];
+
+    for (Size y = 0; y < GlyphHeight; y++)
+        for (Size x = 0; x < GlyphWidth; x++)
+            glyph[(y * GlyphWidth) + x] = (bitmap[y] & (0x80 >> x)) ? front : back;
+
+    m_glyphTags[index] = cell;
+    return glyph;
+}
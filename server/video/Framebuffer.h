@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __VIDEO_FRAMEBUFFER_H
+#define __VIDEO_FRAMEBUFFER_H
+
+#include <Types.h>
+#include <Device.h>
+#include <IOBuffer.h>
+#include <intel/IntelIO.h>
+
+/**
+ * @addtogroup server
+ * @{
+ *
+ * @addtogroup video
+ * @{
+ */
+
+/**
+ * Text console on a linear framebuffer.
+ *
+ * Uses the Bochs VBE extensions of the QEMU and Bochs standard VGA
+ * adapter. The device file has the same format as the VGA text buffer,
+ * two bytes per character cell, so the Terminal can use either device.
+ *
+ * Each write is compared against a copy of the cells on screen and only
+ * changed cells are drawn, from a cache of pre-rendered glyphs. A write
+ * of whole rows which equals the screen moved up by some lines is drawn
+ * by moving the scanlines in the framebuffer first.
+ *
+ * @see VGA
+ */
+class Framebuffer : public Device
+{
+  private:
+
+    /** Width of a glyph in pixels */
+    static const Size GlyphWidth = 8;
+
+    /** Height of a glyph in pixels */
+    static const Size GlyphHeight = 16;
+
+    /** Number of entries in the glyph cache, a power of two */
+    static const Size GlyphCacheSize = 512;
+
+    /** PCI vendor identifier of the adapter */
+    static const u16 VendorID = 0x1234;
+
+    /** PCI device identifier of the adapter */
+    static const u16 DeviceID = 0x1111;
+
+    /** Base address register of the linear framebuffer */
+    static const Size FramebufferBAR = 0;
+
+    /** Physical address of the VGA memory with the font */
+    static const Address FontAddress = 0xa0000;
+
+    /**
+     * I/O ports.
+     */
+    enum Ports
+    {
+        SequencerIndex = 0x3c4,
+        SequencerData  = 0x3c5,
+        GraphicsIndex  = 0x3ce,
+        GraphicsData   = 0x3cf,
+        VBEIndex       = 0x1ce,
+        VBEData        = 0x1cf
+    };
+
+    /**
+     * VBE registers.
+     */
+    enum VBERegisters
+    {
+        VBEIdentifier = 0,
+        VBEWidth      = 1,
+        VBEHeight     = 2,
+        VBEDepth      = 3,
+        VBEEnable     = 4
+    };
+
+    /**
+     * VBE enable register flags.
+     */
+    enum VBEEnableFlags
+    {
+        VBEEnabled           = (1 << 0),
+        VBELinearFramebuffer = (1 << 6)
+    };
+
+    /** Lowest VBE identifier with 32 bits per pixel */
+    static const u16 VBEMinimumVersion = 0xb0c2;
+
+  public:
+
+    /**
+     * Constructor
+     *
+     * @param width Number of characters horizontally.
+     * @param height Number of characters vertically.
+     */
+    Framebuffer(Size width = 80, Size height = 25);
+
+    /**
+     * Check for a supported adapter.
+     *
+     * @return True if the adapter is present.
+     */
+    bool detect();
+
+    /**
+     * Read the font, switch to graphics mode and clear the screen.
+     *
+     * The adapter stays in text mode if any step fails.
+     *
+     * @return Error status code.
+     */
+    virtual Error initialize();
+
+    /**
+     * Read character cells.
+     *
+     * @param buffer Output buffer.
+     * @param size Number of bytes to read.
+     * @param offset Offset in the character cells in bytes.
+     *
+     * @return Number of bytes on success and an error code on failure.
+     */
+    virtual Error read(IOBuffer & buffer, Size size, Size offset);
+
+    /**
+     * Write character cells and draw the changes.
+     *
+     * @param buffer Input buffer.
+     * @param size Number of bytes to write.
+     * @param offset Offset in the character cells in bytes.
+     *
+     * @return Number of bytes on success and an error code on failure.
+     */
+    virtual Error write(IOBuffer & buffer, Size size, Size offset);
+
+  private:
+
+    /**
+     * Free the character cells and the glyph cache.
+     */
+    void release();
+
+    /**
+     * Copy the text mode font from VGA plane 2.
+     *
+     * @return Error status code.
+     */
+    Error readFont();
+
+    /**
+     * Write a VBE register.
+     *
+     * @param reg VBE register
+     * @param value New value
+     */
+    void writeVBE(u16 reg, u16 value);
+
+    /**
+     * Read a VBE register.
+     *
+     * @param reg VBE register
+     *
+     * @return Register value
+     */
+    u16 readVBE(u16 reg);
+
+    /**
+     * Find the number of lines the screen moved up.
+     *
+     * @param cells New character cells of whole rows.
+     * @param row First row.
+     * @param rows Number of rows.
+     *
+     * @return Number of lines, or zero if moving does not save drawing.
+     */
+    Size findScroll(const u16 *cells, Size row, Size rows) const;
+
+    /**
+     * Move rows up on the screen.
+     *
+     * @param row First row.
+     * @param rows Number of rows.
+     * @param lines Number of lines to move up.
+     */
+    void scroll(Size row, Size rows, Size lines);
+
+    /**
+     * Draw a single character cell.
+     *
+     * @param index Index of the cell.
+     */
+    void draw(Size index);
+
+    /**
+     * Get the pixels of a character cell.
+     *
+     * @param cell Character and attributes.
+     *
+     * @return Glyph pixels from the cache, rendered on a miss.
+     */
+    const u32 * getGlyph(u16 cell);
+
+  private:
+
+    /** Port I/O */
+    IntelIO m_io;
+
+    /** Physical address of the linear framebuffer */
+    Address m_framebufferAddress;
+
+    /** Linear framebuffer */
+    u32 *m_framebuffer;
+
+    /** Number of pixels per scanline */
+    Size m_pitch;
+
+    /** Number of characters horizontally */
+    const Size m_width;
+
+    /** Number of characters vertically */
+    const Size m_height;
+
+    /** Character cells on the screen */
+    u16 *m_cells;
+
+    /** Font bitmaps, one byte per scanline */
+    u8 m_font[256 * GlyphHeight];
+
+    /** Pre-rendered glyphs */
+    u32 *m_glyphs;
+
+    /** Character cell of each cached glyph, or an invalid value */
+    u32 m_glyphTags[GlyphCacheSize];
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __VIDEO_FRAMEBUFFER_H */
@@ -18,15 +18,29 @@
 #include <FileType.h>
 #include <DeviceServer.h>
 #include "VGA.h"
+#include "Framebuffer.h"
 #include <stdlib.h>
 #include <unistd.h>
+#include <Runtime.h>
 
 int main(int argc, char **argv)
 {
     DeviceServer server("/dev/video");
+
+    // Configuration space is accessed through the PCI server
+    waitMount("/dev/pci");
     server.initialize();
 
-    // Start serving requests.
-    server.registerDevice(new VGA, "vga0");
+    // Prefer a framebuffer console over VGA text mode
+    Framebuffer *fb = new Framebuffer;
+
+    // Start serving requests. Fall back to VGA if the framebuffer fails.
+    if (fb && fb->detect() && fb->initialize() == ESUCCESS)
+        server.registerDevice(fb, "fb0");
+    else
+    {
+        delete fb;
+        server.registerDevice(new VGA, "vga0");
+    }
     return server.run();
 }
@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <MemoryBlock.h>
+#include <Log.h>
+#include <stdlib.h>
+#include <errno.h>
+#include "VirtioBlock.h"
+
+VirtioBlock::VirtioBlock()
+    : Device(BlockDeviceFile)
+    , m_queue(0)
+{
+    m_identifier << "vblk0";
+    m_capacity = 0;
+    m_readOnly = false;
+    m_irq      = 0;
+    MemoryBlock::set(m_requests, 0, sizeof(m_requests));
+    MemoryBlock::set(&m_headers, 0, sizeof(m_headers));
+}
+
+Error VirtioBlock::probe()
+{
+    if (m_virtio.initialize(VirtioPCI::BlockDevice) != VirtioPCI::Success)
+        return ENODEV;
+
+    return ESUCCESS;
+}
+
+Error VirtioBlock::initialize()
+{
+    const u64 wanted = ((u64) 1 << VirtioPCI::IndirectDescriptors) |
+                       ((u64) 1 << VirtioPCI::EventIndex) |
+                       ((u64) 1 << ReadOnly);
+    u64 features;
+
+    if (m_virtio.negotiate(wanted, &features) != VirtioPCI::Success ||
+        m_virtio.enableInterrupts(&m_irq) != VirtioPCI::Success ||
+        m_virtio.setupQueue(&m_queue,
+                            features & ((u64) 1 << VirtioPCI::IndirectDescriptors),
+                            features & ((u64) 1 << VirtioPCI::EventIndex)) != VirtioPCI::Success)
+    {
+        ERROR("failed to configure virtio block device");
+        exit(EXIT_FAILURE);
+    }
+
+    // Headers and status bytes of all slots share a single page
+    m_headers.virt   = ZERO;
+    m_headers.phys   = ZERO;
+    m_headers.size   = PAGESIZE;
+    m_headers.access = Memory::User | Memory::Readable | Memory::Writable;
+
+    if (VMCtl(SELF, Map, &m_headers) != API::Success)
+    {
+        ERROR("failed to allocate request headers");
+        exit(EXIT_FAILURE);
+    }
+
+    for (Size i = 0; i < RequestSlots; i++)
+    {
+        Request *req = &m_requests[i];
+
+        req->header = (volatile RequestHeader *) (m_headers.virt + (sizeof(RequestHeader) * i));
+        req->status = (volatile u8 *) (m_headers.virt + (sizeof(RequestHeader) * RequestSlots) + i);
+
+        req->data.virt   = ZERO;
+        req->data.phys   = ZERO;
+        req->data.size   = MaximumTransfer;
+        req->data.access = Memory::User | Memory::Readable | Memory::Writable;
+
+        if (VMCtl(SELF, Map, &req->data) != API::Success)
+        {
+            ERROR("failed to allocate request buffers");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    m_capacity = m_virtio.readConfig(0) | ((u64) m_virtio.readConfig(4) << 32);
+    m_readOnly = features & ((u64) 1 << ReadOnly);
+    m_virtio.setReady();
+
+    NOTICE("virtio block device with " << (uint) (m_capacity / 2048) << " MiB" <<
+           (m_virtio.isModern() ? "" : " (legacy)"));
+    return ESUCCESS;
+}
+
+uint VirtioBlock::getInterrupt() const
+{
+    return m_irq;
+}
+
+Error VirtioBlock::read(IOBuffer & buffer, Size size, Size offset)
+{
+    return transfer(buffer, size, offset, false);
+}
+
+Error VirtioBlock::write(IOBuffer & buffer, Size size, Size offset)
+{
+    return transfer(buffer, size, offset, true);
+}
+
+Error VirtioBlock::interrupt(Size vector)
+{
+    u16 token;
+    u32 length;
+
+    // Take all completions, also those that raced with re-enabling the interrupt
+    do
+    {
+        while (m_queue.getCompleted(&token, &length) == VirtQueue::Success)
+        {
+            for (Size i = 0; i < RequestSlots; i++)
+            {
+                if (m_requests[i].message && m_requests[i].token == token)
+                {
+                    m_requests[i].completed = true;
+                    break;
+                }
+            }
+        }
+    }
+    while (m_queue.enableInterrupts());
+
+    return ESUCCESS;
+}
+
+Error VirtioBlock::transfer(IOBuffer & buffer, Size size, Size offset, bool write)
+{
+    Request *req = findRequest(buffer.getMessage());
+
+    if (!req)
+    {
+        const u64 end = m_capacity * SectorSize;
+
+        if (write && m_readOnly)
+            return EROFS;
+
+        if (offset >= end)
+            return write ? EIO : 0;
+
+        if (offset + size > end)
+            size = end - offset;
+
+        return submit(buffer, size, offset, write);
+    }
+
+    if (!req->completed)
+        return EAGAIN;
+
+    // Unaligned writes continue once the partly written sectors are read
+    if (req->merge && *req->status == StatusOK)
+    {
+        MemoryBlock::copy((u8 *) req->data.virt + req->skip, buffer.getBuffer(), req->size);
+
+        if (enqueue(req, buffer.getMessage(), true) == VirtQueue::Success)
+            req->merge = false;
+
+        return EAGAIN;
+    }
+
+    // Release the slot before returning the result
+    const Error result = *req->status == StatusOK ? (Error) req->size : EIO;
+
+    if (result != EIO && !write)
+        buffer.bufferedWrite((u8 *) req->data.virt + req->skip, req->size);
+
+    req->message = ZERO;
+    return result;
+}
+
+Error VirtioBlock::submit(IOBuffer & buffer, Size size, Size offset, bool write)
+{
+    Request *req = findRequest(ZERO);
+
+    // Retried when a completion frees a slot
+    if (!req)
+        return EAGAIN;
+
+    req->skip = offset % SectorSize;
+
+    // Larger transfers return a partial count to the client
+    if (CEIL(req->skip + size, SectorSize) * SectorSize > MaximumTransfer)
+        size = MaximumTransfer - req->skip;
+
+    req->size = size;
+    req->header->sector = offset / SectorSize;
+
+    // Sectors which are only partly written must be read first
+    req->merge = write && (req->skip || (size % SectorSize));
+
+    if (write && !req->merge)
+        MemoryBlock::copy((void *) req->data.virt, buffer.getBuffer(), size);
+
+    enqueue(req, buffer.getMessage(), write && !req->merge);
+    return EAGAIN;
+}
+
+VirtQueue::Result VirtioBlock::enqueue(Request *req, const FileSystemMessage *message, bool write)
+{
+    VirtQueue::Buffer buffers[3];
+    const Size length = CEIL(req->skip + req->size, SectorSize) * SectorSize;
+
+    req->header->type     = write ? Out : In;
+    req->header->reserved = 0;
+    *req->status          = 0xff;
+
+    buffers[0].phys     = m_headers.phys + ((Address) req->header - m_headers.virt);
+    buffers[0].size     = sizeof(RequestHeader);
+    buffers[0].writable = false;
+    buffers[1].phys     = req->data.phys;
+    buffers[1].size     = length;
+    buffers[1].writable = !write;
+    buffers[2].phys     = m_headers.phys + ((Address) req->status - m_headers.virt);
+    buffers[2].size     = sizeof(u8);
+    buffers[2].writable = true;
+
+    const VirtQueue::Result result = m_queue.submit(buffers, 3, &req->token);
+    if (result != VirtQueue::Success)
+        return result;
+
+    req->message   = message;
+    req->completed = false;
+
+    // The device only needs a notification if it stopped processing
+    if (m_queue.kick())
+        m_virtio.notify(&m_queue);
+
+    return VirtQueue::Success;
+}
+
+VirtioBlock::Request * VirtioBlock::findRequest(const FileSystemMessage *message)
+{
+    for (Size i = 0; i < RequestSlots; i++)
+        if (m_requests[i].message == message)
+            return &m_requests[i];
+
+    return ZERO;
+}
@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SERVER_VIRTIO_BLOCK_VIRTIOBLOCK_H
+#define __SERVER_VIRTIO_BLOCK_VIRTIOBLOCK_H
+
+#include <Types.h>
+#include <Memory.h>
+#include <Device.h>
+#include <IOBuffer.h>
+#include <VirtioPCI.h>
+#include <VirtQueue.h>
+
+/**
+ * @addtogroup server
+ * @{
+ *
+ * @addtogroup virtio
+ * @{
+ */
+
+/**
+ * Virtio block device.
+ *
+ * Reads and writes are submitted to the request queue and answered
+ * with EAGAIN, such that many requests from different clients can
+ * be in flight at once. The completion interrupt marks them done,
+ * after which the retried read or write returns the result.
+ * Writes which only partly cover a sector first read the sectors
+ * involved, merge in the new bytes and then write them back.
+ */
+class VirtioBlock : public Device
+{
+  private:
+
+    /** Size of a sector in bytes */
+    static const Size SectorSize = 512;
+
+    /** Maximum number of requests in flight */
+    static const Size RequestSlots = 16;
+
+    /** Maximum number of bytes transferred by a single request */
+    static const Size MaximumTransfer = 65536;
+
+    /**
+     * Block device feature bits.
+     */
+    enum Features
+    {
+        ReadOnly = 5
+    };
+
+    /**
+     * Request types.
+     */
+    enum RequestType
+    {
+        In  = 0,
+        Out = 1
+    };
+
+    /**
+     * Request status values.
+     */
+    enum RequestStatus
+    {
+        StatusOK          = 0,
+        StatusIOError     = 1,
+        StatusUnsupported = 2
+    };
+
+    /**
+     * Request header read by the device.
+     */
+    typedef struct RequestHeader
+    {
+        u32 type;
+        u32 reserved;
+        u64 sector;
+    }
+    RequestHeader;
+
+    /**
+     * Request slot.
+     */
+    typedef struct Request
+    {
+        /** Message of the client, or ZERO if the slot is free */
+        const FileSystemMessage *message;
+
+        /** True if the device completed the request */
+        bool completed;
+
+        /** Identifier in the queue */
+        u16 token;
+
+        /** Bytes to skip in the first sector */
+        Size skip;
+
+        /** Bytes to return to the client */
+        Size size;
+
+        /** True while reading the sectors of an unaligned write */
+        bool merge;
+
+        /** Header read by the device */
+        volatile RequestHeader *header;
+
+        /** Status written by the device */
+        volatile u8 *status;
+
+        /** Physically contiguous data buffer */
+        Memory::Range data;
+    }
+    Request;
+
+  public:
+
+    /**
+     * Constructor
+     */
+    VirtioBlock();
+
+    /**
+     * Find the virtio block device.
+     *
+     * @return Error result code. ENODEV if no device is present.
+     */
+    Error probe();
+
+    /**
+     * Configure the virtio block device.
+     *
+     * @return Error result code.
+     */
+    virtual Error initialize();
+
+    /**
+     * Get interrupt number.
+     *
+     * @return Interrupt number of the device
+     */
+    uint getInterrupt() const;
+
+    /**
+     * Read bytes from the device.
+     *
+     * @param buffer Buffer to store bytes to read.
+     * @param size Number of bytes to read.
+     * @param offset Offset in the device.
+     *
+     * @return Number of bytes on success and an error code on failure.
+     */
+    virtual Error read(IOBuffer & buffer, Size size, Size offset);
+
+    /**
+     * Write bytes to the device.
+     *
+     * @param buffer Buffer with bytes to write.
+     * @param size Number of bytes to write.
+     * @param offset Offset in the device.
+     *
+     * @return Number of bytes on success and an error code on failure.
+     */
+    virtual Error write(IOBuffer & buffer, Size size, Size offset);
+
+    /**
+     * Take completed requests from the queue.
+     *
+     * @param vector Interrupt number.
+     *
+     * @return Error result code.
+     */
+    virtual Error interrupt(Size vector);
+
+  private:
+
+    /**
+     * Submit a new request or collect the result of a completed one.
+     *
+     * @param buffer Buffer of the client
+     * @param size Number of bytes
+     * @param offset Offset in the device
+     * @param write True to write, false to read.
+     *
+     * @return Number of bytes on success, EAGAIN while in flight, or an error code on failure.
+     */
+    Error transfer(IOBuffer & buffer, Size size, Size offset, bool write);
+
+    /**
+     * Submit a new request.
+     *
+     * @param buffer Buffer of the client
+     * @param size Number of bytes
+     * @param offset Offset in the device
+     * @param write True to write, false to read.
+     *
+     * @return EAGAIN, also when no slot is free and the request must be retried.
+     */
+    Error submit(IOBuffer & buffer, Size size, Size offset, bool write);
+
+    /**
+     * Put a request on the queue.
+     *
+     * @param req Request slot
+     * @param message Message of the client
+     * @param write True to write the data buffer, false to read into it.
+     *
+     * @return Result code of the queue. The slot stays unchanged on failure.
+     */
+    VirtQueue::Result enqueue(Request *req, const FileSystemMessage *message, bool write);
+
+    /**
+     * Find the request slot of a client message.
+     *
+     * @param message Message of the client
+     *
+     * @return Request slot or ZERO if not submitted yet.
+     */
+    Request * findRequest(const FileSystemMessage *message);
+
+  private:
+
+    /** PCI transport */
+    VirtioPCI m_virtio;
+
+    /** Request queue */
+    VirtQueue m_queue;
+
+    /** Request slots */
+    Request m_requests[RequestSlots];
+
+    /** Physically contiguous memory for headers and status bytes */
+    Memory::Range m_headers;
+
+    /** Number of sectors */
+    u64 m_capacity;
+
+    /** True if the device rejects writes */
+    bool m_readOnly;
+
+    /** Interrupt number */
+    uint m_irq;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __SERVER_VIRTIO_BLOCK_VIRTIOBLOCK_H */
@@ -132,6 +132,12 @@
  * The networking library implements standard networking protocols and networking support code.
  */
 
+/**
+ * @defgroup libpci libpci
+ *
+ * Provides drivers access to the PCI configuration space, through the PCI server.
+ */
+
 /**
  * @defgroup libposix libposix
  *
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestMain.h>
+#include <unistd.h>
+
+/** Program started as the peer of the shares */
+#define VMSHARE_PEER_PATH "/bin/sleep"
+
+/**
+ * Start a peer process which lives long enough for the test.
+ *
+ * @return ProcessID of the peer or -1 on failure
+ */
+static pid_t startPeer()
+{
+    const char *argv[] = { VMSHARE_PEER_PATH, "10", ZERO };
+
+    return forkexec(VMSHARE_PEER_PATH, argv);
+}
+
+/**
+ * Fill a share request for the given peer and tag.
+ */
+static void fillShare(ProcessShares::MemoryShare *share, ProcessID pid, Size tagId)
+{
+    SystemInformation info;
+
+    share->pid         = pid;
+    share->coreId      = info.coreId;
+    share->tagId       = tagId;
+    share->range.virt  = 0;
+    share->range.phys  = 0;
+    share->range.size  = PAGESIZE;
+    share->range.access = Memory::User | Memory::Readable | Memory::Writable;
+}
+
+TestCase(VMShareCreate)
+{
+    ProcessShares::MemoryShare share;
+    const pid_t pid = startPeer();
+    testAssert(pid != (pid_t) -1);
+
+    fillShare(&share, pid, 1);
+    testAssert(VMShare(pid, API::Create, &share) == API::Success);
+    testAssert(share.range.virt != 0);
+
+    // The share can be found by its key
+    fillShare(&share, pid, 1);
+    testAssert(VMShare(SELF, API::Read, &share) == API::Success);
+    testAssert(share.range.size == PAGESIZE);
+
+    testAssert(VMShare(pid, API::Delete, ZERO) == API::Success);
+    testAssert(VMShare(SELF, API::Read, &share) == API::IOError);
+    ProcessCtl(pid, KillPID);
+    return OK;
+}
+
+TestCase(VMShareAlreadyExists)
+{
+    ProcessShares::MemoryShare share;
+    Address virt;
+    const pid_t pid = startPeer();
+    testAssert(pid != (pid_t) -1);
+
+    fillShare(&share, pid, 1);
+    testAssert(VMShare(pid, API::Create, &share) == API::Success);
+    virt = share.range.virt;
+
+    // Creating a share with the same key returns the existing share
+    fillShare(&share, pid, 1);
+    testAssert(VMShare(pid, API::Create, &share) == API::AlreadyExists);
+    testAssert(share.range.virt == virt);
+
+    // Another tag is a different share
+    fillShare(&share, pid, 2);
+    testAssert(VMShare(pid, API::Create, &share) == API::Success);
+    testAssert(share.range.virt != virt);
+
+    testAssert(VMShare(pid, API::Delete, ZERO) == API::Success);
+    ProcessCtl(pid, KillPID);
+    return OK;
+}
+
+TestCase(VMShareKernelChannel)
+{
+    ProcessShares::MemoryShare share;
+
+    // The kernel creates exactly one share with tag zero for each process
+    fillShare(&share, KERNEL_PID, 0);
+    testAssert(VMShare(SELF, API::Read, &share) == API::Success);
+    testAssert(share.range.size == PAGESIZE * 2);
+    return OK;
+}
@@ -313,3 +313,32 @@ TestCase(BitRelease)
 
     return OK;
 }
+
+TestCase(BitReleaseRange)
+{
+    const Size chunkSize = PAGESIZE;
+    const Size rangeSize = chunkSize * 32;
+    const Allocator::Range range = { 0xabcd0000, rangeSize, sizeof(u32) };
+
+    BitAllocator ba(range, chunkSize);
+    Allocator::Range args = { 0, rangeSize, 0 };
+
+    // Allocate everything
+    testAssert(ba.allocate(args, 0) == Allocator::Success);
+    testAssert(ba.available() == 0);
+
+    // Release a range of pages in a single call
+    testAssert(ba.release(range.address + (chunkSize * 3), chunkSize * 20) == Allocator::Success);
+    testAssert(ba.available() == chunkSize * 20);
+
+    // Only the released range is free
+    for (Size i = 0; i < 32; i++)
+    {
+        testAssert(ba.isAllocated(range.address + (i * chunkSize)) == (i < 3 || i >= 23));
+    }
+
+    // Invalid arguments
+    testAssert(ba.release(range.address - chunkSize, chunkSize) == Allocator::InvalidAddress);
+    testAssert(ba.release(range.address, 0) == Allocator::InvalidAddress);
+    return OK;
+}
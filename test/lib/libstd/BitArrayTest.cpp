@@ -166,6 +166,37 @@ TestCase(BitArraySetRange)
     return OK;
 }
 
+TestCase(BitArrayUnsetRange)
+{
+    TestInt<Size> sizes(32, 64);
+    Size size = sizes.random();
+    TestInt<Size> indexes(1, 127-size);
+    BitArray ba(128);
+    Size idx = indexes.random();
+
+    // Set all bits, then clear a random range at random offset.
+    ba.setRange(0, 127);
+    ba.unsetRange(idx, idx + sizes[0]);
+
+    // Check that only the bits inside the range are 0.
+    for (Size i = 0; i < 128; i++)
+    {
+        if (i >= indexes[0] && i <= indexes[0] + sizes[0])
+        {
+            testAssert(!ba.isSet(i));
+        }
+        else
+        {
+            testAssert(ba.isSet(i));
+        }
+    }
+    // Check administration counters
+    testAssert(ba.count(false) == sizes[0] + 1);
+    testAssert(ba.count(true)  == 128 - sizes[0] - 1);
+    testAssert(ba.size() == 128);
+    return OK;
+}
+
 TestCase(BitArraySetNextRandom)
 {
     TestInt<Size> sizes(32, 64);
@@ -246,6 +246,71 @@ TestCase(HashTableRemoveMultiple)
     return OK;
 }
 
+TestCase(HashTableRemoveValue)
+{
+    HashTable<int, int> h;
+
+    // Append multiple values for the same key
+    for (int i = 0; i < 10; i++)
+        testAssert(h.append(7, i));
+    testAssert(h.insert(8, 3));
+
+    // Remove a single key/value pair
+    testAssert(h.remove(7, 3));
+    testAssert(!h.remove(7, 3));
+    testAssert(!h.remove(9, 0));
+
+    // Check administration
+    testAssert(h.count() == 10);
+    testAssert(h.values(7).count() == 9);
+    testAssert(!h.values(7).contains(3));
+    testAssert(h.value(8) == 3);
+    return OK;
+}
+
+TestCase(HashTableGrow)
+{
+    HashTable<int, int> h(4);
+
+    for (int i = 0; i < 1000; i++)
+        testAssert(h.insert(i, i * 2));
+
+    // The table grows with the number of items
+    testAssert(h.count() == 1000);
+    testAssert(h.size() >= 1000 / HASHTABLE_LOAD_FACTOR);
+
+    // All items are found after growing
+    for (int i = 0; i < 1000; i++)
+    {
+        testAssert(h.get(i) != ZERO);
+        testAssert(*h.get(i) == i * 2);
+    }
+    testAssert(h.keys().count() == 1000);
+    return OK;
+}
+
+TestCase(HashTableGrowAppend)
+{
+    HashTable<int, int> h(4);
+
+    for (int i = 0; i < 100; i++)
+    {
+        testAssert(h.append(i % 10, i));
+        testAssert(h.append(i % 10, i));
+    }
+
+    // Multiple values per key survive growing
+    testAssert(h.count() == 200);
+    testAssert(h.size() > 4);
+    testAssert(h.values(3).count() == 20);
+
+    // Each key is listed once
+    testAssert(h.keys().count() == 10);
+    testAssert(h.keys(42).count() == 1);
+    testAssert(h.keys(42).contains(2));
+    return OK;
+}
+
 TestCase(HashTableGet)
 {
     HashTable<String, int> h;
@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestInt.h>
+#include <TestMain.h>
+#include <IntervalSet.h>
+
+/** Page size used by the simulated memory context */
+#define TEST_PAGE 4096
+
+/** Number of pages in the simulated region */
+#define TEST_PAGES 512
+
+/** Base address of the simulated region */
+#define TEST_BASE 0x80000000
+
+/**
+ * Brute force search for a free range, similar to the linear page walk.
+ */
+static bool findLinear(const bool *mapped, Size pages, Address *result)
+{
+    Size found = 0;
+
+    for (Size i = 0; i < TEST_PAGES; i++)
+    {
+        if (mapped[i])
+            found = 0;
+        else if (++found == pages)
+        {
+            *result = TEST_BASE + ((i + 1 - pages) * TEST_PAGE);
+            return true;
+        }
+    }
+    return false;
+}
+
+TestCase(IntervalSetConstruct)
+{
+    IntervalSet set;
+    Address addr;
+
+    testAssert(set.count() == 0);
+    testAssert(!set.overlaps(TEST_BASE, TEST_PAGE));
+    testAssert(set.findGap(TEST_BASE, TEST_PAGE, TEST_PAGE, &addr) == IntervalSet::Success);
+    testAssert(addr == TEST_BASE);
+
+    // Nothing is allocated before the first insert
+    testAssert(set.remove(TEST_BASE, TEST_PAGE) == IntervalSet::Success);
+    testAssert(set.insert(TEST_BASE, TEST_PAGE) == IntervalSet::Success);
+    testAssert(set.count() == 1);
+    return OK;
+}
+
+TestCase(IntervalSetInsertMerge)
+{
+    IntervalSet set(1);
+
+    // Separate intervals
+    testAssert(set.insert(0x1000, 0x1000) == IntervalSet::Success);
+    testAssert(set.insert(0x4000, 0x1000) == IntervalSet::Success);
+    testAssert(set.count() == 2);
+
+    // Adjacent interval is merged with its left neighbour
+    testAssert(set.insert(0x2000, 0x1000) == IntervalSet::Success);
+    testAssert(set.count() == 2);
+    testAssert(set.at(0).base == 0x1000);
+    testAssert(set.at(0).size == 0x2000);
+
+    // Filling the hole merges everything
+    testAssert(set.insert(0x3000, 0x1000) == IntervalSet::Success);
+    testAssert(set.count() == 1);
+    testAssert(set.at(0).base == 0x1000);
+    testAssert(set.at(0).size == 0x4000);
+
+    // Overlapping insert does not change anything
+    testAssert(set.insert(0x2000, 0x2000) == IntervalSet::Success);
+    testAssert(set.count() == 1);
+    testAssert(set.at(0).size == 0x4000);
+
+    // Zero size is invalid
+    testAssert(set.insert(0x8000, 0) == IntervalSet::InvalidArgument);
+    return OK;
+}
+
+TestCase(IntervalSetRemoveSplit)
+{
+    IntervalSet set;
+
+    testAssert(set.insert(0x1000, 0x8000) == IntervalSet::Success);
+
+    // Removing from the middle splits the interval
+    testAssert(set.remove(0x3000, 0x2000) == IntervalSet::Success);
+    testAssert(set.count() == 2);
+    testAssert(set.at(0).base == 0x1000);
+    testAssert(set.at(0).size == 0x2000);
+    testAssert(set.at(1).base == 0x5000);
+    testAssert(set.at(1).size == 0x4000);
+    testAssert(!set.overlaps(0x3000, 0x2000));
+    testAssert(set.overlaps(0x2000, 0x2000));
+
+    // Removing across both intervals trims them
+    testAssert(set.remove(0x2000, 0x4000) == IntervalSet::Success);
+    testAssert(set.count() == 2);
+    testAssert(set.at(0).size == 0x1000);
+    testAssert(set.at(1).base == 0x6000);
+
+    // Removing unmapped space is ignored
+    testAssert(set.remove(0x20000, 0x1000) == IntervalSet::Success);
+    testAssert(set.count() == 2);
+
+    // Remove everything
+    testAssert(set.remove(0, 0x10000) == IntervalSet::Success);
+    testAssert(set.count() == 0);
+    return OK;
+}
+
+TestCase(IntervalSetFindGap)
+{
+    IntervalSet set;
+    Address addr;
+
+    testAssert(set.insert(TEST_BASE, TEST_PAGE * 2) == IntervalSet::Success);
+    testAssert(set.insert(TEST_BASE + (TEST_PAGE * 3), TEST_PAGE) == IntervalSet::Success);
+
+    // Single page fits in the hole
+    testAssert(set.findGap(TEST_BASE, TEST_PAGE * 8, TEST_PAGE, &addr) == IntervalSet::Success);
+    testAssert(addr == TEST_BASE + (TEST_PAGE * 2));
+
+    // Two pages must go after the second interval
+    testAssert(set.findGap(TEST_BASE, TEST_PAGE * 8, TEST_PAGE * 2, &addr) == IntervalSet::Success);
+    testAssert(addr == TEST_BASE + (TEST_PAGE * 4));
+
+    // Search starting inside an interval
+    testAssert(set.findGap(TEST_BASE + TEST_PAGE, TEST_PAGE * 4, TEST_PAGE, &addr) == IntervalSet::Success);
+    testAssert(addr == TEST_BASE + (TEST_PAGE * 2));
+
+    // Too large for the range
+    testAssert(set.findGap(TEST_BASE, TEST_PAGE * 8, TEST_PAGE * 5, &addr) == IntervalSet::NotFound);
+    return OK;
+}
+
+TestCase(IntervalSetMapUnmapCycles)
+{
+    IntervalSet set;
+    TestInt<uint> pages(1, 16);
+    TestInt<uint> choice(0, TEST_PAGES);
+    bool mapped[TEST_PAGES];
+
+    for (Size i = 0; i < TEST_PAGES; i++)
+        mapped[i] = false;
+
+    // Simulate a memory context which maps free ranges and unmaps random pages
+    for (Size cycle = 0; cycle < 5000; cycle++)
+    {
+        const Size num = pages.random();
+        Address expect, addr;
+        const bool found = findLinear(mapped, num, &expect);
+        const IntervalSet::Result r = set.findGap(TEST_BASE, TEST_PAGES * TEST_PAGE,
+                                                  num * TEST_PAGE, &addr);
+
+        // Search must give the same result as the linear page walk
+        testAssert(found == (r == IntervalSet::Success));
+
+        if (found)
+        {
+            testAssert(addr == expect);
+            testAssert(!set.overlaps(addr, num * TEST_PAGE));
+            testAssert(set.insert(addr, num * TEST_PAGE) == IntervalSet::Success);
+
+            for (Size i = 0; i < num; i++)
+                mapped[((addr - TEST_BASE) / TEST_PAGE) + i] = true;
+        }
+
+        // Unmap a random range of pages
+        const Size first = choice.random();
+        Size count = pages.random();
+        if (first + count > TEST_PAGES)
+            count = TEST_PAGES - first;
+
+        if (count && (cycle % 3) != 0)
+        {
+            testAssert(set.remove(TEST_BASE + (first * TEST_PAGE), count * TEST_PAGE) == IntervalSet::Success);
+
+            for (Size i = 0; i < count; i++)
+                mapped[first + i] = false;
+        }
+
+        // Each page must be in the set exactly when mapped
+        for (Size i = 0; i < TEST_PAGES; i++)
+            testAssert(set.overlaps(TEST_BASE + (i * TEST_PAGE), TEST_PAGE) == mapped[i]);
+
+        // Intervals are sorted and never adjacent
+        for (Size i = 1; i < set.count(); i++)
+            testAssert(set.at(i - 1).base + set.at(i - 1).size < set.at(i).base);
+    }
+
+    return OK;
+}
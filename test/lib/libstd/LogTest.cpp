@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestMain.h>
+#include <MemoryBlock.h>
+#include <String.h>
+#include <Log.h>
+
+/**
+ * Log which captures all written output.
+ */
+class CaptureLog : public Log
+{
+  public:
+
+    CaptureLog()
+        : Log()
+        , m_previous(Log::instance)
+        , m_writes(0)
+    {
+        Log::instance = this;
+        setMinimumLogLevel(Log::Debug);
+    }
+
+    virtual ~CaptureLog()
+    {
+        Log::instance = m_previous;
+    }
+
+    virtual void write(const char *str)
+    {
+        m_output << str;
+        m_writes++;
+    }
+
+    Log *m_previous;
+    String m_output;
+    Size m_writes;
+};
+
+TestCase(LogFormatNumbers)
+{
+    CaptureLog log;
+
+    log << "a " << 5 << " " << -3 << " " << 7U << " " << (void *) 0x1f << "\r\n";
+    testString(*log.m_output, "a 5 -3 7 0x1f\r\n");
+    testAssert(log.m_writes == 1);
+    return OK;
+}
+
+TestCase(LogLineBuffered)
+{
+    CaptureLog log;
+
+    // Nothing is written until the line is complete
+    log << "first" << " part";
+    testAssert(log.m_writes == 0);
+
+    log << "\n";
+    testString(*log.m_output, "first part\n");
+    testAssert(log.m_writes == 1);
+    return OK;
+}
+
+TestCase(LogPrefix)
+{
+    CaptureLog log;
+
+    NOTICE("value " << 42);
+    testAssert(log.m_output.startsWith("[Notice] "));
+    testAssert(log.m_output.endsWith(" -- value 42\r\n"));
+    return OK;
+}
+
+TestCase(LogLevelFilter)
+{
+    CaptureLog log;
+
+    log.setMinimumLogLevel(Log::Notice);
+    DEBUG("filtered");
+    INFO("filtered");
+    testAssert(log.m_writes == 0);
+
+    WARNING("passed");
+    testAssert(log.m_writes == 1);
+    return OK;
+}
+
+TestCase(LogDeferred)
+{
+    CaptureLog log;
+
+    log.setDeferred(true);
+    NOTICE("one");
+    NOTICE("two");
+    testAssert(log.m_writes == 0);
+
+    // Both lines are written in a single write
+    log.flush();
+    testAssert(log.m_writes == 1);
+    testAssert(log.m_output.startsWith("[Notice] "));
+    testAssert(log.m_output.endsWith(" -- two\r\n"));
+    return OK;
+}
+
+TestCase(LogDeferredError)
+{
+    CaptureLog log;
+
+    // Errors are written immediately, including pending lines before them
+    log.setDeferred(true);
+    NOTICE("pending");
+    ERROR("failure");
+    testAssert(log.m_writes == 1);
+    testAssert(log.m_output.startsWith("[Notice] "));
+    testAssert(log.m_output.endsWith(" -- failure\r\n"));
+    return OK;
+}
+
+TestCase(LogDeferredFull)
+{
+    CaptureLog log;
+    const Size lines = (Log::RingSize / 8) + 1;
+
+    // A full ring is written out instead of losing lines
+    log.setDeferred(true);
+
+    for (Size i = 0; i < lines; i++)
+        log << "line " << (uint) i << "\n";
+
+    log.flush();
+
+    Size newlines = 0;
+    for (const char *p = *log.m_output; *p; p++)
+        newlines += *p == '\n';
+
+    testAssert(newlines == lines);
+    testAssert(log.m_writes > 1);
+    testAssert(log.m_output.startsWith("line 0\n"));
+    testAssert(log.m_output.endsWith("\n"));
+    testAssert(log.getDropped() == 0);
+    return OK;
+}
+
+TestCase(LogLineTooLarge)
+{
+    CaptureLog log;
+    char large[Log::RingSize + 1];
+
+    MemoryBlock::set(large, 'x', sizeof(large) - 1);
+    large[sizeof(large) - 1] = 0;
+
+    // Lines which do not fit the ring are dropped
+    log << large << "\n";
+    testAssert(log.m_writes == 0);
+    testAssert(log.getDropped() == 1);
+
+    log << "next\n";
+    testString(*log.m_output, "next\n");
+    return OK;
+}
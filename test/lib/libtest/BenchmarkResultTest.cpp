@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestInt.h>
+#include <TestMain.h>
+#include <BenchmarkResult.h>
+
+TestCase(BenchmarkResultEmpty)
+{
+    BenchmarkResult result(16);
+
+    // Statistics of an empty result are zero
+    testAssert(result.count() == 0);
+    testAssert(!result.isSkipped());
+    testAssert(result.getMinimum() == 0);
+    testAssert(result.getMedian() == 0);
+    testAssert(result.getMaximum() == 0);
+    testAssert(result.getAverage() == 0);
+    return OK;
+}
+
+TestCase(BenchmarkResultOrdered)
+{
+    BenchmarkResult result(100);
+
+    // Add samples 1..100 in reverse order
+    for (uint i = 100; i > 0; i--)
+        result.addSample(i);
+
+    testAssert(result.count() == 100);
+    testAssert(result.getMinimum() == 1);
+    testAssert(result.getMaximum() == 100);
+    testAssert(result.getMedian() == 50);
+    testAssert(result.getPercentile(99) == 99);
+    testAssert(result.getPercentile(1) == 1);
+    testAssert(result.getAverage() == 50);
+    return OK;
+}
+
+TestCase(BenchmarkResultRandom)
+{
+    BenchmarkResult result(16);
+    TestInt<uint> ints(0, 1000000);
+    uint lowest = ~0U, highest = 0;
+
+    // Add random samples beyond the initial size
+    for (Size i = 0; i < 1000; i++)
+    {
+        uint value = ints.random();
+
+        if (value < lowest)
+            lowest = value;
+        if (value > highest)
+            highest = value;
+
+        result.addSample(value);
+    }
+
+    // Percentiles must be increasing
+    testAssert(result.count() == 1000);
+    testAssert(result.getMinimum() == lowest);
+    testAssert(result.getMaximum() == highest);
+    testAssert(result.getMinimum() <= result.getMedian());
+    testAssert(result.getMedian() <= result.getPercentile(99));
+    testAssert(result.getPercentile(99) <= result.getMaximum());
+
+    // Adding a sample after sorting must keep results consistent
+    result.addSample(0);
+    testAssert(result.getMinimum() == 0);
+    testAssert(result.count() == 1001);
+    return OK;
+}
+
+TestCase(BenchmarkResultSkipped)
+{
+    BenchmarkResult result(1);
+
+    result.setSkipped();
+    testAssert(result.isSkipped());
+    testAssert(result.count() == 0);
+    return OK;
+}